@@ -26,6 +26,10 @@
 #include "gfx_utils/diagram/depiction/depict_curve.h"
 
 namespace OHOS {
+namespace {
+const uint32_t BOX_CORNERS = 4;
+} // namespace
+
 /**
  * Reset the status attribute of a path segment
  * @path_id is a path ID, calculated from 0
@@ -35,6 +39,7 @@ namespace OHOS {
 void DepictCurve::Rewind(uint32_t pathId)
 {
     source_->Rewind(pathId);
+    sourceIndex_ = pathId;
     lastX_ = 0.0f;
     lastY_ = 0.0f;
     quadraticBezier_.Reset();
@@ -65,10 +70,21 @@ uint32_t DepictCurve::GenerateVertex(float* x, float* y)
     float endX = 0;
     float endY = 0;
 
-    uint32_t cmd = source_->GenerateVertex(x, y);
+    uint32_t cmd = NextSourceVertex(x, y);
+    while (cullEnabled_ && IsMoveTo(cmd) && SkipSubpath()) {
+        cmd = NextSourceVertex(x, y);
+    }
     switch (cmd) {
         case PATH_CMD_CURVE3:
-            source_->GenerateVertex(&endX, &endY);
+            NextSourceVertex(&endX, &endY);
+            if (cullEnabled_ && IsCulled(MATH_MIN(lastX_, MATH_MIN(*x, endX)), MATH_MIN(lastY_, MATH_MIN(*y, endY)),
+                                         MATH_MAX(lastX_, MATH_MAX(*x, endX)), MATH_MAX(lastY_, MATH_MAX(*y, endY)))) {
+                culledCurves_++;
+                *x = endX;
+                *y = endY;
+                cmd = PATH_CMD_LINE_TO;
+                break;
+            }
 
             quadraticBezier_.Init(lastX_, lastY_, *x, *y, endX, endY);
 
@@ -78,8 +94,19 @@ uint32_t DepictCurve::GenerateVertex(float* x, float* y)
             break;
 
         case PATH_CMD_CURVE4:
-            source_->GenerateVertex(&control2X, &control2Y);
-            source_->GenerateVertex(&endX, &endY);
+            NextSourceVertex(&control2X, &control2Y);
+            NextSourceVertex(&endX, &endY);
+            if (cullEnabled_ &&
+                IsCulled(MATH_MIN(MATH_MIN(lastX_, *x), MATH_MIN(control2X, endX)),
+                         MATH_MIN(MATH_MIN(lastY_, *y), MATH_MIN(control2Y, endY)),
+                         MATH_MAX(MATH_MAX(lastX_, *x), MATH_MAX(control2X, endX)),
+                         MATH_MAX(MATH_MAX(lastY_, *y), MATH_MAX(control2Y, endY)))) {
+                culledCurves_++;
+                *x = endX;
+                *y = endY;
+                cmd = PATH_CMD_LINE_TO;
+                break;
+            }
 
             cubicBezier_.Init(lastX_, lastY_, *x, *y, control2X, control2Y, endX, endY);
 
@@ -92,4 +119,81 @@ uint32_t DepictCurve::GenerateVertex(float* x, float* y)
     lastY_ = *y;
     return cmd;
 }
+
+void DepictCurve::SetCullBox(float x1, float y1, float x2, float y2)
+{
+    cullX1_ = MATH_MIN(x1, x2);
+    cullY1_ = MATH_MIN(y1, y2);
+    cullX2_ = MATH_MAX(x1, x2);
+    cullY2_ = MATH_MAX(y1, y2);
+    cullEnabled_ = true;
+}
+
+void DepictCurve::SetCullBox(float x1, float y1, float x2, float y2, const TransAffine& transform)
+{
+    const float* data = transform.GetData();
+    if (data[0] * data[4] - data[1] * data[3] == 0.0f) { // 0, 1, 3, 4: the linear part of the matrix
+        cullEnabled_ = false;
+        return;
+    }
+    float x[BOX_CORNERS] = {x1, x2, x2, x1};
+    float y[BOX_CORNERS] = {y1, y1, y2, y2};
+    transform.InverseTransformBatch(x, y, BOX_CORNERS);
+    float minX = x[0];
+    float minY = y[0];
+    float maxX = x[0];
+    float maxY = y[0];
+    for (uint32_t i = 1; i < BOX_CORNERS; i++) {
+        minX = MATH_MIN(minX, x[i]);
+        minY = MATH_MIN(minY, y[i]);
+        maxX = MATH_MAX(maxX, x[i]);
+        maxY = MATH_MAX(maxY, y[i]);
+    }
+    SetCullBox(minX, minY, maxX, maxY);
+}
+
+/**
+ * The subpath starts at the move to just read. Its vertices are scanned ahead until the bounds reach
+ * the cull box, a subpath which stays outside is skipped up to the next move to.
+ */
+bool DepictCurve::SkipSubpath()
+{
+    uint32_t total = source_->GetTotalVertices();
+    uint32_t idx = sourceIndex_ - 1;
+    float minX;
+    float minY;
+    source_->GenerateVertex(idx, &minX, &minY);
+    float maxX = minX;
+    float maxY = minY;
+    float x;
+    float y;
+    for (idx++; idx < total; idx++) {
+        uint32_t cmd = source_->GenerateVertex(idx, &x, &y);
+        if (IsMoveTo(cmd)) {
+            break;
+        }
+        if (!IsVertex(cmd)) {
+            continue;
+        }
+        minX = MATH_MIN(minX, x);
+        minY = MATH_MIN(minY, y);
+        maxX = MATH_MAX(maxX, x);
+        maxY = MATH_MAX(maxY, y);
+        if (!IsCulled(minX, minY, maxX, maxY)) {
+            return false;
+        }
+    }
+    if (!IsCulled(minX, minY, maxX, maxY)) {
+        return false;
+    }
+    culledSubpaths_++;
+    source_->Rewind(idx);
+    sourceIndex_ = idx;
+    return true;
+}
+
+uint32_t DepictCurve::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
 } // namespace OHOS
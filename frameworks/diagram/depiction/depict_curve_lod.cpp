@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/depiction/depict_curve_lod.h"
+
+#include <cmath>
+
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/mem_api.h"
+
+namespace OHOS {
+namespace {
+const uint32_t MIN_LEVEL_CAPACITY = 64;
+} // namespace
+
+DepictCurveLod::DepictCurveLod(UICanvasVertices& source)
+    : source_(&source), current_(0), iterator_(0), useCount_(0), hitCount_(0), missCount_(0)
+{
+    for (uint32_t i = 0; i < CURVE_LOD_LEVELS; i++) {
+        levels_[i].vertices = nullptr;
+        levels_[i].num = 0;
+        levels_[i].capacity = 0;
+        levels_[i].lastUse = 0;
+        levels_[i].level = 0;
+        levels_[i].valid = false;
+    }
+}
+
+DepictCurveLod::~DepictCurveLod()
+{
+    for (uint32_t i = 0; i < CURVE_LOD_LEVELS; i++) {
+        UIFree(levels_[i].vertices);
+    }
+}
+
+void DepictCurveLod::Attach(UICanvasVertices& source)
+{
+    source_ = &source;
+    Invalidate();
+}
+
+void DepictCurveLod::Invalidate()
+{
+    for (uint32_t i = 0; i < CURVE_LOD_LEVELS; i++) {
+        levels_[i].num = 0;
+        levels_[i].valid = false;
+    }
+    iterator_ = 0;
+}
+
+int32_t DepictCurveLod::GetLevel(float scale)
+{
+    scale = MATH_MIN(MATH_MAX(scale, MIN_APPROXIMATION_SCALE), MAX_APPROXIMATION_SCALE);
+    return static_cast<int32_t>(std::floor(std::log2(scale) * CURVE_LOD_LEVELS_PER_OCTAVE + 0.5f)); // 0.5f: round
+}
+
+float DepictCurveLod::GetLevelScale(int32_t level)
+{
+    return std::exp2(static_cast<float>(level) / CURVE_LOD_LEVELS_PER_OCTAVE);
+}
+
+void DepictCurveLod::ApproximationScale(float scale)
+{
+    int32_t level = GetLevel(scale);
+    useCount_++;
+    uint32_t slot = CURVE_LOD_LEVELS;
+    for (uint32_t i = 0; i < CURVE_LOD_LEVELS; i++) {
+        if (levels_[i].valid && levels_[i].level == level) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < CURVE_LOD_LEVELS) {
+        hitCount_++;
+    } else {
+        /* An empty slot first, the least recently used level otherwise. */
+        slot = 0;
+        for (uint32_t i = 0; i < CURVE_LOD_LEVELS; i++) {
+            if (!levels_[i].valid) {
+                slot = i;
+                break;
+            }
+            if (levels_[i].lastUse < levels_[slot].lastUse) {
+                slot = i;
+            }
+        }
+        missCount_++;
+        levels_[slot].level = level;
+        Flatten(levels_[slot]);
+    }
+    levels_[slot].lastUse = useCount_;
+    current_ = slot;
+    iterator_ = 0;
+}
+
+float DepictCurveLod::ApproximationScale() const
+{
+    return GetLevelScale(levels_[current_].level);
+}
+
+void DepictCurveLod::Rewind(uint32_t pathId)
+{
+    if (!levels_[current_].valid) {
+        missCount_++;
+        Flatten(levels_[current_]);
+    }
+    iterator_ = pathId;
+}
+
+uint32_t DepictCurveLod::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    const LodLevel& level = levels_[current_];
+    uint32_t num = (iterator_ < level.num) ? MATH_MIN(maxNum, level.num - iterator_) : 0;
+    for (uint32_t i = 0; i < num; i++) {
+        vertices[i] = level.vertices[iterator_ + i];
+    }
+    iterator_ += num;
+    return num;
+}
+
+bool DepictCurveLod::Flatten(LodLevel& level)
+{
+    DepictCurve curve(*source_);
+    curve.ApproximationScale(GetLevelScale(level.level));
+    curve.Rewind(0);
+    level.num = 0;
+    level.valid = false;
+    uint32_t got;
+    do {
+        if (level.capacity - level.num < VERTEX_BATCH_SIZE) {
+            uint32_t capacity = MATH_MAX(level.capacity * 2, MIN_LEVEL_CAPACITY); // 2: double
+            PathVertex* vertices =
+                static_cast<PathVertex*>(UIRealloc(level.vertices, capacity * sizeof(PathVertex)));
+            if (vertices == nullptr) {
+                GRAPHIC_LOGE("DepictCurveLod::Flatten alloc fail");
+                level.num = 0;
+                return false;
+            }
+            level.vertices = vertices;
+            level.capacity = capacity;
+        }
+        got = curve.GenerateVertices(level.vertices + level.num, VERTEX_BATCH_SIZE);
+        level.num += got;
+    } while (got == VERTEX_BATCH_SIZE);
+    level.valid = true;
+    return true;
+}
+} // namespace OHOS
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_cell_arena.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/mem_api.h"
+
+namespace OHOS {
+namespace {
+/* The chunk header is padded so that the blocks behind it stay 16 bytes aligned. */
+const uint32_t CHUNK_HEADER_BYTES = 16;
+} // namespace
+
+RasterizerCellArena::~RasterizerCellArena()
+{
+    if (blocksInUse_ != 0 || bufferBytesInUse_ != 0) {
+        GRAPHIC_LOGE("RasterizerCellArena destroyed while in use");
+    }
+    while (chunks_ != nullptr) {
+        Chunk* next = chunks_->next;
+        UIFree(chunks_);
+        chunks_ = next;
+    }
+    for (uint32_t i = 0; i < CELL_ARENA_BUFFER_SLOTS; i++) {
+        UIFree(buffers_[i].data);
+    }
+}
+
+bool RasterizerCellArena::Grow(uint32_t blockNum)
+{
+    Chunk* chunk = static_cast<Chunk*>(UIMalloc(CHUNK_HEADER_BYTES + blockNum * CELL_ARENA_BLOCK_BYTES));
+    if (chunk == nullptr) {
+        GRAPHIC_LOGE("RasterizerCellArena::Grow alloc fail");
+        return false;
+    }
+    chunk->next = chunks_;
+    chunk->blockNum = blockNum;
+    chunks_ = chunk;
+    uint8_t* block = reinterpret_cast<uint8_t*>(chunk) + CHUNK_HEADER_BYTES;
+    for (uint32_t i = 0; i < blockNum; i++, block += CELL_ARENA_BLOCK_BYTES) {
+        FreeBlockNode* node = reinterpret_cast<FreeBlockNode*>(block);
+        node->next = freeBlocks_;
+        freeBlocks_ = node;
+    }
+    blocksAllocated_ += blockNum;
+    return true;
+}
+
+void* RasterizerCellArena::AllocateBlock()
+{
+    if (freeBlocks_ == nullptr) {
+        /* Geometric growth: every new chunk holds twice the blocks of the previous one, up to a cap. */
+        if (!Grow(nextChunkBlocks_)) {
+            return nullptr;
+        }
+        nextChunkBlocks_ = MATH_MIN(nextChunkBlocks_ * 2, CELL_ARENA_MAX_CHUNK_BLOCKS); // 2: double
+    }
+    FreeBlockNode* node = freeBlocks_;
+    freeBlocks_ = node->next;
+    blocksInUse_++;
+    blocksHighWater_ = MATH_MAX(blocksHighWater_, blocksInUse_);
+    return node;
+}
+
+void RasterizerCellArena::FreeBlock(void* block)
+{
+    if (block == nullptr) {
+        return;
+    }
+    FreeBlockNode* node = static_cast<FreeBlockNode*>(block);
+    node->next = freeBlocks_;
+    freeBlocks_ = node;
+    blocksInUse_--;
+}
+
+void RasterizerCellArena::Reserve(uint32_t blockNum)
+{
+    if (blockNum > blocksAllocated_) {
+        Grow(blockNum - blocksAllocated_);
+    }
+}
+
+void* RasterizerCellArena::AllocateBuffer(uint32_t size, uint32_t& capacity)
+{
+    int32_t best = -1;
+    for (uint32_t i = 0; i < CELL_ARENA_BUFFER_SLOTS; i++) {
+        if (buffers_[i].data != nullptr && buffers_[i].capacity >= size &&
+            (best < 0 || buffers_[i].capacity < buffers_[best].capacity)) {
+            best = i;
+        }
+    }
+    void* buffer = nullptr;
+    if (best >= 0) {
+        buffer = buffers_[best].data;
+        capacity = buffers_[best].capacity;
+        buffers_[best].data = nullptr;
+        buffers_[best].capacity = 0;
+    } else {
+        capacity = size + size / 2; // 2: grow by one half
+        buffer = UIMalloc(capacity);
+        if (buffer == nullptr) {
+            GRAPHIC_LOGE("RasterizerCellArena::AllocateBuffer alloc fail");
+            capacity = 0;
+            return nullptr;
+        }
+    }
+    bufferBytesInUse_ += capacity;
+    bufferBytesHighWater_ = MATH_MAX(bufferBytesHighWater_, bufferBytesInUse_);
+    return buffer;
+}
+
+void RasterizerCellArena::FreeBuffer(void* buffer, uint32_t capacity)
+{
+    if (buffer == nullptr) {
+        return;
+    }
+    bufferBytesInUse_ -= capacity;
+    /* Keep the largest buffers, the smallest cached one makes room or the buffer goes back to the heap. */
+    uint32_t slot = 0;
+    for (uint32_t i = 1; i < CELL_ARENA_BUFFER_SLOTS; i++) {
+        if (buffers_[i].capacity < buffers_[slot].capacity) {
+            slot = i;
+        }
+    }
+    if (buffers_[slot].data != nullptr && buffers_[slot].capacity >= capacity) {
+        UIFree(buffer);
+        return;
+    }
+    UIFree(buffers_[slot].data);
+    buffers_[slot].data = buffer;
+    buffers_[slot].capacity = capacity;
+}
+} // namespace OHOS
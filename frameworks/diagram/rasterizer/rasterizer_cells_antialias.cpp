@@ -19,18 +19,60 @@
 namespace OHOS {
 RasterizerCellsAntiAlias::~RasterizerCellsAntiAlias()
 {
-    if (numBlocks_) {
-        CellBuildAntiAlias** ptr = cells_ + numBlocks_ - 1;
-        while (numBlocks_--) {
-            GeometryArrayAllocator<CellBuildAntiAlias>::Deallocate(*ptr, CELL_BLOCK_SIZE);
-            ptr--;
-        }
+    ReleaseMemory();
+    if (cells_ != nullptr) {
         GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(cells_, maxBlocks_);
-        GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(sortedCells_, numCells_ + CELLS_SIZE);
-        GeometryArrayAllocator<SortedYLevel>::Deallocate(sortedY_, maxY_ - minY_ + 1 + CELLS_SIZE);
     }
 }
 
+/**
+ * @brief Hands the cell blocks and the sorted index buffers back to the arena.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::ReleaseMemory()
+{
+    while (numBlocks_ > 0) {
+        arena_->FreeBlock(cells_[--numBlocks_]);
+    }
+    currBlock_ = 0;
+    arena_->FreeBuffer(sortedCells_, sortedCellsCapacity_);
+    arena_->FreeBuffer(sortedY_, sortedYCapacity_);
+    arena_->FreeBuffer(rowBuffer_, rowBufferCapacity_);
+    arena_->FreeBuffer(edges_, edgeCapacity_);
+    sortedCells_ = nullptr;
+    sortedY_ = nullptr;
+    rowBuffer_ = nullptr;
+    edges_ = nullptr;
+    sortedCellsCapacity_ = 0;
+    sortedYCapacity_ = 0;
+    rowBufferCapacity_ = 0;
+    edgeCapacity_ = 0;
+    edgeNum_ = 0;
+}
+
+void RasterizerCellsAntiAlias::SetArena(RasterizerCellArena* arena)
+{
+    ReleaseMemory();
+    arena_ = (arena != nullptr) ? arena : &localArena_;
+    Reset();
+}
+
+void RasterizerCellsAntiAlias::SetCellLayout(CellLayout layout)
+{
+    requestedLayout_ = layout;
+    if (layout == CELL_LAYOUT_STYLED) {
+        bandHeight_ = 0;
+    }
+    Reset();
+}
+
+void RasterizerCellsAntiAlias::SetBandHeight(int32_t bandHeight)
+{
+    bandHeight_ = (requestedLayout_ == CELL_LAYOUT_STYLED) ? 0 : MATH_MAX(bandHeight, 0);
+    Reset();
+}
+
 /**
  * @brief RasterizerCellsAntiAlias Class constructor
  * initialization numBlocks_,maxBlocks_,currBlock_ Other attributes
@@ -45,12 +87,36 @@ RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
       cellBlockLimit_(cellBlockLimit),
       cells_(0),
       currCellPtr_(0),
+      currCompactPtr_(nullptr),
+      currStyledPtr_(nullptr),
       sortedCells_(nullptr),
       sortedY_(nullptr),
+      sortedCellsCapacity_(0),
+      sortedYCapacity_(0),
+      rowBuffer_(nullptr),
+      rowBufferCapacity_(0),
+      rowRadixThreshold_(UINT32_MAX),
+      sortedMinY_(0),
+      sortedMaxY_(-1),
+      arena_(&localArena_),
       minX_(INT32_MAX),
       minY_(INT32_MAX),
       maxX_(INT32_MIN),
       maxY_(INT32_MIN),
+      styleLeft_(-1),
+      styleRight_(-1),
+      originX_(0),
+      originY_(0),
+      layout_(CELL_LAYOUT_WIDE),
+      requestedLayout_(CELL_LAYOUT_WIDE),
+      edges_(nullptr),
+      edgeNum_(0),
+      edgeCapacity_(0),
+      bandHeight_(0),
+      bandMinY_(INT32_MIN),
+      bandMaxY_(INT32_MAX),
+      bandCount_(0),
+      cellsOverflow_(false),
       sorted_(false)
 {
     styleCell_.Initial();
@@ -64,37 +130,196 @@ RasterizerCellsAntiAlias::RasterizerCellsAntiAlias(uint32_t cellBlockLimit)
  */
 void RasterizerCellsAntiAlias::Reset()
 {
-    numCells_ = 0;
-    currBlock_ = 0;
-    currCell_.Initial();
+    ResetCells();
     styleCell_.Initial();
-    sorted_ = false;
+    styleLeft_ = -1;
+    styleRight_ = -1;
+    edgeNum_ = 0;
+    bandMinY_ = INT32_MIN;
+    bandMaxY_ = INT32_MAX;
+    bandCount_ = 0;
     minX_ = INT32_MAX;
     minY_ = INT32_MAX;
     maxX_ = INT32_MIN;
     maxY_ = INT32_MIN;
+    originX_ = 0;
+    originY_ = 0;
+    layout_ = requestedLayout_;
 }
 
 /**
- * @brief Add the current cell during rasterization.
+ * @brief Drops the cells built so far, the recorded lines and the bounds are kept.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerCellsAntiAlias::ResetCells()
+{
+    numCells_ = 0;
+    currBlock_ = 0;
+    currCell_.Initial();
+    cellsOverflow_ = false;
+    sorted_ = false;
+}
+
+/**
+ * @brief Add the current cell during rasterization, cells outside of the current band are dropped.
  * @since 1.0
  * @version 1.0
  */
 void RasterizerCellsAntiAlias::AddCurrentCell()
 {
     bool areaCoverFlags = currCell_.area | currCell_.cover;
-    if (areaCoverFlags) {
-        // Reach CELL_BLOCK_MASK After the number of mask, re allocate memory
-        if ((numCells_ & CELL_BLOCK_MASK) == 0) {
-            // Exceeds the memory block size limit. The default is 1024 limit
-            if (numBlocks_ >= cellBlockLimit_) {
-                return;
-            }
-            AllocateBlock();
+    if (areaCoverFlags && currCell_.y >= bandMinY_ && currCell_.y <= bandMaxY_) {
+        if (layout_ == CELL_LAYOUT_COMPACT) {
+            AddCompactCell(currCell_);
+        } else if (layout_ == CELL_LAYOUT_STYLED) {
+            AddStyledCell(currCell_);
+        } else {
+            AddWideCell(currCell_);
+        }
+    }
+}
+
+/**
+ * @brief Makes room for the next cell, a new block is taken every blockMask + 1 cells.
+ * @since 1.0
+ * @version 1.0
+ */
+inline bool RasterizerCellsAntiAlias::PrepareCellSlot(uint32_t blockMask)
+{
+    // Reach the block mask After the number of mask, re allocate memory
+    if ((numCells_ & blockMask) == 0) {
+        // Exceeds the memory block size limit. The default is 1024 limit,
+        // blocks kept from previous frames do not count, only the ones filled since Reset
+        if (currBlock_ >= cellBlockLimit_ || !AllocateBlock()) {
+            cellsOverflow_ = true;
+            return false;
         }
-        *currCellPtr_++ = currCell_;
+    }
+    return true;
+}
+
+void RasterizerCellsAntiAlias::AddWideCell(const CellBuildAntiAlias& cell)
+{
+    if (!PrepareCellSlot(CELL_BLOCK_MASK)) {
+        return;
+    }
+    *currCellPtr_++ = cell;
+    ++numCells_;
+}
+
+void RasterizerCellsAntiAlias::AddStyledCell(const CellBuildAntiAlias& cell)
+{
+    // The same style on both sides cancels out, the style on the right sees the edge reversed
+    if (styleLeft_ == styleRight_) {
+        return;
+    }
+    if (styleLeft_ >= 0) {
+        AddStyledCell(cell, styleLeft_, cell.cover, cell.area);
+    }
+    if (styleRight_ >= 0) {
+        AddStyledCell(cell, styleRight_, -cell.cover, -cell.area);
+    }
+}
+
+inline void RasterizerCellsAntiAlias::AddStyledCell(const CellBuildAntiAlias& cell, int32_t style, int32_t cover,
+                                                    int32_t area)
+{
+    do {
+        if (!PrepareCellSlot(STYLED_CELL_BLOCK_MASK)) {
+            return;
+        }
+        int32_t part = MATH_MIN(MATH_MAX(cover, -INT16_MAX), INT16_MAX);
+        currStyledPtr_->x = cell.x;
+        currStyledPtr_->y = cell.y;
+        currStyledPtr_->area = area;
+        currStyledPtr_->cover = static_cast<int16_t>(part);
+        currStyledPtr_->style = static_cast<int16_t>(style);
+        ++currStyledPtr_;
         ++numCells_;
+        cover -= part;
+        area = 0;
+    } while (cover != 0);
+}
+
+void RasterizerCellsAntiAlias::AddCompactCell(const CellBuildAntiAlias& cell)
+{
+    if (numCells_ == 0) {
+        originX_ = cell.x;
+        originY_ = cell.y;
     }
+    int32_t x = cell.x - originX_;
+    int32_t y = cell.y - originY_;
+    if (x < INT16_MIN || x > INT16_MAX || y < INT16_MIN || y > INT16_MAX) {
+        if (!ExpandCompactCells()) {
+            GRAPHIC_LOGE("RasterizerCellsAntiAlias::AddCompactCell cell out of the compact range dropped");
+            return;
+        }
+        AddWideCell(cell);
+        return;
+    }
+    int32_t cover = cell.cover;
+    int32_t area = cell.area;
+    if (cover >= COMPACT_COVER_MIN && cover <= COMPACT_COVER_MAX && area >= COMPACT_AREA_MIN &&
+        area <= COMPACT_AREA_MAX) {
+        if (PrepareCellSlot(COMPACT_CELL_BLOCK_MASK)) {
+            currCompactPtr_->Set(x, y, cover, area);
+            ++currCompactPtr_;
+            ++numCells_;
+        }
+        return;
+    }
+    // Windings inside one pixel can exceed the packed range, the cell is split into parts that fit
+    do {
+        if (!PrepareCellSlot(COMPACT_CELL_BLOCK_MASK)) {
+            return;
+        }
+        int32_t partCover = MATH_MIN(MATH_MAX(cover, COMPACT_COVER_MIN), COMPACT_COVER_MAX);
+        int32_t partArea = MATH_MIN(MATH_MAX(area, COMPACT_AREA_MIN), COMPACT_AREA_MAX);
+        currCompactPtr_->Set(x, y, partCover, partArea);
+        ++currCompactPtr_;
+        ++numCells_;
+        cover -= partCover;
+        area -= partArea;
+    } while (cover != 0 || area != 0);
+}
+
+bool RasterizerCellsAntiAlias::ExpandCompactCells()
+{
+    uint32_t num = numCells_;
+    uint32_t capacity = 0;
+    CellCompactAntiAlias* saved = nullptr;
+    if (num > 0) {
+        saved = static_cast<CellCompactAntiAlias*>(arena_->AllocateBuffer(num * sizeof(CellCompactAntiAlias),
+                                                                          capacity));
+        if (saved == nullptr) {
+            return false;
+        }
+    }
+    for (uint32_t copied = 0, block = 0; copied < num; block++) {
+        uint32_t n = MATH_MIN(num - copied, static_cast<uint32_t>(COMPACT_CELL_BLOCK_SIZE));
+        if (memcpy_s(saved + copied, n * sizeof(CellCompactAntiAlias), cells_[block],
+                     n * sizeof(CellCompactAntiAlias)) != EOK) {
+            GRAPHIC_LOGE("RasterizerCellsAntiAlias::ExpandCompactCells memcpy_s fail");
+            arena_->FreeBuffer(saved, capacity);
+            return false;
+        }
+        copied += n;
+    }
+
+    layout_ = CELL_LAYOUT_WIDE;
+    numCells_ = 0;
+    currBlock_ = 0;
+    CellBuildAntiAlias cell;
+    for (uint32_t i = 0; i < num; i++) {
+        cell.x = originX_ + saved[i].x;
+        cell.y = originY_ + saved[i].y;
+        cell.cover = saved[i].GetCover();
+        cell.area = saved[i].GetArea();
+        AddWideCell(cell);
+    }
+    arena_->FreeBuffer(saved, capacity);
+    return true;
 }
 
 /**
@@ -239,9 +464,16 @@ void RasterizerCellsAntiAlias::RenderHorizonline(
     currCell_.area += (submaskFlagsX2 + POLY_SUBPIXEL_SCALE - first) * delta;
 }
 
-inline void RasterizerCellsAntiAlias::SetStyle(const CellBuildAntiAlias& styleCell)
+void RasterizerCellsAntiAlias::SetStyle(int32_t left, int32_t right)
 {
-    styleCell_.Style(styleCell);
+    int16_t styleLeft = static_cast<int16_t>(MATH_MIN(MATH_MAX(left, -1), CELL_STYLE_MAX));
+    int16_t styleRight = static_cast<int16_t>(MATH_MIN(MATH_MAX(right, -1), CELL_STYLE_MAX));
+    if (styleLeft != styleLeft_ || styleRight != styleRight_) {
+        AddCurrentCell();
+        currCell_.Initial();
+        styleLeft_ = styleLeft;
+        styleRight_ = styleRight;
+    }
 }
 
 /**
@@ -251,6 +483,73 @@ inline void RasterizerCellsAntiAlias::SetStyle(const CellBuildAntiAlias& styleCe
  * @version 1.0
  */
 void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if (bandHeight_ > 0) {
+        RecordEdge(x1, y1, x2, y2);
+        return;
+    }
+    RenderLine(x1, y1, x2, y2);
+}
+
+void RasterizerCellsAntiAlias::RecordEdge(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    OutLineLegal(x1 >> POLY_SUBPIXEL_SHIFT, y1 >> POLY_SUBPIXEL_SHIFT,
+                 x2 >> POLY_SUBPIXEL_SHIFT, y2 >> POLY_SUBPIXEL_SHIFT);
+    if ((edgeNum_ + 1) * sizeof(RasterizerEdge) > edgeCapacity_) {
+        uint32_t capacity = 0;
+        uint32_t size = MATH_MAX(edgeCapacity_ * TWO_TIMES,
+                                 static_cast<uint32_t>(CELLS_SIZE * sizeof(RasterizerEdge)));
+        RasterizerEdge* edges = static_cast<RasterizerEdge*>(arena_->AllocateBuffer(size, capacity));
+        if (edges == nullptr) {
+            return;
+        }
+        if (edgeNum_ > 0 && memcpy_s(edges, capacity, edges_, edgeNum_ * sizeof(RasterizerEdge)) != EOK) {
+            GRAPHIC_LOGE("RasterizerCellsAntiAlias::RecordEdge memcpy_s fail");
+            arena_->FreeBuffer(edges, capacity);
+            return;
+        }
+        arena_->FreeBuffer(edges_, edgeCapacity_);
+        edges_ = edges;
+        edgeCapacity_ = capacity;
+    }
+    RasterizerEdge& edge = edges_[edgeNum_++];
+    edge.x1 = x1;
+    edge.y1 = y1;
+    edge.x2 = x2;
+    edge.y2 = y2;
+}
+
+void RasterizerCellsAntiAlias::RasterizeBand(int32_t y)
+{
+    // After a split the bands grow back by doubling, a dense region does not cost every later band a retry
+    int32_t height = (bandCount_ > 0 && bandMaxY_ >= bandMinY_) ?
+        MATH_MIN((bandMaxY_ - bandMinY_ + 1) * TWO_TIMES, bandHeight_) : bandHeight_;
+    while (true) {
+        ResetCells();
+        bandMinY_ = y;
+        bandMaxY_ = y + height - 1;
+        for (uint32_t i = 0; i < edgeNum_ && !cellsOverflow_; i++) {
+            const RasterizerEdge& edge = edges_[i];
+            int32_t ey1 = edge.y1 >> POLY_SUBPIXEL_SHIFT;
+            int32_t ey2 = edge.y2 >> POLY_SUBPIXEL_SHIFT;
+            if (MATH_MAX(ey1, ey2) >= bandMinY_ && MATH_MIN(ey1, ey2) <= bandMaxY_) {
+                RenderLine(edge.x1, edge.y1, edge.x2, edge.y2);
+            }
+        }
+        AddCurrentCell();
+        currCell_.Initial();
+        // A band that hits the cell block limit is rasterized again with half the rows
+        if (!cellsOverflow_ || height == 1) {
+            break;
+        }
+        height = (height + 1) / TWO_TIMES;
+    }
+    bandCount_++;
+    SortCells();
+    sorted_ = true;
+}
+
+void RasterizerCellsAntiAlias::RenderLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
     int64_t dx = static_cast<int64_t>(x2) - static_cast<int64_t>(x1);
     /**
@@ -259,8 +558,8 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     if (dx >= DX_LIMIT || dx <= -DX_LIMIT) {
         int32_t cx = static_cast<int32_t>(((int64_t)x1 + (int64_t)x2) >> 1);
         int32_t cy = static_cast<int32_t>(((int64_t)y1 + (int64_t)y2) >> 1);
-        LineOperate(x1, y1, cx, cy);
-        LineOperate(cx, cy, x2, y2);
+        RenderLine(x1, y1, cx, cy);
+        RenderLine(cx, cy, x2, y2);
         return;
     }
     /**
@@ -331,6 +630,34 @@ void RasterizerCellsAntiAlias::LineOperate(int32_t x1, int32_t y1, int32_t x2, i
     RenderHorizonline(ey1, xFrom, POLY_SUBPIXEL_SCALE - first, x2, submaskFlagsY2);
 }
 
+/**
+ * @brief Number of rows from ey towards eyEnd that lie before the current band.
+ * @since 1.0
+ * @version 1.0
+ */
+inline int32_t RasterizerCellsAntiAlias::GetRowsBeforeBand(int32_t ey, int32_t eyEnd, int32_t increase) const
+{
+    if (bandHeight_ == 0) {
+        return 0;
+    }
+    int32_t rows = (increase > 0) ? (bandMinY_ - ey) : (ey - bandMaxY_);
+    return MATH_MIN(rows, (eyEnd - ey) * increase);
+}
+
+/**
+ * @brief Steps the x of an oblique line over rows rows at once, exactly like rows iterations of
+ * the loop in RenderObliqueLine.
+ * @since 1.0
+ * @version 1.0
+ */
+static void AdvanceObliqueLine(int32_t rows, int32_t lift, int32_t rem, int64_t dy, int32_t& mod, int32_t& xFrom)
+{
+    int64_t total = mod + dy + static_cast<int64_t>(rows) * rem;
+    int64_t carries = total / dy;
+    xFrom = static_cast<int32_t>(xFrom + static_cast<int64_t>(rows) * lift + carries);
+    mod = static_cast<int32_t>(total - carries * dy - dy);
+}
+
 void RasterizerCellsAntiAlias::RenderVerticalLine(int32_t& x1, int32_t& ex1, int64_t& dy, int32_t& first, int32_t& increase, int32_t& xFrom,
                                                   int32_t& submaskFlagsY1, int32_t& submaskFlagsY2, int32_t& ey1, int32_t& ey2, int32_t& delta)
 {
@@ -357,7 +684,18 @@ void RasterizerCellsAntiAlias::RenderVerticalLine(int32_t& x1, int32_t& ex1, int
     /* The color mask is from (poly_subpixel_scale - first) -> first */
     delta = first + first - POLY_SUBPIXEL_SCALE;
     area = twoFx * delta;
+    // Rows outside of the band would only build dropped cells, they are stepped over
+    int32_t skip = GetRowsBeforeBand(ey1, ey2, increase);
+    if (skip > 0) {
+        ey1 += skip * increase;
+        SetCurrentCell(ex1, ey1);
+    }
     while (ey1 != ey2) {
+        if (ey1 < bandMinY_ || ey1 > bandMaxY_) {
+            ey1 = ey2;
+            SetCurrentCell(ex1, ey1);
+            break;
+        }
         /* from poly_subpixel_scale - first to  first */
         currCell_.cover = delta;
         currCell_.area = area;
@@ -383,7 +721,20 @@ void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32
         remDyMask += dy;
     }
     int32_t modDyMask = -dy;
+    // Rows outside of the band would only build dropped cells, the x stepping jumps over them
+    int32_t skip = GetRowsBeforeBand(ey1, ey2, increase);
+    if (skip > 0) {
+        AdvanceObliqueLine(skip, liftDyMask, remDyMask, dy, modDyMask, xFrom);
+        ey1 += skip * increase;
+        SetCurrentCell(xFrom >> POLY_SUBPIXEL_SHIFT, ey1);
+    }
     while (ey1 != ey2) {
+        if (ey1 < bandMinY_ || ey1 > bandMaxY_) {
+            AdvanceObliqueLine((ey2 - ey1) * increase, liftDyMask, remDyMask, dy, modDyMask, xFrom);
+            ey1 = ey2;
+            SetCurrentCell(xFrom >> POLY_SUBPIXEL_SHIFT, ey1);
+            break;
+        }
         delta = liftDyMask;
         modDyMask += remDyMask;
         if (modDyMask >= 0) {
@@ -403,7 +754,7 @@ void RasterizerCellsAntiAlias::RenderObliqueLine(int64_t& dx, int64_t& dy, int32
  * @since 1.0
  * @version 1.0
  */
-void RasterizerCellsAntiAlias::AllocateBlock()
+bool RasterizerCellsAntiAlias::AllocateBlock()
 {
     if (currBlock_ >= numBlocks_) {
         if (numBlocks_ >= maxBlocks_) {
@@ -414,17 +765,40 @@ void RasterizerCellsAntiAlias::AllocateBlock()
                 if (memcpy_s(newCells, maxBlocks_ * sizeof(CellBuildAntiAlias*),
                              cells_, maxBlocks_ * sizeof(CellBuildAntiAlias*)) != EOK) {
                     GRAPHIC_LOGE("RasterizerCellsAntiAlias::AllocateBlock memcpy_s fail\n");
-                    return;
+                    GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(newCells, maxBlocks_ + CELL_BLOCK_POOL);
+                    return false;
                 }
                 GeometryArrayAllocator<CellBuildAntiAlias*>::Deallocate(cells_, maxBlocks_);
             }
             cells_ = newCells;
             maxBlocks_ += CELL_BLOCK_POOL;
         }
-        cells_[numBlocks_++] = GeometryArrayAllocator<CellBuildAntiAlias>::Allocate(CELL_BLOCK_SIZE);
+        CellBuildAntiAlias* block = static_cast<CellBuildAntiAlias*>(arena_->AllocateBlock());
+        if (block == nullptr) {
+            return false;
+        }
+        cells_[numBlocks_++] = block;
     }
 
     currCellPtr_ = cells_[currBlock_++];
+    currCompactPtr_ = reinterpret_cast<CellCompactAntiAlias*>(currCellPtr_);
+    currStyledPtr_ = reinterpret_cast<CellStyleAntiAlias*>(currCellPtr_);
+    return true;
+}
+
+/**
+ * @brief Makes sure the arena buffer holds size bytes, the buffer is kept across frames and only grows.
+ * @since 1.0
+ * @version 1.0
+ */
+bool RasterizerCellsAntiAlias::ReserveBuffer(void*& buffer, uint32_t& capacity, uint32_t size)
+{
+    if (size <= capacity) {
+        return true;
+    }
+    arena_->FreeBuffer(buffer, capacity);
+    buffer = arena_->AllocateBuffer(size, capacity);
+    return buffer != nullptr;
 }
 /**
  * @brief In the rasterization process, all cells are rasterized according to
@@ -437,7 +811,17 @@ void RasterizerCellsAntiAlias::SortAllCells()
     if (sorted_) {
         return; // Perform sort only the first time.
     }
+    if (bandHeight_ > 0) {
+        if (edgeNum_ > 0) {
+            RasterizeBand(minY_);
+        }
+        return;
+    }
+    SortCells();
+}
 
+void RasterizerCellsAntiAlias::SortCells()
+{
     AddCurrentCell();
     currCell_.x = INT32_MAX;
     currCell_.y = INT32_MAX;
@@ -447,16 +831,58 @@ void RasterizerCellsAntiAlias::SortAllCells()
         return;
     }
 
-    // Allocate the array of cell pointers
-    sortedCells_ = GeometryArrayAllocator<CellBuildAntiAlias*>::Allocate(numCells_ + CELLS_SIZE);
+    // Allocate the sorted cell array and the Y array, both are retained for the next frames.
+    // In band mode the Y array only spans the rows of the current band.
+    sortedMinY_ = MATH_MAX(minY_, bandMinY_);
+    sortedMaxY_ = MATH_MIN(maxY_, bandMaxY_);
+    uint32_t sortedYSize = sortedMaxY_ - sortedMinY_ + 1;
+    uint32_t cellBytes = sizeof(CellBuildAntiAlias*);
+    if (layout_ == CELL_LAYOUT_COMPACT) {
+        cellBytes = sizeof(CellCompactAntiAlias);
+    } else if (layout_ == CELL_LAYOUT_STYLED) {
+        cellBytes = sizeof(CellStyleRowAntiAlias);
+    }
+    void* sortedCells = sortedCells_;
+    void* sortedY = sortedY_;
+    bool reserved = ReserveBuffer(sortedCells, sortedCellsCapacity_, (numCells_ + CELLS_SIZE) * cellBytes);
+    sortedCells_ = static_cast<CellBuildAntiAlias**>(sortedCells);
+    reserved = ReserveBuffer(sortedY, sortedYCapacity_, (sortedYSize + CELLS_SIZE) * sizeof(SortedYLevel)) && reserved;
+    sortedY_ = static_cast<SortedYLevel*>(sortedY);
+    if (!reserved) {
+        numCells_ = 0;
+        sorted_ = true;
+        return;
+    }
 
-    // Allocate and zero the Y array
-    uint32_t sortedYSize = maxY_ - minY_ + 1;
-    sortedY_ = GeometryArrayAllocator<SortedYLevel>::Allocate(sortedYSize + CELLS_SIZE);
+    // Zero the Y array
     if (memset_s(sortedY_, sizeof(SortedYLevel) * sortedYSize, 0, sizeof(SortedYLevel) * sortedYSize) != EOK) {
         GRAPHIC_LOGE("CleanData fail");
     }
+    if (layout_ == CELL_LAYOUT_COMPACT) {
+        SortCompactCells(sortedYSize);
+    } else if (layout_ == CELL_LAYOUT_STYLED) {
+        SortStyledCells(sortedYSize);
+    } else {
+        SortPointerCells(sortedYSize);
+    }
+    sorted_ = true;
+}
+
+/**
+ * @brief Rows are sorted with a radix sort from RADIX_SORT_PASS_CELLS cells per pass needed by the x range on.
+ */
+static uint32_t GetRadixThreshold(int32_t minX, int32_t maxX)
+{
+    uint32_t range = static_cast<uint32_t>(maxX) - static_cast<uint32_t>(minX);
+    uint32_t radixThreshold = RADIX_SORT_PASS_CELLS;
+    while ((range >>= RADIX_SORT_DIGIT_BITS) != 0) {
+        radixThreshold += RADIX_SORT_PASS_CELLS;
+    }
+    return radixThreshold;
+}
 
+void RasterizerCellsAntiAlias::SortPointerCells(uint32_t sortedYSize)
+{
     // Create the Y-histogram (count the numbers of cells for each Y)
     CellBuildAntiAlias** blockPtr = cells_;
     CellBuildAntiAlias* cellPtr = nullptr;
@@ -467,7 +893,7 @@ void RasterizerCellsAntiAlias::SortAllCells()
         i = (nb > CELL_BLOCK_SIZE) ? uint32_t(CELL_BLOCK_SIZE) : nb;
         nb -= i;
         while (i--) {
-            sortedY_[cellPtr->y - minY_].start++;
+            sortedY_[cellPtr->y - sortedMinY_].start++;
             ++cellPtr;
         }
     }
@@ -488,21 +914,426 @@ void RasterizerCellsAntiAlias::SortAllCells()
         i = (nb > CELL_BLOCK_SIZE) ? uint32_t(CELL_BLOCK_SIZE) : nb;
         nb -= i;
         while (i--) {
-            SortedYLevel& currY = sortedY_[cellPtr->y - minY_];
+            SortedYLevel& currY = sortedY_[cellPtr->y - sortedMinY_];
             sortedCells_[currY.start + currY.num] = cellPtr;
             ++currY.num;
             ++cellPtr;
         }
     }
 
-    // Finally arrange the X-arrays
+    // Finally arrange the X-arrays, long rows are sorted by value with a radix sort
+    uint32_t radixThreshold = GetRadixThreshold(minX_, maxX_);
+    uint32_t maxRowCells = 0;
+    for (i = 0; i < sortedYSize; i++) {
+        maxRowCells = MATH_MAX(maxRowCells, sortedY_[i].num);
+    }
+    CellBuildAntiAlias** cellBuffer = nullptr;
+    uint32_t* keyBuffer = nullptr;
+    uint32_t cellBufferCapacity = 0;
+    uint32_t keyBufferCapacity = 0;
+    if (maxRowCells >= radixThreshold) {
+        cellBuffer = static_cast<CellBuildAntiAlias**>(
+            arena_->AllocateBuffer(maxRowCells * sizeof(CellBuildAntiAlias*), cellBufferCapacity));
+        keyBuffer = static_cast<uint32_t*>(
+            arena_->AllocateBuffer(maxRowCells * TWO_TIMES * sizeof(uint32_t), keyBufferCapacity));
+    }
+    bool radixSort = (cellBuffer != nullptr && keyBuffer != nullptr);
     for (i = 0; i < sortedYSize; i++) {
         const SortedYLevel& currY = sortedY_[i];
-        if (currY.num) {
+        if (radixSort && currY.num >= radixThreshold) {
+            RadixSortCells(sortedCells_ + currY.start, currY.num, cellBuffer, keyBuffer);
+        } else if (currY.num) {
             QsortCells(sortedCells_ + currY.start, currY.num);
         }
     }
-    sorted_ = true;
+    arena_->FreeBuffer(cellBuffer, cellBufferCapacity);
+    arena_->FreeBuffer(keyBuffer, keyBufferCapacity);
+}
+
+void RasterizerCellsAntiAlias::SortCompactCells(uint32_t sortedYSize)
+{
+    CellCompactAntiAlias* sortedCells = reinterpret_cast<CellCompactAntiAlias*>(sortedCells_);
+    SortedYLevel* sortedY = sortedY_ + (originY_ - sortedMinY_);
+
+    // Create the Y-histogram, the cells are read block by block
+    uint32_t nb = numCells_;
+    for (uint32_t block = 0; nb > 0; block++) {
+        const CellCompactAntiAlias* cellPtr = reinterpret_cast<const CellCompactAntiAlias*>(cells_[block]);
+        uint32_t i = MATH_MIN(nb, static_cast<uint32_t>(COMPACT_CELL_BLOCK_SIZE));
+        nb -= i;
+        while (i--) {
+            sortedY[cellPtr->y].start++;
+            ++cellPtr;
+        }
+    }
+
+    // Convert the Y-histogram into the array of starting indexes
+    uint32_t start = 0;
+    uint32_t maxRowCells = 0;
+    for (uint32_t i = 0; i < sortedYSize; i++) {
+        uint32_t v = sortedY_[i].start;
+        sortedY_[i].start = start;
+        start += v;
+        maxRowCells = MATH_MAX(maxRowCells, v);
+    }
+
+    // Copy the cells themselves into their rows, the sweep then reads every row linearly
+    nb = numCells_;
+    for (uint32_t block = 0; nb > 0; block++) {
+        const CellCompactAntiAlias* cellPtr = reinterpret_cast<const CellCompactAntiAlias*>(cells_[block]);
+        uint32_t i = MATH_MIN(nb, static_cast<uint32_t>(COMPACT_CELL_BLOCK_SIZE));
+        nb -= i;
+        while (i--) {
+            SortedYLevel& currY = sortedY[cellPtr->y];
+            sortedCells[currY.start + currY.num] = *cellPtr;
+            ++currY.num;
+            ++cellPtr;
+        }
+    }
+
+    // Finally arrange the X-arrays
+    uint32_t radixThreshold = GetRadixThreshold(minX_, maxX_);
+    CellCompactAntiAlias* cellBuffer = nullptr;
+    uint32_t cellBufferCapacity = 0;
+    if (maxRowCells >= radixThreshold) {
+        cellBuffer = static_cast<CellCompactAntiAlias*>(
+            arena_->AllocateBuffer(maxRowCells * sizeof(CellCompactAntiAlias), cellBufferCapacity));
+    }
+    if (cellBuffer == nullptr) {
+        radixThreshold = UINT32_MAX;
+    }
+    for (uint32_t i = 0; i < sortedYSize; i++) {
+        const SortedYLevel& currY = sortedY_[i];
+        if (currY.num > 1) {
+            SortCompactCellRow(sortedCells + currY.start, currY.num, cellBuffer, radixThreshold);
+        }
+    }
+    arena_->FreeBuffer(cellBuffer, cellBufferCapacity);
+}
+
+void RasterizerCellsAntiAlias::SortStyledCells(uint32_t sortedYSize)
+{
+    CellStyleRowAntiAlias* sortedCells = reinterpret_cast<CellStyleRowAntiAlias*>(sortedCells_);
+
+    // Create the Y-histogram, the cells are read block by block
+    uint32_t nb = numCells_;
+    for (uint32_t block = 0; nb > 0; block++) {
+        const CellStyleAntiAlias* cellPtr = reinterpret_cast<const CellStyleAntiAlias*>(cells_[block]);
+        uint32_t i = MATH_MIN(nb, static_cast<uint32_t>(STYLED_CELL_BLOCK_SIZE));
+        nb -= i;
+        while (i--) {
+            sortedY_[cellPtr->y - sortedMinY_].start++;
+            ++cellPtr;
+        }
+    }
+
+    // Convert the Y-histogram into the array of starting indexes
+    uint32_t start = 0;
+    uint32_t maxRowCells = 0;
+    for (uint32_t i = 0; i < sortedYSize; i++) {
+        uint32_t v = sortedY_[i].start;
+        sortedY_[i].start = start;
+        start += v;
+        maxRowCells = MATH_MAX(maxRowCells, v);
+    }
+
+    // Copy the cells without their y into their rows, the compound sweep then reads every style of a row linearly
+    nb = numCells_;
+    for (uint32_t block = 0; nb > 0; block++) {
+        const CellStyleAntiAlias* cellPtr = reinterpret_cast<const CellStyleAntiAlias*>(cells_[block]);
+        uint32_t i = MATH_MIN(nb, static_cast<uint32_t>(STYLED_CELL_BLOCK_SIZE));
+        nb -= i;
+        while (i--) {
+            SortedYLevel& currY = sortedY_[cellPtr->y - sortedMinY_];
+            CellStyleRowAntiAlias& rowCell = sortedCells[currY.start + currY.num];
+            rowCell.x = cellPtr->x;
+            rowCell.area = cellPtr->area;
+            rowCell.cover = cellPtr->cover;
+            rowCell.style = cellPtr->style;
+            ++currY.num;
+            ++cellPtr;
+        }
+    }
+
+    // The rows are sorted when they are swept, the styles take one more radix pass after the x ones
+    rowRadixThreshold_ = GetRadixThreshold(minX_, maxX_) + RADIX_SORT_PASS_CELLS;
+    if (maxRowCells >= rowRadixThreshold_) {
+        void* rowBuffer = rowBuffer_;
+        bool reserved = ReserveBuffer(rowBuffer, rowBufferCapacity_, maxRowCells * sizeof(CellStyleRowAntiAlias));
+        rowBuffer_ = static_cast<CellStyleRowAntiAlias*>(rowBuffer);
+        if (!reserved) {
+            rowRadixThreshold_ = UINT32_MAX;
+        }
+    }
+}
+
+/**
+ * @brief Radix key of a styled cell, its style or its x relative to the minimum of the key.
+ */
+static inline uint32_t StyledCellKey(const CellStyleRowAntiAlias& cell, bool byStyle, int32_t minKey)
+{
+    int32_t key = byStyle ? cell.style : cell.x;
+    return static_cast<uint32_t>(key) - static_cast<uint32_t>(minKey);
+}
+
+/**
+ * @brief One stable LSD radix pass of styled cells over the key digit at shift, returns the sorted copy.
+ */
+static CellStyleRowAntiAlias* RadixPassStyledCells(CellStyleRowAntiAlias* src, CellStyleRowAntiAlias* dst, uint32_t num,
+                                                uint32_t shift, bool byStyle, int32_t minKey)
+{
+    uint32_t count[RADIX_SORT_BUCKETS] = {0};
+    for (uint32_t i = 0; i < num; i++) {
+        count[(StyledCellKey(src[i], byStyle, minKey) >> shift) & RADIX_SORT_DIGIT_MASK]++;
+    }
+    uint32_t offset = 0;
+    for (uint32_t digit = 0; digit < RADIX_SORT_BUCKETS; digit++) {
+        uint32_t n = count[digit];
+        count[digit] = offset;
+        offset += n;
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        dst[count[(StyledCellKey(src[i], byStyle, minKey) >> shift) & RADIX_SORT_DIGIT_MASK]++] = src[i];
+    }
+    return dst;
+}
+
+/**
+ * @brief Insertion sort of a short run of styled cells of one style by x.
+ */
+static inline void InsertionSortStyledRun(CellStyleRowAntiAlias* start, uint32_t num)
+{
+    for (uint32_t i = 1; i < num; i++) {
+        int32_t x = start[i].x;
+        if (start[i - 1].x <= x) {
+            continue;
+        }
+        CellStyleRowAntiAlias cell = start[i];
+        uint32_t j = i;
+        do {
+            start[j] = start[j - 1];
+            j--;
+        } while (j > 0 && start[j - 1].x > x);
+        start[j] = cell;
+    }
+}
+
+/**
+ * @brief Order of a styled cell in its row as one number, by style and then by x.
+ */
+static inline uint64_t StyledCellOrder(const CellStyleRowAntiAlias& cell)
+{
+    return (static_cast<uint64_t>(static_cast<uint16_t>(cell.style)) << 32) | // 32: x takes the lower half
+        (static_cast<uint32_t>(cell.x) ^ static_cast<uint32_t>(INT32_MIN));
+}
+
+/**
+ * @brief Insertion sort of styled cells by style and x, it gives up after maxMoves moves and returns false.
+ */
+static bool InsertionSortStyledCells(CellStyleRowAntiAlias* start, uint32_t num, uint32_t maxMoves)
+{
+    uint32_t moves = 0;
+    for (uint32_t i = 1; i < num; i++) {
+        uint64_t key = StyledCellOrder(start[i]);
+        if (StyledCellOrder(start[i - 1]) <= key) {
+            continue;
+        }
+        CellStyleRowAntiAlias cell = start[i];
+        uint32_t j = i;
+        do {
+            start[j] = start[j - 1];
+            j--;
+        } while (j > 0 && StyledCellOrder(start[j - 1]) > key);
+        start[j] = cell;
+        moves += i - j;
+        if (moves > maxMoves) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SortStyledCellRow(CellStyleRowAntiAlias* start, uint32_t num, CellStyleRowAntiAlias* cellBuffer,
+                       uint32_t radixThreshold)
+{
+    // Insertion sort is close to linear on cells in path order, many cells fall back to the radix sort
+    // once insertion costs more moves than its passes would
+    uint32_t maxMoves = UINT32_MAX;
+    if (num >= radixThreshold) {
+        maxMoves = num * (radixThreshold / RADIX_SORT_PASS_CELLS);
+    }
+    if (InsertionSortStyledCells(start, num, maxMoves)) {
+        return;
+    }
+    int32_t minX = INT32_MAX;
+    int32_t maxX = INT32_MIN;
+    int32_t minStyle = INT16_MAX;
+    int32_t maxStyle = 0;
+    for (uint32_t i = 0; i < num; i++) {
+        minX = MATH_MIN(minX, start[i].x);
+        maxX = MATH_MAX(maxX, start[i].x);
+        minStyle = MATH_MIN(minStyle, static_cast<int32_t>(start[i].style));
+        maxStyle = MATH_MAX(maxStyle, static_cast<int32_t>(start[i].style));
+    }
+    uint32_t rangeX = static_cast<uint32_t>(maxX) - static_cast<uint32_t>(minX);
+    uint32_t rangeStyle = static_cast<uint32_t>(maxStyle - minStyle);
+    CellStyleRowAntiAlias* src = start;
+    for (uint32_t shift = 0; shift < sizeof(uint32_t) * BYTE_LENGTH && (rangeX >> shift) != 0;
+         shift += RADIX_SORT_DIGIT_BITS) {
+        src = RadixPassStyledCells(src, (src == start) ? cellBuffer : start, num, shift, false, minX);
+    }
+    for (uint32_t shift = 0; (rangeStyle >> shift) != 0; shift += RADIX_SORT_DIGIT_BITS) {
+        src = RadixPassStyledCells(src, (src == start) ? cellBuffer : start, num, shift, true, minStyle);
+    }
+    if (src != start) {
+        if (memcpy_s(start, num * sizeof(CellStyleRowAntiAlias), src, num * sizeof(CellStyleRowAntiAlias)) != EOK) {
+            GRAPHIC_LOGE("SortStyledCellRow fail");
+        }
+    }
+}
+
+uint32_t RasterizerCellsAntiAlias::SortScanlineStyledCells(uint32_t yLevel, int32_t* styles, uint32_t* starts)
+{
+    const SortedYLevel& currY = sortedY_[yLevel - sortedMinY_];
+    CellStyleRowAntiAlias* row = reinterpret_cast<CellStyleRowAntiAlias*>(sortedCells_) + currY.start;
+    uint32_t num = currY.num;
+    // Shapes added in style order leave the styles of a row ascending, then only every run of one style
+    // is sorted by x. Otherwise the whole row is sorted and its runs are found again.
+    bool sortRuns = true;
+    uint32_t numStyles = 0;
+    uint32_t runStart = 0;
+    for (uint32_t i = 1; i <= num; i++) {
+        if (i < num && row[i].style == row[runStart].style) {
+            continue;
+        }
+        if (sortRuns && i < num && row[i].style < row[runStart].style) {
+            SortStyledCellRow(row, num, rowBuffer_, rowRadixThreshold_);
+            sortRuns = false;
+            numStyles = 0;
+            runStart = 0;
+            i = 0;
+            continue;
+        }
+        if (sortRuns && i - runStart >= rowRadixThreshold_) {
+            SortStyledCellRow(row + runStart, i - runStart, rowBuffer_, rowRadixThreshold_);
+        } else if (sortRuns) {
+            InsertionSortStyledRun(row + runStart, i - runStart);
+        }
+        styles[numStyles] = row[runStart].style;
+        starts[numStyles++] = runStart;
+        runStart = i;
+    }
+    starts[numStyles] = num;
+    return numStyles;
+}
+
+const CellStyleRowAntiAlias* RasterizerCellsAntiAlias::GetScanlineStyledCells(uint32_t yLevel) const
+{
+    return reinterpret_cast<const CellStyleRowAntiAlias*>(sortedCells_) + sortedY_[yLevel - sortedMinY_].start;
+}
+
+void SortCompactCellRow(CellCompactAntiAlias* start, uint32_t num, CellCompactAntiAlias* cellBuffer,
+                        uint32_t radixThreshold)
+{
+    if (num < radixThreshold) {
+        for (uint32_t i = 1; i < num; i++) {
+            CellCompactAntiAlias cell = start[i];
+            uint32_t j = i;
+            for (; j > 0 && start[j - 1].x > cell.x; j--) {
+                start[j] = start[j - 1];
+            }
+            start[j] = cell;
+        }
+        return;
+    }
+    int32_t minX = INT16_MAX;
+    int32_t maxX = INT16_MIN;
+    for (uint32_t i = 0; i < num; i++) {
+        minX = MATH_MIN(minX, static_cast<int32_t>(start[i].x));
+        maxX = MATH_MAX(maxX, static_cast<int32_t>(start[i].x));
+    }
+    uint32_t range = static_cast<uint32_t>(maxX - minX);
+    CellCompactAntiAlias* src = start;
+    CellCompactAntiAlias* dst = cellBuffer;
+    uint32_t count[RADIX_SORT_BUCKETS];
+    for (uint32_t shift = 0; (range >> shift) != 0; shift += RADIX_SORT_DIGIT_BITS) {
+        if (memset_s(count, sizeof(count), 0, sizeof(count)) != EOK) {
+            GRAPHIC_LOGE("SortCompactCellRow fail");
+            return;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            count[((src[i].x - minX) >> shift) & RADIX_SORT_DIGIT_MASK]++;
+        }
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RADIX_SORT_BUCKETS; digit++) {
+            uint32_t n = count[digit];
+            count[digit] = offset;
+            offset += n;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            dst[count[((src[i].x - minX) >> shift) & RADIX_SORT_DIGIT_MASK]++] = src[i];
+        }
+        SwapCells(&src, &dst);
+    }
+    if (src != start) {
+        if (memcpy_s(start, num * sizeof(CellCompactAntiAlias), src, num * sizeof(CellCompactAntiAlias)) != EOK) {
+            GRAPHIC_LOGE("SortCompactCellRow fail");
+        }
+    }
+}
+
+void RadixSortCells(CellBuildAntiAlias** start, uint32_t num, CellBuildAntiAlias** cellBuffer, uint32_t* keyBuffer)
+{
+    /*
+     * The x of every cell is read once into a key relative to the row minimum,
+     * then keys and cell pointers are moved together, 8 bits per pass, least significant digit first.
+     */
+    int32_t minX = INT32_MAX;
+    int32_t maxX = INT32_MIN;
+    for (uint32_t i = 0; i < num; i++) {
+        int32_t x = start[i]->x;
+        minX = MATH_MIN(minX, x);
+        maxX = MATH_MAX(maxX, x);
+        keyBuffer[i] = static_cast<uint32_t>(x);
+    }
+    uint32_t range = static_cast<uint32_t>(maxX) - static_cast<uint32_t>(minX);
+    for (uint32_t i = 0; i < num; i++) {
+        keyBuffer[i] -= static_cast<uint32_t>(minX);
+    }
+
+    CellBuildAntiAlias** srcCells = start;
+    CellBuildAntiAlias** dstCells = cellBuffer;
+    uint32_t* srcKeys = keyBuffer;
+    uint32_t* dstKeys = keyBuffer + num;
+    uint32_t count[RADIX_SORT_BUCKETS];
+    for (uint32_t shift = 0; shift < sizeof(uint32_t) * BYTE_LENGTH && (range >> shift) != 0;
+         shift += RADIX_SORT_DIGIT_BITS) {
+        if (memset_s(count, sizeof(count), 0, sizeof(count)) != EOK) {
+            GRAPHIC_LOGE("RadixSortCells fail");
+            return;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            count[(srcKeys[i] >> shift) & RADIX_SORT_DIGIT_MASK]++;
+        }
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RADIX_SORT_BUCKETS; digit++) {
+            uint32_t n = count[digit];
+            count[digit] = offset;
+            offset += n;
+        }
+        for (uint32_t i = 0; i < num; i++) {
+            uint32_t index = count[(srcKeys[i] >> shift) & RADIX_SORT_DIGIT_MASK]++;
+            dstKeys[index] = srcKeys[i];
+            dstCells[index] = srcCells[i];
+        }
+        SwapCells(&srcKeys, &dstKeys);
+        SwapCells(&srcCells, &dstCells);
+    }
+    if (srcCells != start) {
+        if (memcpy_s(start, num * sizeof(CellBuildAntiAlias*), srcCells, num * sizeof(CellBuildAntiAlias*)) != EOK) {
+            GRAPHIC_LOGE("RadixSortCells fail");
+        }
+    }
 }
 
 void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex)
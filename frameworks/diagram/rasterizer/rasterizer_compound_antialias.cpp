@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_compound_antialias.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "securec.h"
+
+namespace OHOS {
+#if GRAPHIC_ENABLE_COMPOUND_RASTERIZER_FLAG
+void RasterizerCompoundAntialias::Reset()
+{
+    outline_.Reset();
+    status_ = STATUS_INITIAL;
+    minStyle_ = INT32_MAX;
+    maxStyle_ = INT32_MIN;
+    activeNum_ = 0;
+}
+
+void RasterizerCompoundAntialias::ClipBox(float x1, float y1, float x2, float y2)
+{
+    Reset();
+    clipper_.ClipBox(RasterDepictInt::UpScale(x1), RasterDepictInt::UpScale(y1),
+                     RasterDepictInt::UpScale(x2), RasterDepictInt::UpScale(y2));
+}
+
+void RasterizerCompoundAntialias::ResetClipping()
+{
+    Reset();
+    clipper_.ResetClipping();
+}
+
+void RasterizerCompoundAntialias::SetStyleFillingRule(int32_t style, FillingRule rule)
+{
+    if (style < 0 || style > CELL_STYLE_MAX) {
+        return;
+    }
+    uint32_t size = styleRules_.GetSize();
+    if (static_cast<uint32_t>(style) >= size) {
+        GeometryPlainDataArray<uint8_t> rules(MATH_MAX(static_cast<uint32_t>(style) + 1, size * 2)); // 2: double
+        if (rules.Data() == nullptr) {
+            GRAPHIC_LOGE("RasterizerCompoundAntialias::SetStyleFillingRule alloc fail");
+            return;
+        }
+        if (size > 0 && memcpy_s(rules.Data(), rules.GetSize(), styleRules_.Data(), size) != EOK) {
+            GRAPHIC_LOGE("RasterizerCompoundAntialias::SetStyleFillingRule memcpy_s fail");
+            return;
+        }
+        if (memset_s(rules.Data() + size, rules.GetSize() - size, STYLE_RULE_DEFAULT, rules.GetSize() - size) != EOK) {
+            GRAPHIC_LOGE("RasterizerCompoundAntialias::SetStyleFillingRule memset_s fail");
+            return;
+        }
+        styleRules_ = rules;
+    }
+    styleRules_[style] = static_cast<uint8_t>(rule);
+}
+
+void RasterizerCompoundAntialias::Styles(int32_t left, int32_t right)
+{
+    if (outline_.GetSorted()) {
+        Reset();
+    }
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    left = MATH_MIN(left, CELL_STYLE_MAX);
+    right = MATH_MIN(right, CELL_STYLE_MAX);
+    outline_.SetStyle(left, right);
+    if (left >= 0) {
+        minStyle_ = MATH_MIN(minStyle_, left);
+        maxStyle_ = MATH_MAX(maxStyle_, left);
+    }
+    if (right >= 0) {
+        minStyle_ = MATH_MIN(minStyle_, right);
+        maxStyle_ = MATH_MAX(maxStyle_, right);
+    }
+}
+
+void RasterizerCompoundAntialias::ClosePolygon()
+{
+    if (status_ == STATUS_LINE_TO) {
+        clipper_.LineTo(outline_, startX_, startY_);
+        status_ = STATUS_CLOSED;
+    }
+}
+
+void RasterizerCompoundAntialias::MoveTo(int32_t x, int32_t y)
+{
+    if (outline_.GetSorted()) {
+        Reset();
+    }
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    clipper_.MoveTo(startX_ = RasterDepictInt::DownScale(x),
+                    startY_ = RasterDepictInt::DownScale(y));
+    status_ = STATUS_MOVE_TO;
+}
+
+void RasterizerCompoundAntialias::LineTo(int32_t x, int32_t y)
+{
+    clipper_.LineTo(outline_, RasterDepictInt::DownScale(x), RasterDepictInt::DownScale(y));
+    status_ = STATUS_LINE_TO;
+}
+
+void RasterizerCompoundAntialias::MoveToByfloat(float x, float y)
+{
+    if (outline_.GetSorted()) {
+        Reset();
+    }
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    clipper_.MoveTo(startX_ = RasterDepictInt::UpScale(x),
+                    startY_ = RasterDepictInt::UpScale(y));
+    status_ = STATUS_MOVE_TO;
+}
+
+void RasterizerCompoundAntialias::LineToByfloat(float x, float y)
+{
+    clipper_.LineTo(outline_, RasterDepictInt::UpScale(x), RasterDepictInt::UpScale(y));
+    status_ = STATUS_LINE_TO;
+}
+
+void RasterizerCompoundAntialias::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveToByfloat(x, y);
+    } else if (IsVertex(cmd)) {
+        LineToByfloat(x, y);
+    } else if (IsClose(cmd)) {
+        ClosePolygon();
+    }
+}
+
+void RasterizerCompoundAntialias::AddVertices(const PathVertex* vertices, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        AddVertex(vertices[i].x, vertices[i].y, vertices[i].cmd);
+    }
+}
+
+uint32_t RasterizerCompoundAntialias::CalculateAlpha(int32_t area, FillingRule rule) const
+{
+    int32_t cover = area >> (POLY_SUBPIXEL_SHIFT * 2 + 1 - AA_SHIFT);
+    if (cover < 0) {
+        cover = -cover;
+    }
+    if (rule == FILL_EVEN_ODD) {
+        cover &= AA_MASK2;
+        if (cover > AA_SCALE) {
+            cover = AA_SCALE2 - cover;
+        }
+    }
+    if (cover > AA_MASK) {
+        cover = AA_MASK;
+    }
+    return cover;
+}
+
+bool RasterizerCompoundAntialias::RewindScanlines()
+{
+    if (autoClose_) {
+        ClosePolygon();
+    }
+    outline_.SortAllCells();
+    activeNum_ = 0;
+    if (outline_.IsEmpty() || maxStyle_ < minStyle_) {
+        return false;
+    }
+    // A scanline holds at most every style once, plus the end of the last run
+    uint32_t styleNum = static_cast<uint32_t>(maxStyle_ - minStyle_ + 1);
+    if (activeStyles_.GetSize() < styleNum) {
+        activeStyles_.Resize(styleNum);
+        styleStarts_.Resize(styleNum + 1);
+        if (activeStyles_.Data() == nullptr || styleStarts_.Data() == nullptr) {
+            GRAPHIC_LOGE("RasterizerCompoundAntialias::RewindScanlines alloc fail");
+            return false;
+        }
+    }
+    scanY_ = outline_.GetMinY();
+    return true;
+}
+
+uint32_t RasterizerCompoundAntialias::SweepStyles()
+{
+    while (scanY_ <= outline_.GetMaxY()) {
+        int32_t y = scanY_++;
+        uint32_t numCells = outline_.GetScanlineNumCells(y);
+        if (numCells == 0) {
+            continue;
+        }
+        activeNum_ = outline_.SortScanlineStyledCells(y, activeStyles_.Data(), styleStarts_.Data());
+        currCells_ = outline_.GetScanlineStyledCells(y);
+        currY_ = y;
+        return activeNum_;
+    }
+    activeNum_ = 0;
+    return 0;
+}
+#endif
+} // namespace OHOS
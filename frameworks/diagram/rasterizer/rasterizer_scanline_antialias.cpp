@@ -14,67 +14,185 @@
  */
 
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "graphic_mutex.h"
+#include "graphic_semaphore.h"
+#include "graphic_thread.h"
+#include "hal_atomic.h"
+#include "hal_cpu.h"
 
 namespace OHOS {
 /**
- * @brief Scan line that gets a y value from rasterizer stage
- * And iterate the cell array of the current scan line to obtain area->cover，
- * Use both to calculate delta area as area cover and convert it into gamma cover
- * the color information is obtained successfully,
- * and then the alpha information of color is calculated by gamma function
- * Fill in the new scanline and have subsequent render.
- * @since 1.0
- * @version 1.0
+ * Shared state of one SweepScanlineParallel call, the bands are handed out
+ * in ascending order through nextBand. In ordered mode the band b renders after
+ * turns[b % turnNum] was posted by band b - 1, at most turnNum bands are in flight.
+ */
+struct SweepBandContext {
+    const RasterizerScanlineAntialias* rasterizer;
+    RasterizerScanlineAntialias::ScanlineRender render;
+    void* param;
+    int32_t bandHeight;
+    uint32_t bandNum;
+    bool ordered;
+    volatile uint32_t nextBand;
+    GraphicSemaphore* turns;
+    uint32_t turnNum;
+};
+
+/**
+ * Waits until sem is posted. A failed wait, e.g. sem_wait interrupted by a signal handler
+ * with EINTR, has not consumed a post and is retried.
+ */
+static void WaitPosted(GraphicSemaphore& sem)
+{
+    while (!sem.Wait()) {
+    }
+}
+
+/**
+ * Set while the thread sweeps bands, as the caller of SweepScanlineParallel or as a pool worker.
+ * A render callback which starts another parallel sweep would wait for the pool it runs on,
+ * that nested sweep runs serially instead.
  */
-bool RasterizerScanlineAntialias::SweepScanline(GeometryScanline& sl)
+static thread_local bool g_sweepingBands = false;
+
+static void SweepBands(SweepBandContext* ctx)
 {
+    bool sweeping = g_sweepingBands;
+    g_sweepingBands = true;
+    const RasterizerScanlineAntialias* ras = ctx->rasterizer;
+    GeometryScanline sl;
+    sl.Reset(ras->GetMinX(), ras->GetMaxX());
     while (true) {
-        if (scanY_ > outline_.GetMaxY()) {
-            return false;
+        uint32_t band = HalAtomicAddAndFetch32(&ctx->nextBand, 1) - 1;
+        if (band >= ctx->bandNum) {
+            break;
         }
-        sl.ResetSpans();
-        uint32_t numCells = outline_.GetScanlineNumCells(scanY_);
-        const CellBuildAntiAlias * const *cells = outline_.GetScanlineCells(scanY_);
-        int32_t cover = 0;
-
-        while (numCells) {
-            const CellBuildAntiAlias* curCell = *cells;
-            int32_t x = curCell->x;
-            int32_t area = curCell->area;
-            uint32_t alpha;
-
-            cover += curCell->cover;
-            // accumulate all cells with the same X
-            while (--numCells && (curCell = *++cells) && (curCell->x == x)) {
-                area += curCell->area;
-                cover += curCell->cover;
+        int32_t y = ras->GetMinY() + static_cast<int32_t>(band) * ctx->bandHeight;
+        int32_t yEnd = MATH_MIN(y + ctx->bandHeight - 1, ras->GetMaxY());
+        bool myTurn = !ctx->ordered;
+        for (; y <= yEnd; y++) {
+            if (!ras->SweepScanline(sl, y)) {
+                continue;
             }
-            if (area) {
-                // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
-                // Cover can be understood as a delta mask with an area of 1
-                alpha = CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
-                if (alpha) {
-                    sl.AddCell(x, alpha);
-                }
-                x++;
+            if (!myTurn) {
+                WaitPosted(ctx->turns[band % ctx->turnNum]);
+                myTurn = true;
             }
-            if (numCells && curCell->x > x) {
-                // At this time, area is 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
-                alpha = CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
-                if (alpha) {
-                    sl.AddSpan(x, curCell->x - x, alpha);
-                }
+            ctx->render(sl, ctx->param);
+        }
+        if (ctx->ordered) {
+            if (!myTurn) {
+                WaitPosted(ctx->turns[band % ctx->turnNum]);
             }
+            ctx->turns[(band + 1) % ctx->turnNum].Notify();
         }
+    }
+    g_sweepingBands = sweeping;
+}
 
-        if (sl.NumSpans()) {
-            break;
+/**
+ * Worker threads of SweepScanlineParallel, created on first use and kept for the process.
+ * One parallel sweep runs at a time, the workers wait on start_ between sweeps.
+ */
+class SweepWorkerPool {
+public:
+    static SweepWorkerPool* GetInstance()
+    {
+        /* Never destroyed: the detached workers keep waiting on its semaphores. */
+        static SweepWorkerPool* instance = new SweepWorkerPool();
+        return instance;
+    }
+
+    /**
+     * Runs SweepBands on up to helperNum workers and the calling thread, returns when all of them are done.
+     */
+    void Run(SweepBandContext* ctx, uint32_t helperNum)
+    {
+        mutex_.Lock();
+        helperNum = StartWorkers(helperNum);
+        job_ = ctx;
+        for (uint32_t i = 0; i < helperNum; i++) {
+            start_.Notify();
         }
-        ++scanY_;
+        // the calling thread is a worker too, it also finishes the bands when no worker could be started
+        SweepBands(ctx);
+        for (uint32_t i = 0; i < helperNum; i++) {
+            WaitPosted(finished_);
+        }
+        job_ = nullptr;
+        mutex_.Unlock();
     }
 
-    sl.Finalize(scanY_);
-    ++scanY_;
+private:
+    SweepWorkerPool() : job_(nullptr), workerNum_(0) {}
+
+    uint32_t StartWorkers(uint32_t helperNum)
+    {
+#if defined __linux__ || defined __LITEOS__ || defined __APPLE__
+        while (workerNum_ < helperNum) {
+            if (ThreadCreate(WorkerTask, this, nullptr) == nullptr) {
+                GRAPHIC_LOGE("SweepWorkerPool::StartWorkers thread create fail");
+                break;
+            }
+            workerNum_++;
+        }
+#endif
+        return MATH_MIN(helperNum, workerNum_);
+    }
+
+#if defined __linux__ || defined __LITEOS__ || defined __APPLE__
+    static void* WorkerTask(void* argv)
+    {
+        SweepWorkerPool* pool = static_cast<SweepWorkerPool*>(argv);
+        /* Never leaves the loop: Run counts this thread in workerNum_ and waits for its finished_ post. */
+        while (true) {
+            WaitPosted(pool->start_);
+            SweepBands(pool->job_);
+            pool->finished_.Notify();
+        }
+        return nullptr;
+    }
+#endif
+
+    GraphicMutex mutex_;
+    GraphicSemaphore start_;
+    GraphicSemaphore finished_;
+    SweepBandContext* volatile job_;
+    uint32_t workerNum_;
+};
+
+bool RasterizerScanlineAntialias::SweepScanlineParallel(ScanlineRender render, void* param)
+{
+    if (render == nullptr || !RewindScanlines()) {
+        return false;
+    }
+    SweepBandContext ctx;
+    ctx.rasterizer = this;
+    ctx.render = render;
+    ctx.param = param;
+    ctx.bandHeight = sweepBandHeight_;
+    ctx.bandNum = static_cast<uint32_t>((GetMaxY() - GetMinY()) / sweepBandHeight_ + 1);
+    ctx.ordered = sweepOrdered_;
+    ctx.nextBand = 0;
+
+    uint32_t threadNum = (sweepThreadNum_ == 0) ? HalGetCpuCoreNum() : sweepThreadNum_;
+    threadNum = MATH_MIN(MATH_MIN(threadNum, SWEEP_MAX_THREAD), ctx.bandNum);
+    if (threadNum <= 1 || outline_.GetBandHeight() > 0 || g_sweepingBands) {
+        GeometryScanline sl;
+        sl.Reset(GetMinX(), GetMaxX());
+        while (SweepScanline(sl)) {
+            render(sl, param);
+        }
+        return true;
+    }
+    GraphicSemaphore turns[SWEEP_MAX_THREAD];
+    ctx.turns = turns;
+    ctx.turnNum = threadNum;
+    turns[0].Notify();
+    SweepWorkerPool::GetInstance()->Run(&ctx, threadNum - 1);
+    scanY_ = GetMaxY() + 1;
     return true;
 }
 
@@ -115,6 +233,12 @@ void RasterizerScanlineAntialias::ClipBox(float x1, float y1, float x2, float y2
                      RasterDepictInt::UpScale(x2), RasterDepictInt::UpScale(y2));
 }
 
+void RasterizerScanlineAntialias::ClipRegion(const Rect* rects, uint32_t rectNum)
+{
+    Reset();
+    clipper_.ClipRegion(rects, rectNum);
+}
+
 void RasterizerScanlineAntialias::ResetClipping()
 {
     Reset();
@@ -178,6 +302,13 @@ void RasterizerScanlineAntialias::AddVertex(float x, float y, uint32_t cmd)
     }
 }
 
+void RasterizerScanlineAntialias::AddVertices(const PathVertex* vertices, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        AddVertex(vertices[i].x, vertices[i].y, vertices[i].cmd);
+    }
+}
+
 void RasterizerScanlineAntialias::Sort()
 {
     if (autoClose_) {
@@ -192,7 +323,7 @@ bool RasterizerScanlineAntialias::RewindScanlines()
         ClosePolygon();
     }
     outline_.SortAllCells();
-    if (outline_.GetTotalCells() == 0) {
+    if (outline_.IsEmpty()) {
         return false;
     }
     scanY_ = outline_.GetMinY();
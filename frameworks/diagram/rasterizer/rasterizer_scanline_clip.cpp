@@ -16,6 +16,188 @@
 #include "gfx_utils/diagram/rasterizer/rasterizer_scanline_clip.h"
 
 namespace OHOS {
+namespace {
+void SortRows(int32_t* rows, uint32_t rowNum)
+{
+    for (uint32_t i = 1; i < rowNum; i++) {
+        int32_t row = rows[i];
+        uint32_t j = i;
+        for (; j > 0 && rows[j - 1] > row; j--) {
+            rows[j] = rows[j - 1];
+        }
+        rows[j] = row;
+    }
+}
+
+/* Sorts the intervals by left and merges the overlapping and touching ones, returns the new number. */
+uint32_t MergeSpans(ClipRegionSpan* spans, uint32_t spanNum)
+{
+    for (uint32_t i = 1; i < spanNum; i++) {
+        ClipRegionSpan span = spans[i];
+        uint32_t j = i;
+        for (; j > 0 && spans[j - 1].left > span.left; j--) {
+            spans[j] = spans[j - 1];
+        }
+        spans[j] = span;
+    }
+    uint32_t merged = 0;
+    for (uint32_t i = 1; i < spanNum; i++) {
+        if (spans[i].left <= spans[merged].right) {
+            spans[merged].right = MATH_MAX(spans[merged].right, spans[i].right);
+        } else {
+            spans[++merged] = spans[i];
+        }
+    }
+    return merged + 1;
+}
+
+bool SameSpans(const ClipRegionSpan* spans, const ClipRegionSpan* other, uint32_t spanNum)
+{
+    for (uint32_t i = 0; i < spanNum; i++) {
+        if (spans[i].left != other[i].left || spans[i].right != other[i].right) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Collects the merged X intervals of the rectangles covering the rows from top to bottom, returns their number. */
+uint32_t CollectBandSpans(const Rect* rects, uint32_t rectNum, int32_t top, int32_t bottom, ClipRegionSpan* spans)
+{
+    uint32_t num = 0;
+    for (uint32_t i = 0; i < rectNum; i++) {
+        const Rect& rect = rects[i];
+        if (rect.GetLeft() <= rect.GetRight() && rect.GetTop() <= top && rect.GetBottom() + 1 >= bottom) {
+            spans[num].left = rect.GetLeft();
+            spans[num].right = rect.GetRight() + 1;
+            num++;
+        }
+    }
+    return (num == 0) ? 0 : MergeSpans(spans, num);
+}
+
+/*
+ * Walks the bands between the sorted unique rows and joins neighbouring bands with the same intervals.
+ * Counts the bands and their intervals, and stores them too when bands and spans are given.
+ * scratch holds 2 * rectNum intervals: the ones of the current band and the ones of the last band.
+ */
+void SweepRegionBands(const Rect* rects, uint32_t rectNum, const int32_t* rows, uint32_t rowNum,
+                      ClipRegionSpan* scratch, ClipRegionBand* bands, ClipRegionSpan* spans,
+                      uint32_t& bandNum, uint32_t& spanNum)
+{
+    ClipRegionSpan* current = scratch;
+    ClipRegionSpan* last = scratch + rectNum;
+    int32_t lastBottom = 0;
+    uint32_t lastNum = 0;
+    bandNum = 0;
+    spanNum = 0;
+    for (uint32_t r = 0; r + 1 < rowNum; r++) {
+        int32_t top = rows[r];
+        int32_t bottom = rows[r + 1];
+        uint32_t num = CollectBandSpans(rects, rectNum, top, bottom, current);
+        if (num == 0) {
+            continue;
+        }
+        if (bandNum > 0 && lastBottom == top && lastNum == num && SameSpans(last, current, num)) {
+            lastBottom = bottom;
+            if (bands != nullptr) {
+                bands[bandNum - 1].bottom = bottom;
+            }
+            continue;
+        }
+        if (bands != nullptr) {
+            ClipRegionBand& band = bands[bandNum];
+            band.top = top;
+            band.bottom = bottom;
+            band.spanStart = spanNum;
+            band.spanNum = num;
+            for (uint32_t i = 0; i < num; i++) {
+                spans[spanNum + i] = current[i];
+            }
+        }
+        bandNum++;
+        spanNum += num;
+        lastBottom = bottom;
+        lastNum = num;
+        ClipRegionSpan* swap = current;
+        current = last;
+        last = swap;
+    }
+}
+} // namespace
+
+/**
+ * @brief Cuts the rectangles at every top and bottom into bands of rows, collects the merged X intervals
+ * of the rectangles over each band and joins neighbouring bands with the same intervals.
+ * The bands are counted first so that the storage holds the merged intervals only.
+ * When memory runs out the region is left empty and clips everything.
+ * @since 1.0
+ * @version 1.0
+ */
+void RasterizerScanlineClip::ClipRegion(const Rect* rects, uint32_t rectNum)
+{
+    clipping_ = true;
+    hasRegion_ = true;
+    bandNum_ = 0;
+    clipBox_ = Rect32(0, 0, 0, 0);
+    if (rects == nullptr || rectNum == 0) {
+        return;
+    }
+    if (rectNum > UINT32_MAX / 2) { // 2: two rows and two scratch intervals per rectangle
+        GRAPHIC_LOGE("RasterizerScanlineClip::ClipRegion too many rectangles");
+        return;
+    }
+    GeometryPlainDataArray<int32_t> rows(rectNum * 2); // 2: top and bottom of every rectangle
+    GeometryPlainDataArray<ClipRegionSpan> scratch(rectNum * 2); // 2: the current and the last band
+    if (rows.Data() == nullptr || scratch.Data() == nullptr) {
+        GRAPHIC_LOGE("RasterizerScanlineClip::ClipRegion alloc fail");
+        return;
+    }
+    uint32_t rowNum = 0;
+    for (uint32_t i = 0; i < rectNum; i++) {
+        if (rects[i].GetLeft() <= rects[i].GetRight() && rects[i].GetTop() <= rects[i].GetBottom()) {
+            rows[rowNum++] = rects[i].GetTop();
+            rows[rowNum++] = rects[i].GetBottom() + 1;
+        }
+    }
+    if (rowNum == 0) {
+        return;
+    }
+    SortRows(rows.Data(), rowNum);
+    uint32_t uniqueNum = 1;
+    for (uint32_t i = 1; i < rowNum; i++) {
+        if (rows[i] != rows[uniqueNum - 1]) {
+            rows[uniqueNum++] = rows[i];
+        }
+    }
+    rowNum = uniqueNum;
+    uint32_t bandNum;
+    uint32_t spanNum;
+    SweepRegionBands(rects, rectNum, rows.Data(), rowNum, scratch.Data(), nullptr, nullptr, bandNum, spanNum);
+    if (bands_.GetSize() < bandNum) {
+        bands_.Resize(bandNum);
+    }
+    if (spans_.GetSize() < spanNum) {
+        spans_.Resize(spanNum);
+    }
+    if (bands_.Data() == nullptr || spans_.Data() == nullptr) {
+        GRAPHIC_LOGE("RasterizerScanlineClip::ClipRegion alloc fail");
+        return;
+    }
+    SweepRegionBands(rects, rectNum, rows.Data(), rowNum, scratch.Data(), bands_.Data(), spans_.Data(),
+                     bandNum, spanNum);
+    int32_t left = INT32_MAX;
+    int32_t right = INT32_MIN;
+    for (uint32_t i = 0; i < bandNum; i++) {
+        const ClipRegionSpan* spans = GetRegionSpans(bands_[i]);
+        left = MATH_MIN(left, spans[0].left);
+        right = MATH_MAX(right, spans[bands_[i].spanNum - 1].right);
+    }
+    bandNum_ = bandNum;
+    clipBox_ = Rect32(left * POLY_SUBPIXEL_SCALE, bands_[0].top * POLY_SUBPIXEL_SCALE,
+                      right * POLY_SUBPIXEL_SCALE, bands_[bandNum_ - 1].bottom * POLY_SUBPIXEL_SCALE);
+}
+
 /**
  * @brief In the RASTERIZER process,Judge the mark according to the last clipping range
  * And the cutting range judgment flag this time,
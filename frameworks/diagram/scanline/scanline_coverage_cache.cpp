@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_coverage_cache.h"
+
+#include <cmath>
+
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/mem_api.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace {
+const uint8_t BITS_PER_BYTE = 8;
+const uint8_t BYTES_PER_WORD = 4;
+/* Translations are split in 24.8 fixed point, larger ones are clamped. */
+const float MAX_SUBPIXEL_TRANSLATION = 1073741824.0f;
+} // namespace
+
+/**
+ * Header of a cached entry, the recorded scanlines follow it in the same allocation.
+ */
+struct CoverageCacheEntry {
+    CoverageCacheEntry* prev;
+    CoverageCacheEntry* next;
+    CoverageCacheEntry* hashNext;
+    CoverageCacheKey key;
+    uint32_t bytes;
+    uint32_t size;
+};
+
+ScanlineCoverageCache::ScanlineCoverageCache(uint32_t memoryLimit)
+    : head_(nullptr), tail_(nullptr), scratch_(nullptr), scratchCapacity_(0), memoryLimit_(memoryLimit),
+      memoryUsage_(0), entryCount_(0), hitCount_(0), missCount_(0)
+{
+    for (uint32_t i = 0; i < SCANLINE_COVERAGE_CACHE_BUCKETS; i++) {
+        buckets_[i] = nullptr;
+    }
+}
+
+ScanlineCoverageCache::~ScanlineCoverageCache()
+{
+    Clear();
+    UIFree(scratch_);
+}
+
+uint32_t ScanlineCoverageCache::HashWord(uint32_t hash, uint32_t word)
+{
+    for (uint8_t i = 0; i < BYTES_PER_WORD; i++) {
+        hash = (hash ^ ((word >> (i * BITS_PER_BYTE)) & 0xFF)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint32_t ScanlineCoverageCache::FloatBits(float value)
+{
+    uint32_t bits = 0;
+    /* -0.0f and 0.0f transform alike */
+    if (value != 0 && memcpy_s(&bits, sizeof(bits), &value, sizeof(value)) != EOK) {
+        bits = 0;
+    }
+    return bits;
+}
+
+CoverageCacheKey ScanlineCoverageCache::MakeKey(uint32_t pathHash, const TransAffine& transform, FillingRule rule,
+                                                TransAffine& local, int32_t& offsetX, int32_t& offsetY)
+{
+    const float* data = transform.GetData();
+    float subX = MATH_MIN(MATH_MAX(data[2] * POLY_SUBPIXEL_SCALE, -MAX_SUBPIXEL_TRANSLATION), // 2: x translation
+                          MAX_SUBPIXEL_TRANSLATION);
+    float subY = MATH_MIN(MATH_MAX(data[5] * POLY_SUBPIXEL_SCALE, -MAX_SUBPIXEL_TRANSLATION), // 5: y translation
+                          MAX_SUBPIXEL_TRANSLATION);
+    int32_t translateX = static_cast<int32_t>(std::floor(subX + 0.5f));
+    int32_t translateY = static_cast<int32_t>(std::floor(subY + 0.5f));
+
+    CoverageCacheKey key;
+    key.pathHash = pathHash;
+    key.matrix[0] = FloatBits(data[0]);
+    key.matrix[1] = FloatBits(data[1]);
+    key.matrix[2] = FloatBits(data[3]); // 2: shear y, 3: its index
+    key.matrix[3] = FloatBits(data[4]); // 3: scale y, 4: its index
+    key.fracX = translateX & POLY_SUBPIXEL_MASK;
+    key.fracY = translateY & POLY_SUBPIXEL_MASK;
+    key.rule = static_cast<uint32_t>(rule);
+    uint32_t hash = HashWord(FNV_OFFSET_BASIS, key.pathHash);
+    for (uint32_t i = 0; i < 4; i++) { // 4: matrix words
+        hash = HashWord(hash, key.matrix[i]);
+    }
+    hash = HashWord(hash, (key.fracX << BITS_PER_BYTE * 2) | (key.fracY << BITS_PER_BYTE) | key.rule); // 2: bytes
+    key.hash = hash;
+
+    offsetX = translateX >> POLY_SUBPIXEL_SHIFT;
+    offsetY = translateY >> POLY_SUBPIXEL_SHIFT;
+    local = transform;
+    local.SetData(2, static_cast<float>(key.fracX) / POLY_SUBPIXEL_SCALE); // 2: x translation
+    local.SetData(5, static_cast<float>(key.fracY) / POLY_SUBPIXEL_SCALE); // 5: y translation
+    return key;
+}
+
+bool ScanlineCoverageCache::Match(const CoverageCacheKey& key1, const CoverageCacheKey& key2)
+{
+    return key1.hash == key2.hash && key1.pathHash == key2.pathHash && key1.matrix[0] == key2.matrix[0] &&
+           key1.matrix[1] == key2.matrix[1] && key1.matrix[2] == key2.matrix[2] && // 2: shear y
+           key1.matrix[3] == key2.matrix[3] && key1.fracX == key2.fracX && // 3: scale y
+           key1.fracY == key2.fracY && key1.rule == key2.rule;
+}
+
+CoverageCacheData ScanlineCoverageCache::Find(const CoverageCacheKey& key)
+{
+    CoverageCacheData coverage = {nullptr, 0};
+    CoverageCacheEntry* entry = buckets_[key.hash % SCANLINE_COVERAGE_CACHE_BUCKETS];
+    for (; entry != nullptr; entry = entry->hashNext) {
+        if (Match(entry->key, key)) {
+            hitCount_++;
+            Unlink(entry);
+            PushFront(entry);
+            coverage.data = reinterpret_cast<const uint8_t*>(entry + 1);
+            coverage.size = entry->size;
+            return coverage;
+        }
+    }
+    missCount_++;
+    return coverage;
+}
+
+bool ScanlineCoverageCache::ReserveScratch(uint32_t size)
+{
+    if (size <= scratchCapacity_) {
+        return true;
+    }
+    uint32_t capacity = MATH_MAX(size, scratchCapacity_ * 2); // 2: double
+    uint8_t* scratch = static_cast<uint8_t*>(UIMalloc(capacity));
+    if (scratch == nullptr) {
+        GRAPHIC_LOGE("ScanlineCoverageCache::ReserveScratch alloc fail");
+        return false;
+    }
+    if (scratchCapacity_ > 0 && memcpy_s(scratch, capacity, scratch_, scratchCapacity_) != EOK) {
+        UIFree(scratch);
+        GRAPHIC_LOGE("ScanlineCoverageCache::ReserveScratch memcpy_s fail");
+        return false;
+    }
+    UIFree(scratch_);
+    scratch_ = scratch;
+    scratchCapacity_ = capacity;
+    return true;
+}
+
+bool ScanlineCoverageCache::AppendScanline(uint32_t& size, const GeometryScanlineSparse& sl)
+{
+    uint32_t numSpans = sl.NumSpans();
+    GeometryScanlineSparse::ConstIterator span = sl.Begin();
+    uint32_t rowBytes = sizeof(CoverageCacheRow);
+    for (uint32_t i = 0; i < numSpans; i++) {
+        rowBytes += sizeof(CoverageCacheSpan) + GetCoverBytes(span[i].spanLength);
+    }
+    if (!ReserveScratch(size + rowBytes)) {
+        return false;
+    }
+    uint8_t* ptr = scratch_ + size;
+    CoverageCacheRow* row = reinterpret_cast<CoverageCacheRow*>(ptr);
+    row->y = sl.GetYLevel();
+    row->numSpans = numSpans;
+    ptr += sizeof(CoverageCacheRow);
+    for (uint32_t i = 0; i < numSpans; i++, span++) {
+        CoverageCacheSpan* cached = reinterpret_cast<CoverageCacheSpan*>(ptr);
+        cached->x = span->x;
+        cached->spanLength = span->spanLength;
+        ptr += sizeof(CoverageCacheSpan);
+        uint32_t coverBytes = GetCoverBytes(span->spanLength);
+        uint32_t coverNum = (span->spanLength > 0) ? static_cast<uint32_t>(span->spanLength) : 1;
+        if (memcpy_s(ptr, coverBytes, span->covers, coverNum) != EOK) {
+            GRAPHIC_LOGE("ScanlineCoverageCache::AppendScanline memcpy_s fail");
+            return false;
+        }
+        ptr += coverBytes;
+    }
+    size += rowBytes;
+    return true;
+}
+
+CoverageCacheData ScanlineCoverageCache::Record(const CoverageCacheKey& key, RasterizerScanlineAntialias& ras)
+{
+    CoverageCacheData coverage = {nullptr, 0};
+    uint32_t size = 0;
+    if (ras.RewindScanlines()) {
+        sl_.Reset(ras.GetMinX(), ras.GetMaxX());
+        while (ras.SweepScanline(sl_)) {
+            if (!AppendScanline(size, sl_)) {
+                return coverage;
+            }
+        }
+    }
+    coverage.data = scratch_;
+    coverage.size = size;
+
+    /* A key recorded twice replaces the old entry */
+    CoverageCacheEntry* entry = buckets_[key.hash % SCANLINE_COVERAGE_CACHE_BUCKETS];
+    for (; entry != nullptr; entry = entry->hashNext) {
+        if (Match(entry->key, key)) {
+            Free(entry);
+            break;
+        }
+    }
+    uint32_t bytes = sizeof(CoverageCacheEntry) + size;
+    if (bytes > memoryLimit_) {
+        return coverage;
+    }
+    Trim(memoryLimit_ - bytes);
+    entry = static_cast<CoverageCacheEntry*>(UIMalloc(bytes));
+    if (entry == nullptr) {
+        GRAPHIC_LOGE("ScanlineCoverageCache::Record alloc fail");
+        return coverage;
+    }
+    if (size > 0 && memcpy_s(entry + 1, size, scratch_, size) != EOK) {
+        UIFree(entry);
+        GRAPHIC_LOGE("ScanlineCoverageCache::Record memcpy_s fail");
+        return coverage;
+    }
+    entry->key = key;
+    entry->bytes = bytes;
+    entry->size = size;
+    CoverageCacheEntry*& bucket = buckets_[key.hash % SCANLINE_COVERAGE_CACHE_BUCKETS];
+    entry->hashNext = bucket;
+    bucket = entry;
+    PushFront(entry);
+    memoryUsage_ += bytes;
+    entryCount_++;
+    coverage.data = reinterpret_cast<const uint8_t*>(entry + 1);
+    return coverage;
+}
+
+void ScanlineCoverageCache::SetMemoryLimit(uint32_t bytes)
+{
+    memoryLimit_ = bytes;
+    Trim(memoryLimit_);
+}
+
+void ScanlineCoverageCache::Clear()
+{
+    while (head_ != nullptr) {
+        Free(head_);
+    }
+}
+
+void ScanlineCoverageCache::Unlink(CoverageCacheEntry* entry)
+{
+    if (entry->prev != nullptr) {
+        entry->prev->next = entry->next;
+    } else {
+        head_ = entry->next;
+    }
+    if (entry->next != nullptr) {
+        entry->next->prev = entry->prev;
+    } else {
+        tail_ = entry->prev;
+    }
+}
+
+void ScanlineCoverageCache::PushFront(CoverageCacheEntry* entry)
+{
+    entry->prev = nullptr;
+    entry->next = head_;
+    if (head_ != nullptr) {
+        head_->prev = entry;
+    } else {
+        tail_ = entry;
+    }
+    head_ = entry;
+}
+
+void ScanlineCoverageCache::Free(CoverageCacheEntry* entry)
+{
+    Unlink(entry);
+    CoverageCacheEntry** link = &buckets_[entry->key.hash % SCANLINE_COVERAGE_CACHE_BUCKETS];
+    while (*link != entry) {
+        link = &(*link)->hashNext;
+    }
+    *link = entry->hashNext;
+    memoryUsage_ -= entry->bytes;
+    entryCount_--;
+    UIFree(entry);
+}
+
+/**
+ * @brief Evicts entries from the least recently used end until the usage fits the limit.
+ */
+void ScanlineCoverageCache::Trim(uint32_t limit)
+{
+    while (tail_ != nullptr && memoryUsage_ > limit) {
+        Free(tail_);
+    }
+}
+} // namespace OHOS
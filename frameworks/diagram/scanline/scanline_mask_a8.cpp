@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_mask_a8.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/mem_api.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace {
+const int32_t ARGB_BYTES = 4;
+const int32_t MASK_ROW_ALIGN = 4;
+/* Mask bytes tested at once when skipping transparent runs */
+const int32_t MASK_SKIP_BYTES = 4;
+/* Largest own buffer, bounds above it are refused instead of wrapping the size */
+const uint64_t MASK_MAX_BYTES = 0x4000000;
+
+inline void BlendPixel(Color32* dst, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+    dst->red = Rgba8T::Lerp(dst->red, red, alpha);
+    dst->green = Rgba8T::Lerp(dst->green, green, alpha);
+    dst->blue = Rgba8T::Lerp(dst->blue, blue, alpha);
+    dst->alpha = Rgba8T::Prelerp(dst->alpha, alpha, alpha);
+}
+
+inline bool IsTransparentRun(const uint8_t* mask)
+{
+    return (mask[0] | mask[1] | mask[2] | mask[3]) == 0; // 2, 3: bytes of the run
+}
+} // namespace
+
+ScanlineMaskA8::~ScanlineMaskA8()
+{
+    UIFree(ownBuffer_);
+}
+
+void ScanlineMaskA8::Attach(uint8_t* buffer, int32_t width, int32_t height, int32_t stride,
+                            int32_t originX, int32_t originY)
+{
+    attached_ = (buffer != nullptr);
+    buffer_ = buffer;
+    width_ = attached_ ? width : 0;
+    height_ = attached_ ? height : 0;
+    stride_ = attached_ ? stride : 0;
+    originX_ = originX;
+    originY_ = originY;
+}
+
+void ScanlineMaskA8::Detach()
+{
+    attached_ = false;
+    buffer_ = nullptr;
+    width_ = 0;
+    height_ = 0;
+    stride_ = 0;
+}
+
+bool ScanlineMaskA8::Allocate(int32_t width, int32_t height)
+{
+    buffer_ = nullptr;
+    width_ = 0;
+    height_ = 0;
+    stride_ = 0;
+    if (width <= 0 || height <= 0) {
+        GRAPHIC_LOGE("ScanlineMaskA8::Allocate invalid size");
+        return false;
+    }
+    uint64_t stride = (static_cast<uint64_t>(width) + MASK_ROW_ALIGN - 1) & ~static_cast<uint64_t>(MASK_ROW_ALIGN - 1);
+    uint64_t size = stride * static_cast<uint64_t>(height);
+    if (size > MASK_MAX_BYTES) {
+        GRAPHIC_LOGE("ScanlineMaskA8::Allocate size too large");
+        return false;
+    }
+    if (size > capacity_) {
+        UIFree(ownBuffer_);
+        ownBuffer_ = static_cast<uint8_t*>(UIMalloc(static_cast<uint32_t>(size)));
+        if (ownBuffer_ == nullptr) {
+            GRAPHIC_LOGE("ScanlineMaskA8::Allocate alloc fail");
+            capacity_ = 0;
+            return false;
+        }
+        capacity_ = static_cast<uint32_t>(size);
+    }
+    buffer_ = ownBuffer_;
+    width_ = width;
+    height_ = height;
+    stride_ = static_cast<int32_t>(stride);
+    return true;
+}
+
+void ScanlineMaskA8::Clear()
+{
+    for (int32_t y = 0; y < height_; y++) {
+        if (memset_s(buffer_ + static_cast<size_t>(y) * stride_, width_, 0, width_) != EOK) {
+            GRAPHIC_LOGE("ScanlineMaskA8::Clear memset_s fail");
+            return;
+        }
+    }
+}
+
+bool ScanlineMaskA8::Render(RasterizerScanlineAntialias& ras)
+{
+    if (!ras.RewindScanlines()) {
+        if (!attached_) {
+            width_ = 0;
+            height_ = 0;
+        }
+        Clear();
+        return false;
+    }
+    if (!attached_) {
+        originX_ = ras.GetMinX();
+        originY_ = ras.GetMinY();
+        if (!Allocate(ras.GetMaxX() - ras.GetMinX() + 1, ras.GetMaxY() - ras.GetMinY() + 1)) {
+            return false;
+        }
+    }
+    Clear();
+    sl_.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl_)) {
+        int32_t y = sl_.GetYLevel() - originY_;
+        if (y < 0 || y >= height_) {
+            continue;
+        }
+        uint8_t* row = buffer_ + static_cast<size_t>(y) * stride_;
+        uint32_t numSpans = sl_.NumSpans();
+        GeometryScanlineSparse::ConstIterator span = sl_.Begin();
+        for (; numSpans > 0; --numSpans, ++span) {
+            int32_t x = span->x - originX_;
+            int32_t len = (span->spanLength > 0) ? span->spanLength : -span->spanLength;
+            int32_t skip = (x < 0) ? -x : 0;
+            x += skip;
+            len = MATH_MIN(len - skip, width_ - x);
+            if (len <= 0) {
+                continue;
+            }
+            if (span->spanLength > 0) {
+                if (memcpy_s(row + x, width_ - x, span->covers + skip, len) != EOK) {
+                    GRAPHIC_LOGE("ScanlineMaskA8::Render memcpy_s fail");
+                }
+            } else if (memset_s(row + x, width_ - x, *span->covers, len) != EOK) {
+                GRAPHIC_LOGE("ScanlineMaskA8::Render memset_s fail");
+            }
+        }
+    }
+    return true;
+}
+
+bool ScanlineMaskA8::Clip(int32_t dstWidth, int32_t dstHeight, int32_t offsetX, int32_t offsetY,
+                          int32_t& left, int32_t& top, int32_t& right, int32_t& bottom) const
+{
+    left = MATH_MAX(originX_ + offsetX, 0);
+    top = MATH_MAX(originY_ + offsetY, 0);
+    right = MATH_MIN(originX_ + offsetX + width_, dstWidth);
+    bottom = MATH_MIN(originY_ + offsetY + height_, dstHeight);
+    return buffer_ != nullptr && left < right && top < bottom;
+}
+
+void ScanlineMaskA8::BlendSolid(uint8_t* dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride,
+                                int32_t offsetX, int32_t offsetY, const Rgba8T& color) const
+{
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+    if (dst == nullptr || color.alpha == 0 ||
+        !Clip(dstWidth, dstHeight, offsetX, offsetY, left, top, right, bottom)) {
+        return;
+    }
+    Color32 fill;
+    fill.red = color.red;
+    fill.green = color.green;
+    fill.blue = color.blue;
+    fill.alpha = OPA_OPAQUE;
+    int32_t len = right - left;
+    for (int32_t y = top; y < bottom; y++) {
+        const uint8_t* mask =
+            buffer_ + static_cast<size_t>(y - originY_ - offsetY) * stride_ + (left - originX_ - offsetX);
+        Color32* pixel = reinterpret_cast<Color32*>(dst + y * dstStride + left * ARGB_BYTES);
+        int32_t i = 0;
+        while (i < len) {
+            if (i + MASK_SKIP_BYTES <= len && IsTransparentRun(mask + i)) {
+                i += MASK_SKIP_BYTES;
+                continue;
+            }
+            uint8_t alpha = Rgba8T::Multiply(color.alpha, mask[i]);
+            if (alpha == OPA_OPAQUE) {
+                pixel[i].full = fill.full;
+            } else if (alpha != 0) {
+                BlendPixel(&pixel[i], color.red, color.green, color.blue, alpha);
+            }
+            i++;
+        }
+    }
+}
+
+void ScanlineMaskA8::BlendARGB8888(uint8_t* dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride,
+                                   const uint8_t* src, int32_t srcStride, int32_t offsetX, int32_t offsetY) const
+{
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+    if (dst == nullptr || src == nullptr || !Clip(dstWidth, dstHeight, offsetX, offsetY, left, top, right, bottom)) {
+        return;
+    }
+    int32_t len = right - left;
+    for (int32_t y = top; y < bottom; y++) {
+        const uint8_t* mask =
+            buffer_ + static_cast<size_t>(y - originY_ - offsetY) * stride_ + (left - originX_ - offsetX);
+        Color32* pixel = reinterpret_cast<Color32*>(dst + y * dstStride + left * ARGB_BYTES);
+        const Color32* source = reinterpret_cast<const Color32*>(src + y * srcStride + left * ARGB_BYTES);
+        int32_t i = 0;
+        while (i < len) {
+            if (i + MASK_SKIP_BYTES <= len && IsTransparentRun(mask + i)) {
+                i += MASK_SKIP_BYTES;
+                continue;
+            }
+            uint8_t alpha = Rgba8T::Multiply(source[i].alpha, mask[i]);
+            if (alpha == OPA_OPAQUE) {
+                pixel[i].full = source[i].full;
+            } else if (alpha != 0) {
+                BlendPixel(&pixel[i], source[i].red, source[i].green, source[i].blue, alpha);
+            }
+            i++;
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+#include "gfx_utils/mem_api.h"
+#include "securec.h"
+
+namespace OHOS {
+#if GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+namespace {
+const uint32_t FNV_OFFSET_BASIS = 2166136261;
+const uint32_t FNV_PRIME = 16777619;
+const uint8_t BITS_PER_BYTE = 8;
+const uint8_t BYTES_PER_WORD = 4;
+
+uint32_t HashWord(uint32_t hash, uint32_t word)
+{
+    for (uint8_t i = 0; i < BYTES_PER_WORD; i++) {
+        hash = (hash ^ ((word >> (i * BITS_PER_BYTE)) & 0xFF)) * FNV_PRIME;
+    }
+    return hash;
+}
+} // namespace
+
+/**
+ * Header of a cached table, the stop list and the colors follow it in the same allocation.
+ */
+struct GradientLutTable {
+    GradientLutTable* prev;
+    GradientLutTable* next;
+    GradientColorPoint* points;
+    Rgba8T* colors;
+    uint32_t hash;
+    uint32_t bytes;
+    int32_t refCount;
+    uint16_t pointNum;
+    uint16_t lutSize;
+};
+
+GradientLutCache* GradientLutCache::GetInstance()
+{
+    /* Never destroyed: static FillGradientLut objects may release their tables during process exit. */
+    static GradientLutCache* instance = new GradientLutCache();
+    return instance;
+}
+
+const Rgba8T* GradientLutCache::GetEmptyColors()
+{
+    static Rgba8T emptyColors[COLOR_LUT_SIZE];
+    return emptyColors;
+}
+
+const Rgba8T* GradientLutCache::GetColors(const GradientLutTable* table)
+{
+    return table->colors;
+}
+
+uint32_t GradientLutCache::Hash(const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize)
+{
+    uint32_t hash = HashWord(FNV_OFFSET_BASIS, lutSize);
+    for (uint16_t i = 0; i < pointNum; i++) {
+        uint32_t offset;
+        if (memcpy_s(&offset, sizeof(offset), &points[i].offset, sizeof(points[i].offset)) != EOK) {
+            offset = 0;
+        }
+        const Rgba8T& color = points[i].color;
+        hash = HashWord(hash, offset);
+        // 24, 16, 8: red, green and blue above alpha in one word
+        hash = HashWord(hash, (color.red << 24) | (color.green << 16) | (color.blue << 8) | color.alpha);
+    }
+    return hash;
+}
+
+bool GradientLutCache::Match(const GradientLutTable* table, uint32_t hash,
+                             const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize)
+{
+    if (table->hash != hash || table->pointNum != pointNum || table->lutSize != lutSize) {
+        return false;
+    }
+    for (uint16_t i = 0; i < pointNum; i++) {
+        const GradientColorPoint& point = table->points[i];
+        if (point.offset != points[i].offset || point.color.red != points[i].color.red ||
+            point.color.green != points[i].color.green || point.color.blue != points[i].color.blue ||
+            point.color.alpha != points[i].color.alpha) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Fills the color table from the sorted stop list, colors before the first stop and after the
+ * last stop take the color of that stop.
+ */
+void GradientLutCache::BuildColors(const GradientColorPoint* points, uint16_t pointNum,
+                                   Rgba8T* colors, uint16_t lutSize)
+{
+    uint32_t index;
+    uint32_t start = points[0].offset * lutSize;
+    uint32_t end = start;
+    Rgba8T color = points[0].color;
+    for (index = 0; index < start; index++) {
+        colors[index] = color;
+    }
+    for (index = 1; index < pointNum; index++) {
+        end = points[index].offset * lutSize;
+        ColorInterpolator ci(points[index - 1].color, points[index].color, end - start + 1);
+        while (start < end) {
+            colors[start] = ci.GetColor();
+            ++ci;
+            ++start;
+        }
+    }
+    color = points[pointNum - 1].color;
+    for (; end < lutSize; end++) {
+        colors[end] = color;
+    }
+}
+
+GradientLutTable* GradientLutCache::Acquire(const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize)
+{
+    if (points == nullptr || pointNum < 2 || lutSize == 0) { // 2: at least two stops make a gradient
+        return nullptr;
+    }
+    uint32_t hash = Hash(points, pointNum, lutSize);
+    mutex_.Lock();
+    for (GradientLutTable* table = head_; table != nullptr; table = table->next) {
+        if (Match(table, hash, points, pointNum, lutSize)) {
+            table->refCount++;
+            hitCount_++;
+            Unlink(table);
+            PushFront(table);
+            mutex_.Unlock();
+            return table;
+        }
+    }
+    missCount_++;
+    uint32_t pointBytes = pointNum * sizeof(GradientColorPoint);
+    uint32_t colorBytes = lutSize * sizeof(Rgba8T);
+    uint32_t bytes = sizeof(GradientLutTable) + pointBytes + colorBytes;
+    GradientLutTable* table = static_cast<GradientLutTable*>(UIMalloc(bytes));
+    if (table == nullptr) {
+        mutex_.Unlock();
+        GRAPHIC_LOGE("GradientLutCache::Acquire alloc fail");
+        return nullptr;
+    }
+    table->points = reinterpret_cast<GradientColorPoint*>(table + 1);
+    table->colors = reinterpret_cast<Rgba8T*>(table->points + pointNum);
+    if (memcpy_s(table->points, pointBytes, points, pointBytes) != EOK) {
+        mutex_.Unlock();
+        UIFree(table);
+        GRAPHIC_LOGE("GradientLutCache::Acquire memcpy_s fail");
+        return nullptr;
+    }
+    BuildColors(points, pointNum, table->colors, lutSize);
+    table->hash = hash;
+    table->bytes = bytes;
+    table->refCount = 1;
+    table->pointNum = pointNum;
+    table->lutSize = lutSize;
+    PushFront(table);
+    memoryUsage_ += bytes;
+    Trim();
+    mutex_.Unlock();
+    return table;
+}
+
+void GradientLutCache::AddRef(GradientLutTable* table)
+{
+    mutex_.Lock();
+    table->refCount++;
+    mutex_.Unlock();
+}
+
+void GradientLutCache::Release(GradientLutTable* table)
+{
+    mutex_.Lock();
+    table->refCount--;
+    if (table->refCount == 0) {
+        Trim();
+    }
+    mutex_.Unlock();
+}
+
+void GradientLutCache::SetMemoryLimit(uint32_t bytes)
+{
+    mutex_.Lock();
+    memoryLimit_ = bytes;
+    Trim();
+    mutex_.Unlock();
+}
+
+void GradientLutCache::ResetCounters()
+{
+    mutex_.Lock();
+    hitCount_ = 0;
+    missCount_ = 0;
+    mutex_.Unlock();
+}
+
+void GradientLutCache::Clear()
+{
+    mutex_.Lock();
+    GradientLutTable* table = head_;
+    while (table != nullptr) {
+        GradientLutTable* next = table->next;
+        if (table->refCount == 0) {
+            Free(table);
+        }
+        table = next;
+    }
+    mutex_.Unlock();
+}
+
+void GradientLutCache::Unlink(GradientLutTable* table)
+{
+    if (table->prev != nullptr) {
+        table->prev->next = table->next;
+    } else {
+        head_ = table->next;
+    }
+    if (table->next != nullptr) {
+        table->next->prev = table->prev;
+    } else {
+        tail_ = table->prev;
+    }
+}
+
+void GradientLutCache::PushFront(GradientLutTable* table)
+{
+    table->prev = nullptr;
+    table->next = head_;
+    if (head_ != nullptr) {
+        head_->prev = table;
+    } else {
+        tail_ = table;
+    }
+    head_ = table;
+}
+
+void GradientLutCache::Free(GradientLutTable* table)
+{
+    Unlink(table);
+    memoryUsage_ -= table->bytes;
+    UIFree(table);
+}
+
+/**
+ * @brief Evicts unreferenced tables from the least recently used end until the usage fits the limit.
+ */
+void GradientLutCache::Trim()
+{
+    GradientLutTable* table = tail_;
+    while (table != nullptr && memoryUsage_ > memoryLimit_) {
+        GradientLutTable* prev = table->prev;
+        if (table->refCount == 0) {
+            Free(table);
+        }
+        table = prev;
+    }
+}
+#endif
+} // namespace OHOS
@@ -196,5 +196,10 @@ uint32_t VertexGenerateDash::GenerateVertex(float* x, float* y)
     }
     return PATH_CMD_STOP;
 }
+
+uint32_t VertexGenerateDash::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
 #endif
 } // namespace OHOS
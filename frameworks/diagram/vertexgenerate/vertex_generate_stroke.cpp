@@ -111,6 +111,11 @@ uint32_t VertexGenerateStroke::GenerateVertex(float* x, float* y)
     return cmd;
 }
 
+uint32_t VertexGenerateStroke::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
+
 void VertexGenerateStroke::VertexReady(const uint32_t& verticesNum, uint32_t& cmd)
 {
     if (srcVertices_.Size() < verticesNum + uint32_t(closed_ != 0)) {
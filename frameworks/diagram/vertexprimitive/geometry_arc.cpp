@@ -57,6 +57,11 @@ uint32_t GeometryArc::GenerateVertex(float* x, float* y)
     return pf;
 }
 
+uint32_t GeometryArc::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
+
 void GeometryArc::Rewind(uint32_t)
 {
     pathCommand_ = PATH_CMD_MOVE_TO;
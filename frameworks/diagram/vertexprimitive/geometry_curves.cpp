@@ -120,6 +120,11 @@ uint32_t QuadBezierCurveIncr::GenerateVertex(float* x, float* y)
     return PATH_CMD_LINE_TO;
 }
 
+uint32_t QuadBezierCurveIncr::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
+
 void QuadrBezierCurveDividOp::Init(float x1, float y1,
                                    float x2, float y2,
                                    float x3, float y3)
@@ -334,6 +339,11 @@ uint32_t CubicBezierCurveIncrement::GenerateVertex(float* x, float* y)
     return PATH_CMD_LINE_TO;
 }
 
+uint32_t CubicBezierCurveIncrement::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateVerticesByVertex(*this, vertices, maxNum);
+}
+
 void CubicBezierCurveDividOperate::Init(float x1, float y1,
                                         float x2, float y2,
                                         float x3, float y3,
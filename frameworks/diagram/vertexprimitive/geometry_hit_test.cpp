@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_hit_test.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/mem_api.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace {
+const uint32_t MIN_EDGE_CAPACITY = 16;
+} // namespace
+
+GeometryHitTest::~GeometryHitTest()
+{
+    UIFree(edges_);
+}
+
+void GeometryHitTest::Reset()
+{
+    edgeNum_ = 0;
+    hasStart_ = false;
+    DropIndex();
+}
+
+void GeometryHitTest::DropIndex()
+{
+    bucketNum_ = 0;
+}
+
+void GeometryHitTest::AddEdge(float x1, float y1, float x2, float y2)
+{
+    if (y1 == y2) {
+        /* A horizontal edge never crosses the ray. */
+        return;
+    }
+    if (edgeNum_ == edgeCapacity_) {
+        uint32_t capacity = MATH_MAX(edgeCapacity_ * 2, MIN_EDGE_CAPACITY); // 2: double
+        HitEdge* edges = static_cast<HitEdge*>(UIMalloc(capacity * sizeof(HitEdge)));
+        if (edges == nullptr) {
+            GRAPHIC_LOGE("GeometryHitTest::AddEdge alloc fail");
+            return;
+        }
+        if (edgeNum_ > 0 &&
+            memcpy_s(edges, capacity * sizeof(HitEdge), edges_, edgeNum_ * sizeof(HitEdge)) != EOK) {
+            UIFree(edges);
+            GRAPHIC_LOGE("GeometryHitTest::AddEdge memcpy_s fail");
+            return;
+        }
+        UIFree(edges_);
+        edges_ = edges;
+        edgeCapacity_ = capacity;
+    }
+    if (edgeNum_ == 0) {
+        minX_ = MATH_MIN(x1, x2);
+        maxX_ = MATH_MAX(x1, x2);
+        minY_ = MATH_MIN(y1, y2);
+        maxY_ = MATH_MAX(y1, y2);
+    } else {
+        minX_ = MATH_MIN(minX_, MATH_MIN(x1, x2));
+        maxX_ = MATH_MAX(maxX_, MATH_MAX(x1, x2));
+        minY_ = MATH_MIN(minY_, MATH_MIN(y1, y2));
+        maxY_ = MATH_MAX(maxY_, MATH_MAX(y1, y2));
+    }
+    HitEdge& edge = edges_[edgeNum_++];
+    edge.x1 = x1;
+    edge.y1 = y1;
+    edge.x2 = x2;
+    edge.y2 = y2;
+    DropIndex();
+}
+
+void GeometryHitTest::MoveTo(float x, float y)
+{
+    ClosePolygon();
+    startX_ = lastX_ = x;
+    startY_ = lastY_ = y;
+    hasStart_ = true;
+}
+
+void GeometryHitTest::LineTo(float x, float y)
+{
+    if (!hasStart_) {
+        return;
+    }
+    AddEdge(lastX_, lastY_, x, y);
+    lastX_ = x;
+    lastY_ = y;
+}
+
+void GeometryHitTest::ClosePolygon()
+{
+    if (hasStart_) {
+        AddEdge(lastX_, lastY_, startX_, startY_);
+        hasStart_ = false;
+    }
+}
+
+void GeometryHitTest::AddVertex(float x, float y, uint32_t cmd)
+{
+    if (IsMoveTo(cmd)) {
+        MoveTo(x, y);
+    } else if (IsVertex(cmd)) {
+        LineTo(x, y);
+    } else if (IsEndPoly(cmd)) {
+        ClosePolygon();
+    }
+}
+
+uint32_t GeometryHitTest::GetBucket(float y) const
+{
+    float pos = (y - minY_) * bucketScale_;
+    if (pos <= 0) {
+        return 0;
+    }
+    uint32_t bucket = static_cast<uint32_t>(pos);
+    return MATH_MIN(bucket, bucketNum_ - 1);
+}
+
+/**
+ * @brief Counts the edges of every bucket, turns the counts into start offsets and lists every edge in
+ * each bucket its y range touches.
+ */
+void GeometryHitTest::BuildIndex(uint32_t bucketNum)
+{
+    DropIndex();
+    if (edgeNum_ == 0) {
+        return;
+    }
+    if (bucketNum == 0) {
+        bucketNum = MATH_MIN(MATH_MAX(edgeNum_ / 2, 1U), HIT_TEST_MAX_BUCKETS); // 2: two edges per bucket
+    }
+    bucketNum_ = bucketNum;
+    bucketScale_ = (maxY_ > minY_) ? bucketNum / (maxY_ - minY_) : 0;
+    bucketStart_.Resize(bucketNum + 1);
+    if (memset_s(bucketStart_.Data(), (bucketNum + 1) * sizeof(uint32_t), 0,
+                 (bucketNum + 1) * sizeof(uint32_t)) != EOK) {
+        GRAPHIC_LOGE("GeometryHitTest::BuildIndex memset_s fail");
+        DropIndex();
+        return;
+    }
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < edgeNum_; i++) {
+        const HitEdge& edge = edges_[i];
+        uint32_t first = GetBucket(MATH_MIN(edge.y1, edge.y2));
+        uint32_t last = GetBucket(MATH_MAX(edge.y1, edge.y2));
+        for (uint32_t b = first; b <= last; b++) {
+            bucketStart_[b + 1]++;
+        }
+        total += last - first + 1;
+    }
+    for (uint32_t b = 0; b < bucketNum; b++) {
+        bucketStart_[b + 1] += bucketStart_[b];
+    }
+    bucketEdges_.Resize(total);
+    if (bucketEdges_.Data() == nullptr || bucketStart_.Data() == nullptr) {
+        DropIndex();
+        return;
+    }
+    /* bucketStart_[b] walks through the bucket while filling and ends at the start of bucket b + 1. */
+    for (uint32_t i = 0; i < edgeNum_; i++) {
+        const HitEdge& edge = edges_[i];
+        uint32_t first = GetBucket(MATH_MIN(edge.y1, edge.y2));
+        uint32_t last = GetBucket(MATH_MAX(edge.y1, edge.y2));
+        for (uint32_t b = first; b <= last; b++) {
+            bucketEdges_[bucketStart_[b]++] = i;
+        }
+    }
+    for (uint32_t b = bucketNum; b > 0; b--) {
+        bucketStart_[b] = bucketStart_[b - 1];
+    }
+    bucketStart_[0] = 0;
+}
+
+int32_t GeometryHitTest::GetWinding(float x, float y) const
+{
+    if (edgeNum_ == 0 || x < minX_ || x > maxX_ || y < minY_ || y >= maxY_) {
+        return 0;
+    }
+    int32_t winding = 0;
+    if (bucketNum_ > 0) {
+        uint32_t bucket = GetBucket(y);
+        uint32_t end = bucketStart_[bucket + 1];
+        for (uint32_t i = bucketStart_[bucket]; i < end; i++) {
+            const HitEdge& edge = edges_[bucketEdges_[i]];
+            winding += GetEdgeWinding(edge.x1, edge.y1, edge.x2, edge.y2, x, y);
+        }
+        return winding;
+    }
+    for (uint32_t i = 0; i < edgeNum_; i++) {
+        const HitEdge& edge = edges_[i];
+        winding += GetEdgeWinding(edge.x1, edge.y1, edge.x2, edge.y2, x, y);
+    }
+    return winding;
+}
+} // namespace OHOS
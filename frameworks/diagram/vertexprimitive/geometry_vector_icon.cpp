@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_vector_icon.h"
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/file.h"
+#include "gfx_utils/graphic_log.h"
+#include "gfx_utils/mem_api.h"
+#include "securec.h"
+/* liteos_m defines __LITEOS__ as well but has no mmap, the icon file is read into memory there. */
+#if (defined __linux__ || defined __LITEOS__ || defined __APPLE__) && !defined __LITEOS_M__
+#define VECTOR_ICON_FILE_MMAP
+#include <sys/mman.h>
+#endif
+
+namespace OHOS {
+namespace {
+#ifdef _WIN32
+const int32_t FILE_BINARY_FLAG = O_BINARY;
+#else
+const int32_t FILE_BINARY_FLAG = 0;
+#endif
+const uint32_t COORD_ALIGN_MASK = 3; // 3: coordinates are read as 4 bytes aligned floats
+const float QUANTIZE_RANGE = 65535.0f;
+} // namespace
+
+bool VectorIconSource::Attach(const uint8_t* data, uint32_t size)
+{
+    Detach();
+    if (data == nullptr || size < sizeof(VectorIconHeader) ||
+        (reinterpret_cast<uintptr_t>(data) & COORD_ALIGN_MASK) != 0) {
+        return false;
+    }
+    const VectorIconHeader* header = reinterpret_cast<const VectorIconHeader*>(data);
+    if (header->magic != VECTOR_ICON_MAGIC || header->version != VECTOR_ICON_VERSION ||
+        header->coordFormat > VECTOR_ICON_COORD_UINT16) {
+        GRAPHIC_LOGE("VectorIconSource::Attach invalid header");
+        return false;
+    }
+    uint64_t coordBytes = (header->coordFormat == VECTOR_ICON_COORD_UINT16) ? sizeof(uint16_t) : sizeof(float);
+    coordBytes *= static_cast<uint64_t>(header->vertexNum) * 2; // 2: x and y
+    if (sizeof(VectorIconHeader) + coordBytes + header->vertexNum > size) {
+        GRAPHIC_LOGE("VectorIconSource::Attach data truncated");
+        return false;
+    }
+    header_ = header;
+    coords_ = data + sizeof(VectorIconHeader);
+    cmds_ = coords_ + coordBytes;
+    return true;
+}
+
+bool VectorIconSource::GetBounds(float& minX, float& minY, float& maxX, float& maxY) const
+{
+    if (header_ == nullptr || header_->vertexNum == 0) {
+        return false;
+    }
+    minX = header_->minX;
+    minY = header_->minY;
+    maxX = header_->maxX;
+    maxY = header_->maxY;
+    return true;
+}
+
+void VectorIconSource::DecodeVertex(uint32_t idx, float* x, float* y) const
+{
+    if (header_->coordFormat == VECTOR_ICON_COORD_UINT16) {
+        const uint16_t* coord = reinterpret_cast<const uint16_t*>(coords_) + (idx << 1);
+        *x = header_->minX + coord[0] * header_->stepX;
+        *y = header_->minY + coord[1] * header_->stepY;
+    } else {
+        const float* coord = reinterpret_cast<const float*>(coords_) + (idx << 1);
+        *x = coord[0];
+        *y = coord[1];
+    }
+}
+
+uint32_t VectorIconSource::GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+{
+    uint32_t total = GetTotalVertices();
+    uint32_t num = (iterator_ < total) ? MATH_MIN(maxNum, total - iterator_) : 0;
+    if (num == 0) {
+        return 0;
+    }
+    const uint8_t* cmd = cmds_ + iterator_;
+    if (header_->coordFormat == VECTOR_ICON_COORD_UINT16) {
+        const uint16_t* coord = reinterpret_cast<const uint16_t*>(coords_) + (iterator_ << 1);
+        float minX = header_->minX;
+        float minY = header_->minY;
+        float stepX = header_->stepX;
+        float stepY = header_->stepY;
+        for (uint32_t i = 0; i < num; i++, coord += TWO_TIMES) {
+            vertices[i].x = minX + coord[0] * stepX;
+            vertices[i].y = minY + coord[1] * stepY;
+            vertices[i].cmd = cmd[i];
+        }
+    } else {
+        const float* coord = reinterpret_cast<const float*>(coords_) + (iterator_ << 1);
+        for (uint32_t i = 0; i < num; i++, coord += TWO_TIMES) {
+            vertices[i].x = coord[0];
+            vertices[i].y = coord[1];
+            vertices[i].cmd = cmd[i];
+        }
+    }
+    iterator_ += num;
+    return num;
+}
+
+bool VectorIconFile::Open(const char* fileName)
+{
+    Close();
+    if (fileName == nullptr) {
+        return false;
+    }
+    int32_t fd = open(fileName, O_RDONLY | FILE_BINARY_FLAG);
+    if (fd < 0) {
+        GRAPHIC_LOGE("VectorIconFile::Open open fail");
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 || static_cast<uint64_t>(info.st_size) > UINT32_MAX) {
+        GRAPHIC_LOGE("VectorIconFile::Open invalid size");
+        close(fd);
+        return false;
+    }
+    uint32_t size = static_cast<uint32_t>(info.st_size);
+#ifdef VECTOR_ICON_FILE_MMAP
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        GRAPHIC_LOGE("VectorIconFile::Open mmap fail");
+        return false;
+    }
+    data_ = static_cast<uint8_t*>(data);
+    mapped_ = true;
+#else
+    uint8_t* data = static_cast<uint8_t*>(UIMalloc(size));
+    if (data == nullptr) {
+        GRAPHIC_LOGE("VectorIconFile::Open alloc fail");
+        close(fd);
+        return false;
+    }
+    uint32_t offset = 0;
+    while (offset < size) {
+        int32_t readBytes = read(fd, data + offset, size - offset);
+        if (readBytes <= 0) {
+            break;
+        }
+        offset += readBytes;
+    }
+    close(fd);
+    if (offset < size) {
+        GRAPHIC_LOGE("VectorIconFile::Open read fail");
+        UIFree(data);
+        return false;
+    }
+    data_ = data;
+    mapped_ = false;
+#endif
+    size_ = size;
+    return true;
+}
+
+void VectorIconFile::Close()
+{
+    if (data_ == nullptr) {
+        return;
+    }
+#ifdef VECTOR_ICON_FILE_MMAP
+    if (mapped_) {
+        munmap(data_, size_);
+    } else {
+        UIFree(data_);
+    }
+#else
+    UIFree(data_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+}
+
+void VectorIconWriter::BeginHeader(VectorIconHeader& header, VectorIconCoordFormat format)
+{
+    header.magic = VECTOR_ICON_MAGIC;
+    header.version = VECTOR_ICON_VERSION;
+    header.coordFormat = format;
+    header.vertexNum = 0;
+    header.stepX = 0;
+    header.stepY = 0;
+    header.minX = 0;
+    header.minY = 0;
+    header.maxX = 0;
+    header.maxY = 0;
+}
+
+void VectorIconWriter::AddBounds(VectorIconHeader& header, const PathVertex* vertices, uint32_t num, bool& hasBounds)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        if (!IsVertex(vertices[i].cmd)) {
+            continue;
+        }
+        if (!hasBounds) {
+            header.minX = header.maxX = vertices[i].x;
+            header.minY = header.maxY = vertices[i].y;
+            hasBounds = true;
+            continue;
+        }
+        header.minX = MATH_MIN(header.minX, vertices[i].x);
+        header.minY = MATH_MIN(header.minY, vertices[i].y);
+        header.maxX = MATH_MAX(header.maxX, vertices[i].x);
+        header.maxY = MATH_MAX(header.maxY, vertices[i].y);
+    }
+    header.vertexNum += num;
+}
+
+void VectorIconWriter::EndHeader(VectorIconHeader& header)
+{
+    if (header.coordFormat == VECTOR_ICON_COORD_UINT16) {
+        header.stepX = (header.maxX - header.minX) / QUANTIZE_RANGE;
+        header.stepY = (header.maxY - header.minY) / QUANTIZE_RANGE;
+    }
+}
+
+bool VectorIconWriter::WriteHeader(const VectorIconHeader& header, uint8_t* buffer)
+{
+    if (memcpy_s(buffer, sizeof(VectorIconHeader), &header, sizeof(VectorIconHeader)) != EOK) {
+        GRAPHIC_LOGE("VectorIconWriter::WriteHeader memcpy_s fail");
+        return false;
+    }
+    return true;
+}
+
+void VectorIconWriter::WriteVertices(const VectorIconHeader& header, const PathVertex* vertices, uint32_t num,
+                                     uint32_t idx, uint8_t* buffer)
+{
+    uint8_t* coords = buffer + sizeof(VectorIconHeader);
+    uint32_t coordBytes = (header.coordFormat == VECTOR_ICON_COORD_UINT16) ? sizeof(uint16_t) : sizeof(float);
+    uint8_t* cmds = coords + header.vertexNum * coordBytes * 2 + idx; // 2: x and y
+    coords += idx * coordBytes * 2; // 2: x and y
+    for (uint32_t i = 0; i < num; i++) {
+        cmds[i] = static_cast<uint8_t>(vertices[i].cmd);
+        /* Commands other than vertices may leave x and y unset, they are stored as 0 to keep the file deterministic. */
+        bool isVertex = IsVertex(vertices[i].cmd);
+        if (header.coordFormat != VECTOR_ICON_COORD_UINT16) {
+            float coord[2] = {0, 0}; // 2: x and y
+            if (isVertex) {
+                coord[0] = vertices[i].x;
+                coord[1] = vertices[i].y;
+            }
+            if (memcpy_s(coords, sizeof(coord), coord, sizeof(coord)) != EOK) {
+                GRAPHIC_LOGE("VectorIconWriter::WriteVertices memcpy_s fail");
+            }
+            coords += sizeof(coord);
+            continue;
+        }
+        uint16_t quantized[2] = {0, 0}; // 2: x and y
+        if (isVertex) {
+            float qx = (header.stepX > 0) ? (vertices[i].x - header.minX) / header.stepX : 0;
+            float qy = (header.stepY > 0) ? (vertices[i].y - header.minY) / header.stepY : 0;
+            quantized[0] = static_cast<uint16_t>(MATH_MIN(MATH_MAX(qx, 0.0f), QUANTIZE_RANGE) + 0.5f); // 0.5: round
+            quantized[1] = static_cast<uint16_t>(MATH_MIN(MATH_MAX(qy, 0.0f), QUANTIZE_RANGE) + 0.5f); // 0.5: round
+        }
+        if (memcpy_s(coords, sizeof(quantized), quantized, sizeof(quantized)) != EOK) {
+            GRAPHIC_LOGE("VectorIconWriter::WriteVertices memcpy_s fail");
+        }
+        coords += sizeof(quantized);
+    }
+}
+
+bool VectorIconWriter::WriteFile(UICanvasVertices& path, const char* fileName,
+                                 VectorIconCoordFormat format, float approximationScale)
+{
+    if (fileName == nullptr) {
+        return false;
+    }
+    DepictCurve curve(path);
+    curve.ApproximationScale(approximationScale);
+    uint32_t size = Encode(curve, format, nullptr, 0);
+    uint8_t* buffer = static_cast<uint8_t*>(UIMalloc(size));
+    if (buffer == nullptr) {
+        GRAPHIC_LOGE("VectorIconWriter::WriteFile alloc fail");
+        return false;
+    }
+    bool ret = false;
+    if (Encode(curve, format, buffer, size) == size) {
+        int32_t fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC | FILE_BINARY_FLAG, DEFAULT_FILE_PERMISSION);
+        if (fd >= 0) {
+            uint32_t offset = 0;
+            while (offset < size) {
+                int32_t written = write(fd, buffer + offset, size - offset);
+                if (written <= 0) {
+                    break;
+                }
+                offset += written;
+            }
+            ret = (offset == size);
+            close(fd);
+        }
+        if (!ret) {
+            GRAPHIC_LOGE("VectorIconWriter::WriteFile write fail");
+        }
+    }
+    UIFree(buffer);
+    return ret;
+}
+} // namespace OHOS
@@ -13,9 +13,18 @@
  * limitations under the License.
  */
 #include "gfx_utils/trans_affine.h"
+#include "graphic_config.h"
+#ifdef ARM_NEON_OPT
+#include <arm_neon.h>
+#elif defined(X86_SIMD_OPT)
+#include <emmintrin.h>
+#endif
 
 namespace OHOS {
 const uint8_t PARL_INDEX_SIZE = 6;
+#if defined(ARM_NEON_OPT) || defined(X86_SIMD_OPT)
+const uint32_t SIMD_FLOAT_LANES = 4;
+#endif
 const TransAffine& TransAffine::ParlToParl(const float* src,
                                            const float* dst)
 {
@@ -58,6 +67,7 @@ const TransAffine& TransAffine::Multiply(const TransAffine& metrix)
     data_[0] = t0;
     data_[1] = t2;
     data_[2] = t4;
+    UpdateType();
     return *this;
 }
 
@@ -75,6 +85,7 @@ const TransAffine& TransAffine::Invert()
 
     data_[0] = t0;
     data_[2] = t4;
+    UpdateType();
     return *this;
 }
 
@@ -89,6 +100,7 @@ const TransAffine& TransAffine::Reset()
     data_[0] = 1;
     data_[4] = 1;
     data_[8] = 1;
+    type_ = TRANS_AFFINE_IDENTITY;
     return *this;
 }
 
@@ -106,4 +118,128 @@ bool TransAffine::IsValid(float epsilon) const
 {
     return (MATH_ABS(data_[0]) > epsilon) && (MATH_ABS(data_[4]) > epsilon);
 }
+
+void TransAffine::UpdateType()
+{
+    if (data_[1] != 0.0f || data_[3] != 0.0f) {
+        type_ = TRANS_AFFINE_GENERAL;
+    } else if (data_[0] != 1.0f || data_[4] != 1.0f) {
+        type_ = TRANS_AFFINE_SCALE;
+    } else if (data_[2] != 0.0f || data_[5] != 0.0f) {
+        type_ = TRANS_AFFINE_TRANSLATE;
+    } else {
+        type_ = TRANS_AFFINE_IDENTITY;
+    }
+}
+
+void TransAffine::TransformBatch(float* x, float* y, uint32_t num) const
+{
+    if (type_ == TRANS_AFFINE_IDENTITY) {
+        return;
+    }
+    uint32_t i = 0;
+    if (type_ != TRANS_AFFINE_GENERAL) {
+        /* Translations take this path too, a scale of exactly 1 leaves the coordinates unchanged. */
+#ifdef ARM_NEON_OPT
+        float32x4_t translateX = vdupq_n_f32(data_[2]);
+        float32x4_t translateY = vdupq_n_f32(data_[5]);
+        for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+            vst1q_f32(x + i, vaddq_f32(vmulq_n_f32(vld1q_f32(x + i), data_[0]), translateX));
+            vst1q_f32(y + i, vaddq_f32(vmulq_n_f32(vld1q_f32(y + i), data_[4]), translateY));
+        }
+#elif defined(X86_SIMD_OPT)
+        __m128 scaleX = _mm_set1_ps(data_[0]);
+        __m128 translateX = _mm_set1_ps(data_[2]);
+        __m128 scaleY = _mm_set1_ps(data_[4]);
+        __m128 translateY = _mm_set1_ps(data_[5]);
+        for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), scaleX), translateX));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(y + i), scaleY), translateY));
+        }
+#endif
+        for (; i < num; i++) {
+            x[i] = x[i] * data_[0] + data_[2];
+            y[i] = y[i] * data_[4] + data_[5];
+        }
+        return;
+    }
+#ifdef ARM_NEON_OPT
+    float32x4_t translateX = vdupq_n_f32(data_[2]);
+    float32x4_t translateY = vdupq_n_f32(data_[5]);
+    for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+        float32x4_t vx = vld1q_f32(x + i);
+        float32x4_t vy = vld1q_f32(y + i);
+        vst1q_f32(x + i, vaddq_f32(vaddq_f32(vmulq_n_f32(vx, data_[0]), vmulq_n_f32(vy, data_[1])), translateX));
+        vst1q_f32(y + i, vaddq_f32(vaddq_f32(vmulq_n_f32(vx, data_[3]), vmulq_n_f32(vy, data_[4])), translateY));
+    }
+#elif defined(X86_SIMD_OPT)
+    __m128 scaleX = _mm_set1_ps(data_[0]);
+    __m128 shearX = _mm_set1_ps(data_[1]);
+    __m128 translateX = _mm_set1_ps(data_[2]);
+    __m128 shearY = _mm_set1_ps(data_[3]);
+    __m128 scaleY = _mm_set1_ps(data_[4]);
+    __m128 translateY = _mm_set1_ps(data_[5]);
+    for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, scaleX), _mm_mul_ps(vy, shearX)), translateX));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, shearY), _mm_mul_ps(vy, scaleY)), translateY));
+    }
+#endif
+    for (; i < num; i++) {
+        Transform(x + i, y + i);
+    }
+}
+
+void TransAffine::InverseTransformBatch(float* x, float* y, uint32_t num) const
+{
+    uint32_t i = 0;
+    switch (type_) {
+        case TRANS_AFFINE_IDENTITY:
+            return;
+        case TRANS_AFFINE_TRANSLATE:
+            for (; i < num; i++) {
+                x[i] -= data_[2];
+                y[i] -= data_[5];
+            }
+            return;
+        default:
+            break;
+    }
+    float reciprocal = DeterminantReciprocal();
+    if (type_ == TRANS_AFFINE_SCALE) {
+        for (; i < num; i++) {
+            x[i] = (x[i] - data_[2]) * reciprocal * data_[4];
+            y[i] = (y[i] - data_[5]) * reciprocal * data_[0];
+        }
+        return;
+    }
+#ifdef ARM_NEON_OPT
+    float32x4_t translateX = vdupq_n_f32(data_[2]);
+    float32x4_t translateY = vdupq_n_f32(data_[5]);
+    for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+        float32x4_t a = vmulq_n_f32(vsubq_f32(vld1q_f32(x + i), translateX), reciprocal);
+        float32x4_t b = vmulq_n_f32(vsubq_f32(vld1q_f32(y + i), translateY), reciprocal);
+        vst1q_f32(x + i, vsubq_f32(vmulq_n_f32(a, data_[4]), vmulq_n_f32(b, data_[1])));
+        vst1q_f32(y + i, vsubq_f32(vmulq_n_f32(b, data_[0]), vmulq_n_f32(a, data_[3])));
+    }
+#elif defined(X86_SIMD_OPT)
+    __m128 scaleX = _mm_set1_ps(data_[0]);
+    __m128 shearX = _mm_set1_ps(data_[1]);
+    __m128 translateX = _mm_set1_ps(data_[2]);
+    __m128 shearY = _mm_set1_ps(data_[3]);
+    __m128 scaleY = _mm_set1_ps(data_[4]);
+    __m128 translateY = _mm_set1_ps(data_[5]);
+    __m128 factor = _mm_set1_ps(reciprocal);
+    for (; i + SIMD_FLOAT_LANES <= num; i += SIMD_FLOAT_LANES) {
+        __m128 a = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), translateX), factor);
+        __m128 b = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(y + i), translateY), factor);
+        _mm_storeu_ps(x + i, _mm_sub_ps(_mm_mul_ps(a, scaleY), _mm_mul_ps(b, shearX)));
+        _mm_storeu_ps(y + i, _mm_sub_ps(_mm_mul_ps(b, scaleX), _mm_mul_ps(a, shearY)));
+    }
+#endif
+    for (; i < num; i++) {
+        InverseTransform(x + i, y + i);
+    }
+}
 } // namespace OHOS
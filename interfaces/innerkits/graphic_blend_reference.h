@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_GRAPHIC_BLEND_REFERENCE_H
+#define GRAPHIC_LITE_GRAPHIC_BLEND_REFERENCE_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/graphic_math.h"
+
+namespace OHOS {
+/**
+ * @brief Scalar model of the SIMD blend pipelines with the same surface, 8 pixels per call.
+ * It is the bit-exact reference of X86BlendPipeLine and a fallback when no SIMD is available.
+ */
+class ScalarBlendPipeLine {
+public:
+    static constexpr int16_t PIXELS = 8;
+
+    ScalarBlendPipeLine() {}
+    ~ScalarBlendPipeLine() {}
+
+    static uint8_t MulDiv255(uint8_t valueA, uint8_t valueB)
+    {
+        uint32_t mul = valueA * valueB;
+        // 257: 2^8 + 1; 8: number of shifts
+        return static_cast<uint8_t>((mul + ((mul + 257) >> 8)) >> 8);
+    }
+
+    void Construct(ColorMode dm, ColorMode sm, void* srcColor = nullptr, uint8_t opa = OPA_OPAQUE)
+    {
+        dm_ = dm;
+        sm_ = sm;
+        if (srcColor != nullptr) {
+            ConstructSrcColor(sm, srcColor, opa);
+        }
+    }
+
+    void Invoke(uint8_t* dst, uint8_t* src, uint8_t opa)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            Rgba8T srcColor = LoadPixel(sm_, src, i);
+            srcColor.alpha = (sm_ == ARGB8888) ? MulDiv255(srcColor.alpha, opa) : opa;
+            BlendPixel(dst, i, srcColor);
+        }
+    }
+
+    void Invoke(uint8_t* dst)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            BlendPixel(dst, i, srcColor_);
+        }
+    }
+
+    void NeonPreLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t* covers)
+    {
+        NeonLerpARGB8888(buf, r, g, b, a, covers);
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* buf, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            PrelerpPixel(buf + i * ARGB_BYTES, red, green, blue, alpha);
+        }
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* buf, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, uint8_t cover)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            PrelerpPixel(buf + i * ARGB_BYTES, Rgba8T::Multiply(red, cover), Rgba8T::Multiply(green, cover),
+                         Rgba8T::Multiply(blue, cover), Rgba8T::Multiply(alpha, cover));
+        }
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t cover)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            uint8_t* src = srcBuffer + i * ARGB_BYTES;
+            PrelerpPixel(dstBuffer + i * ARGB_BYTES, Rgba8T::Multiply(src[R_INDEX], cover),
+                         Rgba8T::Multiply(src[G_INDEX], cover), Rgba8T::Multiply(src[B_INDEX], cover),
+                         Rgba8T::Multiply(src[A_INDEX], cover));
+        }
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t* covers)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            uint8_t* src = srcBuffer + i * ARGB_BYTES;
+            PrelerpPixel(dstBuffer + i * ARGB_BYTES, Rgba8T::Multiply(src[R_INDEX], covers[i]),
+                         Rgba8T::Multiply(src[G_INDEX], covers[i]), Rgba8T::Multiply(src[B_INDEX], covers[i]),
+                         Rgba8T::Multiply(src[A_INDEX], covers[i]));
+        }
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t* covers)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            LerpPixel(buf + i * ARGB_BYTES, Rgba8T::Multiply(r, covers[i]), Rgba8T::Multiply(g, covers[i]),
+                      Rgba8T::Multiply(b, covers[i]), Rgba8T::Multiply(a, covers[i]));
+        }
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            LerpPixel(buf + i * ARGB_BYTES, r, g, b, a);
+        }
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t cover)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            LerpPixel(buf + i * ARGB_BYTES, Rgba8T::Multiply(r, cover), Rgba8T::Multiply(g, cover),
+                      Rgba8T::Multiply(b, cover), Rgba8T::Multiply(a, cover));
+        }
+    }
+
+    void NeonLerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t cover)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            uint8_t* src = srcBuffer + i * ARGB_BYTES;
+            LerpPixel(dstBuffer + i * ARGB_BYTES, Rgba8T::Multiply(src[R_INDEX], cover),
+                      Rgba8T::Multiply(src[G_INDEX], cover), Rgba8T::Multiply(src[B_INDEX], cover),
+                      Rgba8T::Multiply(src[A_INDEX], cover));
+        }
+    }
+
+    void NeonLerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t* covers)
+    {
+        for (int16_t i = 0; i < PIXELS; i++) {
+            uint8_t* src = srcBuffer + i * ARGB_BYTES;
+            LerpPixel(dstBuffer + i * ARGB_BYTES, Rgba8T::Multiply(src[R_INDEX], covers[i]),
+                      Rgba8T::Multiply(src[G_INDEX], covers[i]), Rgba8T::Multiply(src[B_INDEX], covers[i]),
+                      Rgba8T::Multiply(src[A_INDEX], covers[i]));
+        }
+    }
+
+private:
+    static constexpr int16_t ARGB_BYTES = 4;
+    static constexpr int16_t RGB_BYTES = 3;
+    static constexpr int16_t B_INDEX = 0;
+    static constexpr int16_t G_INDEX = 1;
+    static constexpr int16_t R_INDEX = 2;
+    static constexpr int16_t A_INDEX = 3;
+
+    static void PrelerpPixel(uint8_t* pixel, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        pixel[R_INDEX] = Rgba8T::Prelerp(pixel[R_INDEX], red, alpha);
+        pixel[G_INDEX] = Rgba8T::Prelerp(pixel[G_INDEX], green, alpha);
+        pixel[B_INDEX] = Rgba8T::Prelerp(pixel[B_INDEX], blue, alpha);
+        pixel[A_INDEX] = Rgba8T::Prelerp(pixel[A_INDEX], alpha, alpha);
+    }
+
+    static void LerpPixel(uint8_t* pixel, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        pixel[R_INDEX] = Rgba8T::Lerp(pixel[R_INDEX], red, alpha);
+        pixel[G_INDEX] = Rgba8T::Lerp(pixel[G_INDEX], green, alpha);
+        pixel[B_INDEX] = Rgba8T::Lerp(pixel[B_INDEX], blue, alpha);
+        pixel[A_INDEX] = Rgba8T::Prelerp(pixel[A_INDEX], alpha, alpha);
+    }
+
+    static Rgba8T LoadPixel(ColorMode mode, const uint8_t* buf, int16_t index)
+    {
+        Rgba8T color;
+        color.alpha = OPA_OPAQUE;
+        if (mode == ARGB8888) {
+            const uint8_t* pixel = buf + index * ARGB_BYTES;
+            color.red = pixel[R_INDEX];
+            color.green = pixel[G_INDEX];
+            color.blue = pixel[B_INDEX];
+            color.alpha = pixel[A_INDEX];
+        } else if (mode == RGB888) {
+            const uint8_t* pixel = buf + index * RGB_BYTES;
+            color.red = pixel[R_INDEX];
+            color.green = pixel[G_INDEX];
+            color.blue = pixel[B_INDEX];
+        } else if (mode == RGB565) {
+            uint16_t pixel = reinterpret_cast<const uint16_t*>(buf)[index];
+            // 11, 5, 3, 2: expand RRRRRGGG|GGGBBBBB to 8 bits per channel
+            color.red = static_cast<uint8_t>((pixel >> 11) << 3);
+            color.green = static_cast<uint8_t>(((pixel >> 5) & 0x3F) << 2);
+            color.blue = static_cast<uint8_t>(pixel << 3);
+        }
+        return color;
+    }
+
+    static void StorePixel(ColorMode mode, uint8_t* buf, int16_t index, const Rgba8T& color)
+    {
+        if (mode == ARGB8888) {
+            uint8_t* pixel = buf + index * ARGB_BYTES;
+            pixel[R_INDEX] = color.red;
+            pixel[G_INDEX] = color.green;
+            pixel[B_INDEX] = color.blue;
+            pixel[A_INDEX] = color.alpha;
+        } else if (mode == RGB888) {
+            uint8_t* pixel = buf + index * RGB_BYTES;
+            pixel[R_INDEX] = color.red;
+            pixel[G_INDEX] = color.green;
+            pixel[B_INDEX] = color.blue;
+        } else if (mode == RGB565) {
+            // 0xF8, 0xFC, 8, 3: RRRRR000 << 8 | GGGGGG00 << 3 | BBBBB000 >> 3
+            reinterpret_cast<uint16_t*>(buf)[index] =
+                static_cast<uint16_t>(((color.red & 0xF8) << 8) | ((color.green & 0xFC) << 3) | (color.blue >> 3));
+        }
+    }
+
+    void BlendPixel(uint8_t* dst, int16_t index, const Rgba8T& src)
+    {
+        Rgba8T color = LoadPixel(dm_, dst, index);
+        if (dm_ == ARGB8888) {
+            uint8_t da = MulDiv255(color.alpha, OPA_OPAQUE - src.alpha);
+            uint8_t alpha = static_cast<uint8_t>(color.alpha - MulDiv255(src.alpha, color.alpha) + src.alpha);
+            uint32_t divisor = MATH_MAX(alpha, 1);
+            color.red = static_cast<uint8_t>(MATH_MIN((src.red * src.alpha + color.red * da) / divisor, OPA_OPAQUE));
+            color.green =
+                static_cast<uint8_t>(MATH_MIN((src.green * src.alpha + color.green * da) / divisor, OPA_OPAQUE));
+            color.blue =
+                static_cast<uint8_t>(MATH_MIN((src.blue * src.alpha + color.blue * da) / divisor, OPA_OPAQUE));
+            color.alpha = alpha;
+        } else {
+            uint8_t da = OPA_OPAQUE - src.alpha;
+            color.red = static_cast<uint8_t>(
+                MATH_MIN(MulDiv255(src.red, src.alpha) + MulDiv255(color.red, da), OPA_OPAQUE));
+            color.green = static_cast<uint8_t>(
+                MATH_MIN(MulDiv255(src.green, src.alpha) + MulDiv255(color.green, da), OPA_OPAQUE));
+            color.blue = static_cast<uint8_t>(
+                MATH_MIN(MulDiv255(src.blue, src.alpha) + MulDiv255(color.blue, da), OPA_OPAQUE));
+        }
+        StorePixel(dm_, dst, index, color);
+    }
+
+    void ConstructSrcColor(ColorMode sm, void* srcColor, uint8_t opa)
+    {
+        if (sm == ARGB8888) {
+            Color32* color = reinterpret_cast<Color32*>(srcColor);
+            srcColor_.red = color->red;
+            srcColor_.green = color->green;
+            srcColor_.blue = color->blue;
+            srcColor_.alpha = MulDiv255(opa, color->alpha);
+        } else if (sm == RGB888) {
+            Color24* color = reinterpret_cast<Color24*>(srcColor);
+            srcColor_.red = color->red;
+            srcColor_.green = color->green;
+            srcColor_.blue = color->blue;
+            srcColor_.alpha = opa;
+        } else if (sm == RGB565) {
+            // 3, 2: expand to 8 bits
+            Color16* color = reinterpret_cast<Color16*>(srcColor);
+            srcColor_.red = static_cast<uint8_t>(color->red << 3);
+            srcColor_.green = static_cast<uint8_t>(color->green << 2);
+            srcColor_.blue = static_cast<uint8_t>(color->blue << 3);
+            srcColor_.alpha = opa;
+        }
+    }
+
+    ColorMode dm_ = ARGB8888;
+    ColorMode sm_ = ARGB8888;
+    Rgba8T srcColor_;
+};
+} // namespace OHOS
+#endif
@@ -277,6 +277,21 @@ namespace OHOS {
 #define ARM_NEON_OPT
 #endif
 
+/**
+ * @brief x86 SIMD ability, which is enabled by default. AVX2 kernels are chosen at runtime by cpu feature check.
+ */
+#ifndef ENABLE_X86_SIMD
+#define ENABLE_X86_SIMD                   1
+#endif
+
+/**
+ * @brief Actually use x86 SIMD optimization.
+ *        __SSE2__ is set by the compiler for x86-64 and for x86 with -msse2
+ */
+#if (defined(__SSE2__) || defined(_M_X64)) && ENABLE_X86_SIMD == 1 && !defined(ARM_NEON_OPT)
+#define X86_SIMD_OPT
+#endif
+
 /**
  * @brief Graphics bottom-layer RGBA, which is enabled by default.
  */
@@ -361,6 +361,8 @@ private:
     uint8x8_t b2_;
     uint8x8_t a2_;
 };
+
+using SimdBlendPipeLine = NeonBlendPipeLine;
 } // namespace OHOS
 #endif
 #endif
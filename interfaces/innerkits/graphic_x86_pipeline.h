@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_GRAPHIC_X86_PIPELINE_H
+#define GRAPHIC_LITE_GRAPHIC_X86_PIPELINE_H
+
+#include "graphic_config.h"
+#ifdef X86_SIMD_OPT
+#include "gfx_utils/color.h"
+#include "graphic_x86_utils.h"
+
+namespace OHOS {
+using X86LoadBuf = void (*)(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a);
+using X86LoadBufA = void (*)(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a, uint8_t opa);
+using X86Blend = void (*)(__m128i& r1, __m128i& g1, __m128i& b1, __m128i& a1,
+                          __m128i r2, __m128i g2, __m128i b2, __m128i a2);
+using X86StoreBuf = void (*)(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a);
+using X86LerpFunc = __m128i (*)(__m128i p, __m128i q, __m128i alpha);
+
+struct {
+    ColorMode dm;
+    X86LoadBuf loadDstFunc;
+    X86Blend blendFunc;
+    X86Blend blendAvx2Func;
+    X86StoreBuf storeDstFunc;
+}
+g_x86DstFunc[] = {
+    {ARGB8888, LoadBuf_ARGB8888, X86BlendRGBA, X86BlendRGBAAvx2, StoreBuf_ARGB8888},
+    {RGB888, LoadBuf_RGB888, X86BlendRGB, X86BlendRGB, StoreBuf_RGB888},
+    {RGB565, LoadBuf_RGB565, X86BlendRGB, X86BlendRGB, StoreBuf_RGB565}
+};
+
+struct {
+    ColorMode sm;
+    X86LoadBufA loadSrcFunc;
+}
+g_x86SrcFunc[] = {
+    {ARGB8888, LoadBufA_ARGB8888},
+    {RGB888, LoadBufA_RGB888},
+    {RGB565, LoadBufA_RGB565}
+};
+
+/**
+ * @brief SSE2 counterpart of NeonBlendPipeLine, every call handles 8 pixels.
+ * The method names match NeonBlendPipeLine so that callers can use SimdBlendPipeLine on both
+ * architectures. Kernels which need 32-bit intermediates switch to AVX2 when the cpu reports it.
+ */
+class X86BlendPipeLine {
+public:
+    X86BlendPipeLine() : lerpFunc_(X86HasAvx2() ? X86LerpAvx2 : X86Lerp) {}
+    ~X86BlendPipeLine() {}
+
+    void Construct(ColorMode dm, ColorMode sm, void* srcColor = nullptr, uint8_t opa = OPA_OPAQUE)
+    {
+        bool hasAvx2 = X86HasAvx2();
+        int16_t dstNum = sizeof(g_x86DstFunc) / sizeof(g_x86DstFunc[0]);
+        for (int16_t i = 0; i < dstNum; ++i) {
+            if (g_x86DstFunc[i].dm == dm) {
+                loadDstFunc_ = g_x86DstFunc[i].loadDstFunc;
+                blendFunc_ = hasAvx2 ? g_x86DstFunc[i].blendAvx2Func : g_x86DstFunc[i].blendFunc;
+                storeDstFunc_ = g_x86DstFunc[i].storeDstFunc;
+                break;
+            }
+        }
+        int16_t srcNum = sizeof(g_x86SrcFunc) / sizeof(g_x86SrcFunc[0]);
+        for (int16_t i = 0; i < srcNum; ++i) {
+            if (g_x86SrcFunc[i].sm == sm) {
+                loadSrcFunc_ = g_x86SrcFunc[i].loadSrcFunc;
+                break;
+            }
+        }
+        if (srcColor != nullptr) {
+            ConstructSrcColor(sm, srcColor, opa, r2_, g2_, b2_, a2_);
+        }
+    }
+
+    void Invoke(uint8_t* dst, uint8_t* src, uint8_t opa)
+    {
+        loadDstFunc_(dst, r1_, g1_, b1_, a1_);
+        loadSrcFunc_(src, r2_, g2_, b2_, a2_, opa);
+        blendFunc_(r1_, g1_, b1_, a1_, r2_, g2_, b2_, a2_);
+        storeDstFunc_(dst, r1_, g1_, b1_, a1_);
+    }
+
+    void Invoke(uint8_t* dst)
+    {
+        loadDstFunc_(dst, r1_, g1_, b1_, a1_);
+        blendFunc_(r1_, g1_, b1_, a1_, r2_, g2_, b2_, a2_);
+        storeDstFunc_(dst, r1_, g1_, b1_, a1_);
+    }
+
+    void Invoke(uint8_t* dst, __m128i& r, __m128i& g, __m128i& b, __m128i& a)
+    {
+        loadDstFunc_(dst, r1_, g1_, b1_, a1_);
+        blendFunc_(r1_, g1_, b1_, a1_, r, g, b, a);
+        storeDstFunc_(dst, r1_, g1_, b1_, a1_);
+    }
+
+    void NeonPreLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t* covers)
+    {
+        NeonLerpARGB8888(buf, r, g, b, a, covers);
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* buf, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+    {
+        PrelerpStore(buf, X86Dup(red), X86Dup(green), X86Dup(blue), X86Dup(alpha));
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* buf, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha, uint8_t cover)
+    {
+        PrelerpCoverStore(buf, X86Dup(red), X86Dup(green), X86Dup(blue), X86Dup(alpha), X86Dup(cover));
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t cover)
+    {
+        __m128i r, g, b, a;
+        LoadBuf_ARGB8888(srcBuffer, r, g, b, a);
+        PrelerpCoverStore(dstBuffer, r, g, b, a, X86Dup(cover));
+    }
+
+    void NeonPrelerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t* covers)
+    {
+        __m128i r, g, b, a;
+        LoadBuf_ARGB8888(srcBuffer, r, g, b, a);
+        PrelerpCoverStore(dstBuffer, r, g, b, a, X86Load8(covers));
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t* covers)
+    {
+        LerpCoverStore(buf, X86Dup(r), X86Dup(g), X86Dup(b), X86Dup(a), X86Load8(covers));
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        LerpStore(buf, X86Dup(r), X86Dup(g), X86Dup(b), X86Dup(a));
+    }
+
+    void NeonLerpARGB8888(uint8_t* buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, uint8_t cover)
+    {
+        LerpCoverStore(buf, X86Dup(r), X86Dup(g), X86Dup(b), X86Dup(a), X86Dup(cover));
+    }
+
+    void NeonLerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t cover)
+    {
+        __m128i r, g, b, a;
+        LoadBuf_ARGB8888(srcBuffer, r, g, b, a);
+        LerpCoverStore(dstBuffer, r, g, b, a, X86Dup(cover));
+    }
+
+    void NeonLerpARGB8888(uint8_t* dstBuffer, uint8_t* srcBuffer, uint8_t* covers)
+    {
+        __m128i r, g, b, a;
+        LoadBuf_ARGB8888(srcBuffer, r, g, b, a);
+        LerpCoverStore(dstBuffer, r, g, b, a, X86Load8(covers));
+    }
+
+private:
+    void PrelerpStore(uint8_t* buf, __m128i r1, __m128i g1, __m128i b1, __m128i a1)
+    {
+        __m128i r0, g0, b0, a0;
+        LoadBuf_ARGB8888(buf, r0, g0, b0, a0);
+        __m128i rs = X86PreLerp(r0, r1, a1);
+        __m128i gs = X86PreLerp(g0, g1, a1);
+        __m128i bs = X86PreLerp(b0, b1, a1);
+        __m128i as = X86PreLerp(a0, a1, a1);
+        StoreBuf_ARGB8888(buf, rs, gs, bs, as);
+    }
+
+    void PrelerpCoverStore(uint8_t* buf, __m128i r1, __m128i g1, __m128i b1, __m128i a1, __m128i covers)
+    {
+        PrelerpStore(buf, X86Multipling(r1, covers), X86Multipling(g1, covers),
+                     X86Multipling(b1, covers), X86Multipling(a1, covers));
+    }
+
+    void LerpStore(uint8_t* buf, __m128i r1, __m128i g1, __m128i b1, __m128i a1)
+    {
+        __m128i r0, g0, b0, a0;
+        LoadBuf_ARGB8888(buf, r0, g0, b0, a0);
+        __m128i rs = lerpFunc_(r0, r1, a1);
+        __m128i gs = lerpFunc_(g0, g1, a1);
+        __m128i bs = lerpFunc_(b0, b1, a1);
+        __m128i as = X86PreLerp(a0, a1, a1);
+        StoreBuf_ARGB8888(buf, rs, gs, bs, as);
+    }
+
+    void LerpCoverStore(uint8_t* buf, __m128i r1, __m128i g1, __m128i b1, __m128i a1, __m128i covers)
+    {
+        LerpStore(buf, X86Multipling(r1, covers), X86Multipling(g1, covers),
+                  X86Multipling(b1, covers), X86Multipling(a1, covers));
+    }
+
+    void ConstructSrcColor(ColorMode sm, void* srcColor, uint8_t opa,
+                           __m128i& r, __m128i& g, __m128i& b, __m128i& a)
+    {
+        if (sm == ARGB8888) {
+            Color32* color = reinterpret_cast<Color32*>(srcColor);
+            r = X86Dup(color->red);
+            g = X86Dup(color->green);
+            b = X86Dup(color->blue);
+            a = X86MulDiv255(X86Dup(opa), X86Dup(color->alpha));
+        } else if (sm == RGB888) {
+            Color24* color = reinterpret_cast<Color24*>(srcColor);
+            r = X86Dup(color->red);
+            g = X86Dup(color->green);
+            b = X86Dup(color->blue);
+            a = X86Dup(opa);
+        } else if (sm == RGB565) {
+            // 3, 2: expand to 8 bits the same way as LoadBufA_RGB565
+            Color16* color = reinterpret_cast<Color16*>(srcColor);
+            r = X86Dup(color->red << 3);
+            g = X86Dup(color->green << 2);
+            b = X86Dup(color->blue << 3);
+            a = X86Dup(opa);
+        }
+    }
+
+    X86LoadBuf loadDstFunc_ = nullptr;
+    X86LoadBufA loadSrcFunc_ = nullptr;
+    X86Blend blendFunc_ = nullptr;
+    X86StoreBuf storeDstFunc_ = nullptr;
+    X86LerpFunc lerpFunc_ = nullptr;
+    __m128i r1_;
+    __m128i g1_;
+    __m128i b1_;
+    __m128i a1_;
+    __m128i r2_;
+    __m128i g2_;
+    __m128i b2_;
+    __m128i a2_;
+};
+
+using SimdBlendPipeLine = X86BlendPipeLine;
+} // namespace OHOS
+#endif
+#endif
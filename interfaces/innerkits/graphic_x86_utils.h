@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_GRAPHIC_X86_UTILS_H
+#define GRAPHIC_LITE_GRAPHIC_X86_UTILS_H
+
+#include "graphic_config.h"
+#ifdef X86_SIMD_OPT
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/graphic_math.h"
+#include "gfx_utils/graphic_types.h"
+
+/*
+ * Every channel of 8 pixels is held in one __m128i as 8 x uint16_t lanes, the same
+ * granularity as the uint8x8_t lanes of graphic_neon_utils.h. The arithmetic follows
+ * Rgba8T::Multiply/Lerp/Prelerp so that the results equal the scalar render path,
+ * see graphic_blend_reference.h for the bit-exact scalar model.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define X86_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define X86_TARGET_AVX2
+#endif
+
+namespace OHOS {
+#define X86_STEP_8 8
+#define X86_PIXELS 8
+#define X86_BASE_MSB 128
+#define X86_BASE_MASK 0xFF
+
+static inline bool X86HasAvx2()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+#elif defined(_MSC_VER)
+    const int32_t leafExtended = 7;
+    const int32_t avx2Bit = 5;
+    int32_t info[4] = {0};
+    __cpuidex(info, leafExtended, 0);
+    return (info[1] & (1 << avx2Bit)) != 0;
+#else
+    return false;
+#endif
+}
+
+static inline __m128i X86Dup(uint8_t value)
+{
+    return _mm_set1_epi16(value);
+}
+
+static inline __m128i X86Load8(const uint8_t* buf)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(buf)), _mm_setzero_si128());
+}
+
+// return Rgba8T::Multiply(a, b)
+static inline __m128i X86Multipling(__m128i a, __m128i b)
+{
+    __m128i calcType = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(X86_BASE_MSB));
+    return _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(calcType, X86_STEP_8), calcType), X86_STEP_8);
+}
+
+// return Rgba8T::Prelerp(p, q, a)
+static inline __m128i X86PreLerp(__m128i p, __m128i q, __m128i a)
+{
+    __m128i result = _mm_sub_epi16(_mm_add_epi16(p, q), X86Multipling(p, a));
+    return _mm_and_si128(result, _mm_set1_epi16(X86_BASE_MASK));
+}
+
+// return Rgba8T::Lerp(p, q, alpha), the product needs 32 bits
+static inline __m128i X86Lerp(__m128i p, __m128i q, __m128i alpha)
+{
+    __m128i diff = _mm_sub_epi16(q, p);
+    __m128i mulLow = _mm_mullo_epi16(diff, alpha);
+    __m128i mulHigh = _mm_mulhi_epi16(diff, alpha);
+    __m128i bias = _mm_add_epi16(_mm_set1_epi16(X86_BASE_MSB), _mm_cmpgt_epi16(p, q));
+    __m128i biasSign = _mm_srai_epi16(bias, 15); // 15: sign bit of int16_t
+    __m128i low = _mm_add_epi32(_mm_unpacklo_epi16(mulLow, mulHigh), _mm_unpacklo_epi16(bias, biasSign));
+    __m128i high = _mm_add_epi32(_mm_unpackhi_epi16(mulLow, mulHigh), _mm_unpackhi_epi16(bias, biasSign));
+    low = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(low, X86_STEP_8), low), X86_STEP_8);
+    high = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(high, X86_STEP_8), high), X86_STEP_8);
+    __m128i result = _mm_add_epi16(p, _mm_packs_epi32(low, high));
+    return _mm_and_si128(result, _mm_set1_epi16(X86_BASE_MASK));
+}
+
+X86_TARGET_AVX2 static inline __m128i X86LerpAvx2(__m128i p, __m128i q, __m128i alpha)
+{
+    __m256i p32 = _mm256_cvtepu16_epi32(p);
+    __m256i t = _mm256_mullo_epi32(_mm256_sub_epi32(_mm256_cvtepu16_epi32(q), p32), _mm256_cvtepu16_epi32(alpha));
+    __m256i bias = _mm256_add_epi32(_mm256_set1_epi32(X86_BASE_MSB), _mm256_cvtepi16_epi32(_mm_cmpgt_epi16(p, q)));
+    t = _mm256_add_epi32(t, bias);
+    t = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(t, X86_STEP_8), t), X86_STEP_8);
+    t = _mm256_and_si256(_mm256_add_epi32(p32, t), _mm256_set1_epi32(X86_BASE_MASK));
+    return _mm_packs_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+}
+
+// return a * b / 255
+static inline __m128i X86MulDiv255(__m128i a, __m128i b)
+{
+    __m128i mul = _mm_mullo_epi16(a, b);
+    // 257: 2^8 + 1; 8: number of shifts
+    __m128i round = _mm_srli_epi16(_mm_add_epi16(mul, _mm_set1_epi16(257)), X86_STEP_8);
+    return _mm_srli_epi16(_mm_add_epi16(mul, round), X86_STEP_8);
+}
+
+// return min(a / max(b, 1), 255), a is at most 16 bits and b is at most 8 bits.
+static inline __m128i X86DivInt(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    b = _mm_max_epi16(b, _mm_set1_epi16(1));
+    __m128 low = _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(a, zero)),
+                            _mm_cvtepi32_ps(_mm_unpacklo_epi16(b, zero)));
+    __m128 high = _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(a, zero)),
+                             _mm_cvtepi32_ps(_mm_unpackhi_epi16(b, zero)));
+    __m128i result = _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high));
+    return _mm_min_epi16(result, _mm_set1_epi16(X86_BASE_MASK));
+}
+
+X86_TARGET_AVX2 static inline __m128i X86DivIntAvx2(__m128i a, __m128i b)
+{
+    b = _mm_max_epi16(b, _mm_set1_epi16(1));
+    __m256 quotient = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(a)),
+                                    _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(b)));
+    __m256i result = _mm256_min_epi32(_mm256_cvttps_epi32(quotient), _mm256_set1_epi32(X86_BASE_MASK));
+    return _mm_packs_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1));
+}
+
+static inline void X86BlendRGBAWith(__m128i& r1, __m128i& g1, __m128i& b1, __m128i& a1,
+                                    __m128i r2, __m128i g2, __m128i b2, __m128i a2,
+                                    __m128i (*divInt)(__m128i, __m128i))
+{
+    __m128i da = X86MulDiv255(a1, _mm_sub_epi16(X86Dup(OPA_OPAQUE), a2));
+    a1 = _mm_and_si128(_mm_add_epi16(_mm_sub_epi16(a1, X86MulDiv255(a2, a1)), a2), _mm_set1_epi16(X86_BASE_MASK));
+    // r2 * a2 + r1 * da stays below 2^16
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(r2, a2), _mm_mullo_epi16(r1, da));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(g2, a2), _mm_mullo_epi16(g1, da));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(b2, a2), _mm_mullo_epi16(b1, da));
+    r1 = divInt(r, a1);
+    g1 = divInt(g, a1);
+    b1 = divInt(b, a1);
+}
+
+static inline void X86BlendRGBA(__m128i& r1, __m128i& g1, __m128i& b1, __m128i& a1,
+                                __m128i r2, __m128i g2, __m128i b2, __m128i a2)
+{
+    X86BlendRGBAWith(r1, g1, b1, a1, r2, g2, b2, a2, X86DivInt);
+}
+
+static inline void X86BlendRGBAAvx2(__m128i& r1, __m128i& g1, __m128i& b1, __m128i& a1,
+                                    __m128i r2, __m128i g2, __m128i b2, __m128i a2)
+{
+    X86BlendRGBAWith(r1, g1, b1, a1, r2, g2, b2, a2, X86DivIntAvx2);
+}
+
+// the destination alpha of RGB formats is not kept, the parameter only matches the pipeline signature
+static inline void X86BlendRGB(__m128i& r1, __m128i& g1, __m128i& b1, __m128i&,
+                               __m128i r2, __m128i g2, __m128i b2, __m128i a2)
+{
+    const __m128i mask = _mm_set1_epi16(X86_BASE_MASK);
+    __m128i da = _mm_sub_epi16(X86Dup(OPA_OPAQUE), a2);
+    r1 = _mm_min_epi16(_mm_add_epi16(X86MulDiv255(r2, a2), X86MulDiv255(r1, da)), mask);
+    g1 = _mm_min_epi16(_mm_add_epi16(X86MulDiv255(g2, a2), X86MulDiv255(g1, da)), mask);
+    b1 = _mm_min_epi16(_mm_add_epi16(X86MulDiv255(b2, a2), X86MulDiv255(b1, da)), mask);
+}
+
+static inline void LoadBuf_ARGB8888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a)
+{
+    const __m128i mask = _mm_set1_epi32(X86_BASE_MASK);
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf) + 1);
+    // 8, 16, 24: byte offset of green, red and alpha in one pixel
+    b = _mm_packs_epi32(_mm_and_si128(low, mask), _mm_and_si128(high, mask));
+    g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(low, 8), mask), _mm_and_si128(_mm_srli_epi32(high, 8), mask));
+    r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(low, 16), mask), _mm_and_si128(_mm_srli_epi32(high, 16), mask));
+    a = _mm_packs_epi32(_mm_srli_epi32(low, 24), _mm_srli_epi32(high, 24));
+}
+
+// RGB formats carry no alpha, the load and store functions leave it out
+static inline void LoadBuf_RGB888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i&)
+{
+    // SSE2 has no byte shuffle, de-interleave the 24 bytes once
+    const int32_t pixelBytes = 3;
+    uint16_t red[X86_PIXELS];
+    uint16_t green[X86_PIXELS];
+    uint16_t blue[X86_PIXELS];
+    for (int32_t i = 0; i < X86_PIXELS; i++) {
+        blue[i] = buf[i * pixelBytes];
+        green[i] = buf[i * pixelBytes + 1];
+        red[i] = buf[i * pixelBytes + 2]; // 2: red offset
+    }
+    r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(red));
+    g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(green));
+    b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blue));
+}
+
+static inline void LoadBuf_RGB565(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i&)
+{
+    const __m128i mask = _mm_set1_epi16(X86_BASE_MASK);
+    __m128i vBuf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+    // 3: RRRRRGGG|GGGBBBBB => RRGGGGGG|BBBBB000
+    b = _mm_and_si128(_mm_slli_epi16(vBuf, 3), mask);
+    // 5, 2: RRRRRGGG|GGGBBBBB => XXXRRRRR|GGGGGG00
+    g = _mm_and_si128(_mm_slli_epi16(_mm_srli_epi16(vBuf, 5), 2), mask);
+    // 11, 3: RRRRRGGG|GGGBBBBB => XXXXXXXX|RRRRR000
+    r = _mm_slli_epi16(_mm_srli_epi16(vBuf, 11), 3);
+}
+
+static inline void LoadBufA_ARGB8888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a, uint8_t opa)
+{
+    LoadBuf_ARGB8888(buf, r, g, b, a);
+    a = X86MulDiv255(a, X86Dup(opa));
+}
+
+static inline void LoadBufA_RGB888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a, uint8_t opa)
+{
+    LoadBuf_RGB888(buf, r, g, b, a);
+    a = X86Dup(opa);
+}
+
+static inline void LoadBufA_RGB565(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a, uint8_t opa)
+{
+    LoadBuf_RGB565(buf, r, g, b, a);
+    a = X86Dup(opa);
+}
+
+static inline void StoreBuf_ARGB8888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i& a)
+{
+    __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, X86_STEP_8));
+    __m128i ra = _mm_or_si128(r, _mm_slli_epi16(a, X86_STEP_8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf) + 1, _mm_unpackhi_epi16(bg, ra));
+}
+
+static inline void StoreBuf_RGB888(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i&)
+{
+    const int32_t pixelBytes = 3;
+    uint16_t red[X86_PIXELS];
+    uint16_t green[X86_PIXELS];
+    uint16_t blue[X86_PIXELS];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(red), r);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(green), g);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(blue), b);
+    for (int32_t i = 0; i < X86_PIXELS; i++) {
+        buf[i * pixelBytes] = static_cast<uint8_t>(blue[i]);
+        buf[i * pixelBytes + 1] = static_cast<uint8_t>(green[i]);
+        buf[i * pixelBytes + 2] = static_cast<uint8_t>(red[i]); // 2: red offset
+    }
+}
+
+static inline void StoreBuf_RGB565(uint8_t* buf, __m128i& r, __m128i& g, __m128i& b, __m128i&)
+{
+    // 0xF8, 0xFC, 8, 3: RRRRR000 << 8 | GGGGGG00 << 3 | BBBBB000 >> 3 => RRRRRGGG|GGGBBBBB
+    __m128i vBuf = _mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xF8)), 8);
+    vBuf = _mm_or_si128(vBuf, _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3));
+    vBuf = _mm_or_si128(vBuf, _mm_srli_epi16(b, 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), vBuf);
+}
+} // namespace OHOS
+#endif
+#endif
@@ -503,6 +503,14 @@ struct Rgba8T {
         Convert(*this, color);
     }
 
+    /**
+     * @brief Copies the channels of another Rgba8T
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    Rgba8T& operator=(const Rgba8T& color) = default;
+
     /**
      * @brief Overloaded RGBA function
      *
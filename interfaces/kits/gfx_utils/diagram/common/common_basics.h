@@ -67,6 +67,15 @@ enum PatternRepeatMode {
     NO_REPEAT,
 };
 
+/**
+ * nearest Take the texel under the pixel center
+ * bilinear Weight the four texels around the pixel center
+ */
+enum PatternFilterMode {
+    PATTERN_FILTER_NEAREST,
+    PATTERN_FILTER_BILINEAR,
+};
+
 /**
  * @brief Sub - pixel offset and mask flag
  * @since 1.0
@@ -364,6 +373,69 @@ inline uint32_t GetCloseFlag(uint32_t val)
     return val & PATH_FLAGS_CLOSE;
 }
 
+/**
+ * @brief A vertex with its path command, the unit of the block interface GenerateVertices.
+ * @since 1.0
+ * @version 1.0
+ */
+struct PathVertex {
+    float x;
+    float y;
+    uint32_t cmd;
+};
+
+/**
+ * @brief Number of vertices AddPath takes from a vertex source at a time.
+ */
+const uint32_t VERTEX_BATCH_SIZE = 32;
+
+/**
+ * @brief Block interface of a vertex source built on its GenerateVertex.
+ * Vertex sources provide GenerateVertices(vertices, maxNum) next to GenerateVertex: it stores up to maxNum
+ * vertices and returns their number, less than maxNum only when the path has ended. The stop command is not stored.
+ * Sources without a faster way to produce a block forward to this loop.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class VertexSource>
+uint32_t GenerateVerticesByVertex(VertexSource& source, PathVertex* vertices, uint32_t maxNum)
+{
+    uint32_t num = 0;
+    for (; num < maxNum; num++) {
+        uint32_t cmd = source.GenerateVertex(&vertices[num].x, &vertices[num].y);
+        if (IsStop(cmd)) {
+            break;
+        }
+        vertices[num].cmd = cmd;
+    }
+    return num;
+}
+
+template <class VertexSource>
+auto GenerateSourceVertices(VertexSource& source, PathVertex* vertices, uint32_t maxNum, int)
+    -> decltype(source.GenerateVertices(vertices, maxNum))
+{
+    return source.GenerateVertices(vertices, maxNum);
+}
+
+template <class VertexSource>
+uint32_t GenerateSourceVertices(VertexSource& source, PathVertex* vertices, uint32_t maxNum, long)
+{
+    return GenerateVerticesByVertex(source, vertices, maxNum);
+}
+
+/**
+ * @brief Takes up to maxNum vertices from a vertex source through its GenerateVertices,
+ * sources that only provide GenerateVertex go through GenerateVerticesByVertex.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class VertexSource>
+uint32_t GenerateSourceVertices(VertexSource& source, PathVertex* vertices, uint32_t maxNum)
+{
+    return GenerateSourceVertices(source, vertices, maxNum, 0);
+}
+
 template <class T>
 struct GeometryArrayAllocator {
     /**
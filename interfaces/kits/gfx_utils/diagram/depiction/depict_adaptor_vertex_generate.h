@@ -186,6 +186,14 @@ public:
      * @version 1.0
      */
     uint32_t GenerateVertex(float* x, float* y);
+
+    /**
+     * @brief Returns up to maxNum generated vertices, the vertices of a generated path are taken from
+     * the generator a block at a time.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
     /**
      * @brief Move vertices or generate new vertices according to accumulate state while func
      * @since 1.0
@@ -208,6 +216,29 @@ private:
     float startY_;
 };
 
+template <class VertexSource, class Generator, class Markers>
+uint32_t DepictAdaptorVertexGenerate<VertexSource, Generator, Markers>::GenerateVertices(PathVertex* vertices,
+                                                                                         uint32_t maxNum)
+{
+    uint32_t num = 0;
+    while (num < maxNum) {
+        if (status_ == GENERATE) {
+            num += GenerateSourceVertices(generator_, vertices + num, maxNum - num);
+            if (num == maxNum) {
+                break;
+            }
+            status_ = ACCUMULATE;
+        }
+        /* Accumulates the next path of the source and returns its first generated vertex */
+        uint32_t cmd = GenerateVertex(&vertices[num].x, &vertices[num].y);
+        if (IsStop(cmd)) {
+            break;
+        }
+        vertices[num++].cmd = cmd;
+    }
+    return num;
+}
+
 /**
  * @brief Move vertices or generate new vertices according to different states
  * Return to the current operation status for subsequent processing
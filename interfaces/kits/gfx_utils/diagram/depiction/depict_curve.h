@@ -29,6 +29,7 @@
 #include "gfx_utils/diagram/common/common_basics.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_curves.h"
 #include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+#include "gfx_utils/trans_affine.h"
 
 namespace OHOS {
 /**
@@ -49,7 +50,8 @@ public:
      * @version 1.0
      */
     explicit DepictCurve(UICanvasVertices& source)
-        : source_(&source), lastX_(0), lastY_(0) {}
+        : source_(&source), lastX_(0), lastY_(0), sourceIndex_(0), cullEnabled_(false),
+          cullX1_(0), cullY1_(0), cullX2_(0), cullY2_(0), culledCurves_(0), culledSubpaths_(0) {}
 
     void Attach(UICanvasVertices& source)
     {
@@ -98,6 +100,17 @@ public:
         return cubicBezier_.ApproximationScale();
     }
 
+    /**
+     * @brief Derives the approximation scale from the transform the curve is drawn with,
+     * so that the vertex count follows the size on the screen, see TransAffine::GetApproximationScale.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ApproximationScale(const TransAffine& transform)
+    {
+        ApproximationScale(transform.GetApproximationScale());
+    }
+
     /**
      * @brief Sets the angle estimate in radians. The less this value,
      * the more accurate the estimation at the turn of the curve.
@@ -135,6 +148,53 @@ public:
     {
         return cubicBezier_.CuspLimit();
     }
+
+    /**
+     * @brief Culls curves and subpaths outside of the box, the box is in the coordinates of the path.
+     * A curve whose control points all lie beyond one edge of the box becomes the line to its end point,
+     * a subpath whose vertices all lie beyond one edge is skipped. Neither encloses a point of the box,
+     * so a fill clipped to the box, e.g. by RasterizerScanlineAntialias::ClipBox, covers the same pixels.
+     * The outline outside of the box does change, a stroke needs the box widened by its extent first.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCullBox(float x1, float y1, float x2, float y2);
+
+    /**
+     * @brief Culls against a clip box in the coordinates after transform, like the clip box of the rasterizer
+     * behind a DepictTransform. The box of the path is the bounds of the clip box mapped back, a transform
+     * which can not be inverted turns culling off.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCullBox(float x1, float y1, float x2, float y2, const TransAffine& transform);
+
+    void ResetCullBox()
+    {
+        cullEnabled_ = false;
+    }
+
+    /**
+     * @brief Number of curves replaced by a line since the last ResetCullCounters.
+     */
+    uint32_t GetCulledCurveCount() const
+    {
+        return culledCurves_;
+    }
+
+    /**
+     * @brief Number of subpaths skipped since the last ResetCullCounters.
+     */
+    uint32_t GetCulledSubpathCount() const
+    {
+        return culledSubpaths_;
+    }
+
+    void ResetCullCounters()
+    {
+        culledCurves_ = 0;
+        culledSubpaths_ = 0;
+    }
     /**
      * Reset the status attribute of a path segment
      * @path_id Is a path ID, calculated from 0
@@ -150,13 +210,41 @@ public:
      */
     uint32_t GenerateVertex(float* x, float* y);
 
+    /**
+     * Returns up to maxNum vertices with the curves flattened, see GenerateVerticesByVertex
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
+
 private:
     DepictCurve(const DepictCurve&);
     const DepictCurve& operator=(const DepictCurve&);
 
+    uint32_t NextSourceVertex(float* x, float* y)
+    {
+        sourceIndex_++;
+        return source_->GenerateVertex(x, y);
+    }
+
+    bool IsCulled(float minX, float minY, float maxX, float maxY) const
+    {
+        return maxX < cullX1_ || minX > cullX2_ || maxY < cullY1_ || minY > cullY2_;
+    }
+
+    bool SkipSubpath();
+
     UICanvasVertices* source_;
     float lastX_;
     float lastY_;
+    uint32_t sourceIndex_;
+    bool cullEnabled_;
+    float cullX1_;
+    float cullY1_;
+    float cullX2_;
+    float cullY2_;
+    uint32_t culledCurves_;
+    uint32_t culledSubpaths_;
     QuadraticBezierCurve quadraticBezier_;
     CubicBezierCurve cubicBezier_;
 };
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file depict_curve_lod.h
+ * @brief Defines the cache of flattened curves at a few levels of detail
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_DEPICT_CURVE_LOD_H
+#define GRAPHIC_LITE_DEPICT_CURVE_LOD_H
+
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief Number of levels of detail one DepictCurveLod keeps.
+ */
+const uint32_t CURVE_LOD_LEVELS = 4;
+/**
+ * @brief Levels per doubling of the approximation scale, a level flattens for at most 2^(1/4) times
+ * more or less than the scale asked for.
+ */
+const int32_t CURVE_LOD_LEVELS_PER_OCTAVE = 2;
+
+/**
+ * @brief Flattens the curves of a path like DepictCurve and keeps the polylines of the last
+ * CURVE_LOD_LEVELS levels of detail, so that a path drawn across frames is flattened once per level.
+ * The approximation scale is quantized to half octaves, a level is flattened on the first use and the
+ * least recently used one makes room. Call Invalidate after the path changed.
+ * A flattened level costs 12 bytes per vertex, a scale between levels rounds to the nearest one.
+ * Drawing with a transform typically looks like
+ * lod.ApproximationScale(transform), DepictTransform<DepictCurveLod> transformed(lod, transform), AddPath.
+ * @since 1.0
+ * @version 1.0
+ */
+class DepictCurveLod : public HeapBase {
+public:
+    explicit DepictCurveLod(UICanvasVertices& source);
+
+    ~DepictCurveLod();
+
+    /**
+     * @brief Uses another path, every cached level is dropped.
+     */
+    void Attach(UICanvasVertices& source);
+
+    /**
+     * @brief Drops the cached levels, the buffers are kept for the next flattening.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Selects the level of detail for the scale, flattening it if it is not cached.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ApproximationScale(float scale);
+
+    /**
+     * @brief Selects the level of detail for the transform the path is drawn with.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ApproximationScale(const TransAffine& transform)
+    {
+        ApproximationScale(transform.GetApproximationScale());
+    }
+
+    /**
+     * @brief Returns the quantized scale the current level is flattened with.
+     */
+    float ApproximationScale() const;
+
+    /**
+     * @brief Starts at vertex pathId of the current level, a level dropped by Invalidate is flattened again.
+     * Without a selected level the path is flattened at scale 1.
+     * @since 1.0
+     * @version 1.0
+     */
+    void Rewind(uint32_t pathId);
+
+    uint32_t GenerateVertex(float* x, float* y)
+    {
+        const LodLevel& level = levels_[current_];
+        if (iterator_ >= level.num) {
+            return PATH_CMD_STOP;
+        }
+        *x = level.vertices[iterator_].x;
+        *y = level.vertices[iterator_].y;
+        return level.vertices[iterator_++].cmd;
+    }
+
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
+
+    uint32_t GetHitCount() const
+    {
+        return hitCount_;
+    }
+
+    uint32_t GetMissCount() const
+    {
+        return missCount_;
+    }
+
+    /**
+     * @brief Maps a scale to its level, levels are CURVE_LOD_LEVELS_PER_OCTAVE per doubling around level 0 at 1.
+     */
+    static int32_t GetLevel(float scale);
+
+    static float GetLevelScale(int32_t level);
+
+private:
+    DepictCurveLod(const DepictCurveLod&);
+    DepictCurveLod& operator=(const DepictCurveLod&);
+
+    struct LodLevel {
+        PathVertex* vertices;
+        uint32_t num;
+        uint32_t capacity;
+        uint32_t lastUse;
+        int32_t level;
+        bool valid;
+    };
+
+    bool Flatten(LodLevel& level);
+
+    UICanvasVertices* source_;
+    LodLevel levels_[CURVE_LOD_LEVELS];
+    uint32_t current_;
+    uint32_t iterator_;
+    uint32_t useCount_;
+    uint32_t hitCount_;
+    uint32_t missCount_;
+};
+} // namespace OHOS
+#endif
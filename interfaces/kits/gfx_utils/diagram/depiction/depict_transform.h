@@ -61,12 +61,52 @@ public:
     uint32_t GenerateVertex(float* x, float* y)
     {
         uint32_t cmd = source_->GenerateVertex(x, y);
-        if (IsVertex(cmd)) {
+        if (IsVertex(cmd) && trans_->GetType() != TRANS_AFFINE_IDENTITY) {
             trans_->Transform(x, y);
         }
         return cmd;
     }
 
+    /**
+     * @brief Takes a block of vertices from the source and transforms it in place.
+     * Identity blocks pass through, translations and scales skip the zero terms of the matrix.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        uint32_t num = GenerateSourceVertices(*source_, vertices, maxNum);
+        const float* data = trans_->GetData();
+        switch (trans_->GetType()) {
+            case TRANS_AFFINE_IDENTITY:
+                break;
+            case TRANS_AFFINE_TRANSLATE:
+                for (uint32_t i = 0; i < num; i++) {
+                    if (IsVertex(vertices[i].cmd)) {
+                        vertices[i].x += data[2]; // 2: x translation
+                        vertices[i].y += data[5]; // 5: y translation
+                    }
+                }
+                break;
+            case TRANS_AFFINE_SCALE:
+                for (uint32_t i = 0; i < num; i++) {
+                    if (IsVertex(vertices[i].cmd)) {
+                        vertices[i].x = vertices[i].x * data[0] + data[2]; // 0: x scale, 2: x translation
+                        vertices[i].y = vertices[i].y * data[4] + data[5]; // 4: y scale, 5: y translation
+                    }
+                }
+                break;
+            default:
+                for (uint32_t i = 0; i < num; i++) {
+                    if (IsVertex(vertices[i].cmd)) {
+                        trans_->Transform(&vertices[i].x, &vertices[i].y);
+                    }
+                }
+                break;
+        }
+        return num;
+    }
+
     void GetTransformer(TransAffine& tr)
     {
         trans_ = &tr;
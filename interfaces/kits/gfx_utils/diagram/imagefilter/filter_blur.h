@@ -15,9 +15,13 @@
 #ifndef GRAPHIC_LITE_FILTER_BLUR_H
 #define GRAPHIC_LITE_FILTER_BLUR_H
 
+#include <cmath>
+
+#include "gfx_utils/color.h"
 #include "gfx_utils/diagram/common/common_basics.h"
 #include "gfx_utils/graphic_math.h"
 #include "graphic_config.h"
+#include "graphic_mutex.h"
 #include "securec.h"
 
 namespace OHOS {
@@ -25,11 +29,26 @@ class Filterblur {
 #if GRAPHIC_ENABLE_BLUR_EFFECT_FLAG
 
 public:
+    /**
+     * @brief Algorithm used by BoxBlur.
+     * BLUR_MODE_INTEGRAL builds an integral image of (width + 1) * (height + 1) * channel int32_t,
+     * BLUR_MODE_SEPARABLE runs a horizontal and a vertical sliding window and only needs O(width + height) scratch.
+     * @since 1.0
+     * @version 1.0
+     */
+    enum BlurMode {
+        BLUR_MODE_INTEGRAL,
+        BLUR_MODE_SEPARABLE
+    };
+
     Filterblur()
     {
         integral_ = nullptr;
         imageWidth_ = 0;
         imageHeight_ = 0;
+        blurMode_ = BLUR_MODE_INTEGRAL;
+        boxBlurPasses_ = 1;
+        premultiplied_ = false;
     }
     ~Filterblur()
     {
@@ -38,12 +57,32 @@ public:
         }
     }
 
+    void SetBlurMode(BlurMode mode)
+    {
+        blurMode_ = mode;
+    }
+
+    /**
+     * @brief Set how many times the separable box blur is applied, three passes approximate a gaussian blur.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetBoxBlurPasses(uint8_t passes)
+    {
+        boxBlurPasses_ = MATH_MAX(MATH_MIN(passes, static_cast<uint8_t>(MAX_BOX_BLUR_PASSES)), 1);
+    }
+
     template <class Img>
     void BoxBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride)
     {
         if (radius < 1) {
             return;
         }
+        if (blurMode_ == BLUR_MODE_SEPARABLE) {
+            SeparableBoxBlur((uint8_t*)img.PixValuePtr(0, 0), img.GetWidth(), img.GetHeight(),
+                             radius, channel, stride);
+            return;
+        }
         int32_t width = img.GetWidth();
         int32_t height = img.GetHeight();
         bool isGetRGBAIntegral = false;
@@ -90,7 +129,476 @@ public:
             }
         }
     }
+    /**
+     * @brief Tell GaussianBlur and StackBlur whether the colors of four channel images are already
+     * multiplied by alpha. Otherwise they are premultiplied before and restored after blurring,
+     * so transparent pixels do not bleed their color into the soft edge.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetPremultiplied(bool premultiplied)
+    {
+        premultiplied_ = premultiplied;
+    }
+
+    /**
+     * @brief Gaussian blur of all channels, sigma is a third of the radius.
+     * channel may be 1 (A8 mask), 3 (RGB888) or 4 (ARGB8888 with alpha in the last byte).
+     * The kernel weights are kept in a process-wide cache keyed by radius.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Img>
+    void GaussianBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride)
+    {
+        KernelBlur((uint8_t*)img.PixValuePtr(0, 0), img.GetWidth(), img.GetHeight(),
+                   radius, channel, stride, KERNEL_GAUSSIAN);
+    }
+
+    /**
+     * @brief Stack blur of all channels, a triangle kernel computed with running sums
+     * whose cost does not depend on the radius. Channels are handled as in GaussianBlur.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Img>
+    void StackBlur(Img& img, uint16_t radius, int32_t channel, int32_t stride)
+    {
+        KernelBlur((uint8_t*)img.PixValuePtr(0, 0), img.GetWidth(), img.GetHeight(),
+                   radius, channel, stride, KERNEL_STACK);
+    }
+
+    /**
+     * @brief Box blur of the color channels by running sums, the alpha of four channel images is kept.
+     * Every pass averages the pixels of the window clipped to the image, as the integral mode does.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SeparableBoxBlur(uint8_t* buf, int32_t width, int32_t height, uint16_t radius,
+                          int32_t channel, int32_t stride)
+    {
+        if (buf == nullptr || width <= 0 || height <= 0 || channel <= 0 || channel > FOUR_TIMES) {
+            return;
+        }
+        int32_t maxWindow = MATH_MIN(TWO_TIMES * radius + 1, MATH_MAX(width, height));
+        uint64_t* reciprocal = (uint64_t*)malloc((maxWindow + 1) * sizeof(uint64_t));
+        if (reciprocal == nullptr) {
+            return;
+        }
+        // (sum + n / 2) * reciprocal[n] >> 48 is the rounded average without a division. It is exact
+        // while 256 * n * n <= 2^48, that is for windows up to 2^20 pixels, and radius is below 2^16.
+        reciprocal[0] = 0;
+        for (int32_t n = 1; n <= maxWindow; n++) {
+            reciprocal[n] = ((1ULL << RECIPROCAL_SHIFT) + n - 1) / n;
+        }
+        int32_t blurChannel = (channel == FOUR_TIMES) ? THREE_TIMES : channel;
+        for (uint8_t pass = 0; pass < boxBlurPasses_; pass++) {
+            BoxBlurRows(buf, width, height, radius, channel, blurChannel, stride, reciprocal);
+            BoxBlurColumns(buf, width, height, radius, channel, blurChannel, stride, reciprocal);
+        }
+        free(reciprocal);
+    }
+
 private:
+    static constexpr uint8_t MAX_BOX_BLUR_PASSES = 3;
+    static constexpr int32_t RECIPROCAL_SHIFT = 48;
+    static constexpr int32_t COLUMN_STRIP = 16;
+
+    static inline uint8_t WindowAverage(int32_t sum, int32_t count, const uint64_t* reciprocal)
+    {
+        return (uint8_t)(((uint64_t)(sum + (count >> 1)) * reciprocal[count]) >> RECIPROCAL_SHIFT);
+    }
+
+    void BoxBlurRows(uint8_t* buf, int32_t width, int32_t height, int32_t radius, int32_t channel,
+                     int32_t blurChannel, int32_t stride, const uint64_t* reciprocal)
+    {
+#pragma omp parallel
+        {
+            uint8_t* line = (uint8_t*)malloc(width * channel);
+#pragma omp for
+            for (int32_t y = 0; y < height; y++) {
+                if (line == nullptr) {
+                    continue;
+                }
+                uint8_t* linePD = buf + y * stride;
+                if (memcpy_s(line, width * channel, linePD, width * channel) != EOK) {
+                    continue;
+                }
+                int32_t sum[FOUR_TIMES] = {0};
+                int32_t first = MATH_MIN(radius, width - 1);
+                for (int32_t x = 0; x <= first; x++) {
+                    for (int32_t c = 0; c < blurChannel; c++) {
+                        sum[c] += line[x * channel + c];
+                    }
+                }
+                for (int32_t x = 0; x < width; x++) {
+                    int32_t count = MATH_MIN(x + radius + 1, width) - MATH_MAX(x - radius, 0);
+                    int32_t addIndex = (x + radius + 1 < width) ? (x + radius + 1) * channel : -1;
+                    int32_t subIndex = (x - radius >= 0) ? (x - radius) * channel : -1;
+                    for (int32_t c = 0; c < blurChannel; c++) {
+                        linePD[x * channel + c] = WindowAverage(sum[c], count, reciprocal);
+                        sum[c] += (addIndex >= 0) ? line[addIndex + c] : 0;
+                        sum[c] -= (subIndex >= 0) ? line[subIndex + c] : 0;
+                    }
+                }
+            }
+            free(line);
+        }
+    }
+
+    void BoxBlurColumns(uint8_t* buf, int32_t width, int32_t height, int32_t radius, int32_t channel,
+                        int32_t blurChannel, int32_t stride, const uint64_t* reciprocal)
+    {
+        int32_t stripNum = (width + COLUMN_STRIP - 1) / COLUMN_STRIP;
+#pragma omp parallel
+        {
+            // a strip of COLUMN_STRIP columns is copied out, so every row of it is read contiguously
+            uint8_t* strip = (uint8_t*)malloc(height * COLUMN_STRIP * channel);
+#pragma omp for
+            for (int32_t s = 0; s < stripNum; s++) {
+                if (strip == nullptr) {
+                    continue;
+                }
+                int32_t x0 = s * COLUMN_STRIP;
+                int32_t lanes = MATH_MIN(COLUMN_STRIP, width - x0) * channel;
+                for (int32_t y = 0; y < height; y++) {
+                    if (memcpy_s(strip + y * lanes, lanes, buf + y * stride + x0 * channel, lanes) != EOK) {
+                        break;
+                    }
+                }
+                int32_t sum[COLUMN_STRIP * FOUR_TIMES] = {0};
+                int32_t first = MATH_MIN(radius, height - 1);
+                for (int32_t y = 0; y <= first; y++) {
+                    for (int32_t k = 0; k < lanes; k++) {
+                        sum[k] += strip[y * lanes + k];
+                    }
+                }
+                for (int32_t y = 0; y < height; y++) {
+                    int32_t count = MATH_MIN(y + radius + 1, height) - MATH_MAX(y - radius, 0);
+                    uint8_t* linePD = buf + y * stride + x0 * channel;
+                    const uint8_t* lineAdd = (y + radius + 1 < height) ? strip + (y + radius + 1) * lanes : nullptr;
+                    const uint8_t* lineSub = (y - radius >= 0) ? strip + (y - radius) * lanes : nullptr;
+                    for (int32_t k = 0; k < lanes; k++) {
+                        linePD[k] = WindowAverage(sum[k], count, reciprocal);
+                    }
+                    for (int32_t k = 0; lineAdd != nullptr && k < lanes; k++) {
+                        sum[k] += lineAdd[k];
+                    }
+                    for (int32_t k = 0; lineSub != nullptr && k < lanes; k++) {
+                        sum[k] -= lineSub[k];
+                    }
+                    if (blurChannel != channel) {
+                        // restore the alpha lanes that were averaged along with the colors
+                        const uint8_t* alpha = strip + y * lanes;
+                        for (int32_t k = blurChannel; k < lanes; k += channel) {
+                            linePD[k] = alpha[k];
+                        }
+                    }
+                }
+            }
+            free(strip);
+        }
+    }
+
+    enum BlurKernelType {
+        KERNEL_GAUSSIAN,
+        KERNEL_STACK
+    };
+
+    struct BlurKernel {
+        uint16_t radius;
+        uint16_t refCount;
+        uint32_t lastUse;
+        uint32_t* weights;
+    };
+
+    static constexpr int32_t KERNEL_CACHE_SIZE = 8;
+    static constexpr int32_t KERNEL_WEIGHT_SHIFT = 16;
+    static constexpr float KERNEL_SIGMA_RATIO = 3.0f;
+    static constexpr int32_t ALPHA_INDEX = 3;
+
+    struct BlurKernelCache {
+        BlurKernel kernels[KERNEL_CACHE_SIZE];
+        uint32_t useCount;
+        GraphicMutex mutex;
+    };
+
+    static BlurKernelCache& GetKernelCache()
+    {
+        static BlurKernelCache cache = {};
+        return cache;
+    }
+
+    /**
+     * Returns the gaussian weights of radius (2 * radius + 1 entries summing to 1 << 16), computing and caching
+     * them on a miss. The least recently used kernel nobody holds is replaced when the cache is full, and if every
+     * kernel is held the weights are built into a table of the caller. Must be paired with ReleaseGaussianKernel.
+     */
+    static const uint32_t* AcquireGaussianKernel(uint16_t radius)
+    {
+        BlurKernelCache& cache = GetKernelCache();
+        cache.mutex.Lock();
+        int32_t slot = -1;
+        for (int32_t i = 0; i < KERNEL_CACHE_SIZE; i++) {
+            BlurKernel& kernel = cache.kernels[i];
+            if (kernel.weights != nullptr && kernel.radius == radius) {
+                kernel.refCount++;
+                kernel.lastUse = ++cache.useCount;
+                cache.mutex.Unlock();
+                return kernel.weights;
+            }
+            if (kernel.refCount > 0) {
+                continue;
+            }
+            // an empty slot is taken first, otherwise the least recently used one
+            if (slot < 0 || (cache.kernels[slot].weights != nullptr &&
+                (kernel.weights == nullptr || kernel.lastUse < cache.kernels[slot].lastUse))) {
+                slot = i;
+            }
+        }
+        uint32_t* weights = (uint32_t*)malloc((TWO_TIMES * radius + 1) * sizeof(uint32_t));
+        if (weights == nullptr) {
+            cache.mutex.Unlock();
+            return nullptr;
+        }
+        BuildGaussianKernel(radius, weights);
+        if (slot >= 0) {
+            BlurKernel& kernel = cache.kernels[slot];
+            free(kernel.weights);
+            kernel.radius = radius;
+            kernel.refCount = 1;
+            kernel.lastUse = ++cache.useCount;
+            kernel.weights = weights;
+        }
+        cache.mutex.Unlock();
+        return weights;
+    }
+
+    static void ReleaseGaussianKernel(const uint32_t* weights)
+    {
+        if (weights == nullptr) {
+            return;
+        }
+        BlurKernelCache& cache = GetKernelCache();
+        cache.mutex.Lock();
+        for (int32_t i = 0; i < KERNEL_CACHE_SIZE; i++) {
+            if (cache.kernels[i].weights == weights) {
+                cache.kernels[i].refCount--;
+                cache.mutex.Unlock();
+                return;
+            }
+        }
+        cache.mutex.Unlock();
+        free(const_cast<uint32_t*>(weights));
+    }
+
+    static void BuildGaussianKernel(uint16_t radius, uint32_t* weights)
+    {
+        float sigma = MATH_MAX(radius / KERNEL_SIGMA_RATIO, 0.5f); // 0.5: keep a narrow kernel for radius 1
+        float factor = -1.0f / (TWO_TIMES * sigma * sigma);
+        float total = 0;
+        for (int32_t i = -radius; i <= radius; i++) {
+            total += expf(i * i * factor);
+        }
+        uint32_t sum = 0;
+        for (int32_t i = -radius; i <= radius; i++) {
+            weights[i + radius] = (uint32_t)((expf(i * i * factor) / total) * (1 << KERNEL_WEIGHT_SHIFT));
+            sum += weights[i + radius];
+        }
+        // rounding leftovers go to the center so that a flat image stays flat
+        weights[radius] += (1 << KERNEL_WEIGHT_SHIFT) - sum;
+    }
+
+    void KernelBlur(uint8_t* buf, int32_t width, int32_t height, uint16_t radius,
+                    int32_t channel, int32_t stride, BlurKernelType type)
+    {
+        if (buf == nullptr || radius < 1 || width <= 0 || height <= 0 ||
+            (channel != 1 && channel != THREE_TIMES && channel != FOUR_TIMES)) {
+            return;
+        }
+        const uint32_t* weights = nullptr;
+        if (type == KERNEL_GAUSSIAN) {
+            weights = AcquireGaussianKernel(radius);
+            if (weights == nullptr) {
+                return;
+            }
+        }
+        // colors are weighted by alpha while they are summed, so no precision is lost by premultiplying in 8 bits
+        bool weightByAlpha = (channel == FOUR_TIMES) && !premultiplied_;
+        KernelBlurRows(buf, width, height, radius, channel, stride, weights, weightByAlpha);
+        KernelBlurColumns(buf, width, height, radius, channel, stride, weights, weightByAlpha);
+        ReleaseGaussianKernel(weights);
+    }
+
+    /**
+     * Widens a pixel for summing, colors are multiplied by alpha into 16 bits when weightByAlpha is set.
+     */
+    static inline void LoadKernelPixel(const uint8_t* pixel, uint16_t* value, int32_t channel, bool weightByAlpha)
+    {
+        if (!weightByAlpha) {
+            for (int32_t c = 0; c < channel; c++) {
+                value[c] = pixel[c];
+            }
+            return;
+        }
+        for (int32_t c = 0; c < ALPHA_INDEX; c++) {
+            value[c] = pixel[c] * pixel[ALPHA_INDEX];
+        }
+        value[ALPHA_INDEX] = pixel[ALPHA_INDEX];
+    }
+
+    /**
+     * Writes the sums of a pixel whose weights add up to total. With weightByAlpha the color sums are
+     * divided by the alpha sum, which restores the straight colors in a single rounding.
+     */
+    template <class T>
+    static inline void StoreKernelPixel(const T* sum, T total, uint8_t* dst, int32_t channel, bool weightByAlpha)
+    {
+        if (!weightByAlpha) {
+            for (int32_t c = 0; c < channel; c++) {
+                dst[c] = (uint8_t)((sum[c] + (total >> 1)) / total);
+            }
+            return;
+        }
+        T alphaSum = sum[ALPHA_INDEX];
+        for (int32_t c = 0; c < ALPHA_INDEX; c++) {
+            dst[c] = (alphaSum == 0) ? 0 : (uint8_t)MATH_MIN((sum[c] + (alphaSum >> 1)) / alphaSum,
+                                                             (T)OPA_OPAQUE);
+        }
+        dst[ALPHA_INDEX] = (uint8_t)((alphaSum + (total >> 1)) / total);
+    }
+
+    /**
+     * Blurs the n widened pixels of src into dst, pixels of dst are dstStep bytes apart.
+     * Edge pixels are repeated outside of the line.
+     */
+    static void KernelBlurLine(const uint16_t* src, int32_t n, uint8_t* dst, int32_t dstStep,
+                               int32_t channel, int32_t radius, const uint32_t* weights, bool weightByAlpha)
+    {
+        if (weights != nullptr) {
+            for (int32_t i = 0; i < n; i++) {
+                // the weights add up to 1 << 16, so even alpha weighted colors fit 32 bits
+                uint32_t sum[FOUR_TIMES] = {0};
+                if (i >= radius && i + radius < n) {
+                    const uint16_t* pixel = src + (i - radius) * channel;
+                    for (int32_t k = 0; k <= TWO_TIMES * radius; k++, pixel += channel) {
+                        for (int32_t c = 0; c < channel; c++) {
+                            sum[c] += weights[k] * pixel[c];
+                        }
+                    }
+                } else {
+                    for (int32_t k = -radius; k <= radius; k++) {
+                        const uint16_t* pixel = src + MATH_MIN(MATH_MAX(i + k, 0), n - 1) * channel;
+                        for (int32_t c = 0; c < channel; c++) {
+                            sum[c] += weights[k + radius] * pixel[c];
+                        }
+                    }
+                }
+                StoreKernelPixel(sum, (uint32_t)(1 << KERNEL_WEIGHT_SHIFT), dst + i * dstStep, channel, weightByAlpha);
+            }
+            return;
+        }
+        // 32 bit sums are faster but only hold the triangle weights of small radii, 1: room for the rounding
+        uint64_t maxValue = weightByAlpha ? OPA_OPAQUE * (OPA_OPAQUE + 1) : OPA_OPAQUE + 1;
+        if ((uint64_t)(radius + 1) * (radius + 1) * maxValue <= UINT32_MAX) {
+            StackBlurLine<uint32_t>(src, n, dst, dstStep, channel, radius, weightByAlpha);
+        } else {
+            StackBlurLine<uint64_t>(src, n, dst, dstStep, channel, radius, weightByAlpha);
+        }
+    }
+
+    /**
+     * The triangle weights of the stack blur are kept as sumIn (rising edge) and sumOut (falling edge),
+     * T must hold (radius + 1) * (radius + 1) times the largest widened pixel.
+     */
+    template <class T>
+    static void StackBlurLine(const uint16_t* src, int32_t n, uint8_t* dst, int32_t dstStep,
+                              int32_t channel, int32_t radius, bool weightByAlpha)
+    {
+        T divisor = (T)(radius + 1) * (radius + 1);
+        T sum[FOUR_TIMES] = {0};
+        T sumIn[FOUR_TIMES] = {0};
+        T sumOut[FOUR_TIMES] = {0};
+        for (int32_t k = -radius; k <= radius; k++) {
+            const uint16_t* pixel = src + MATH_MIN(MATH_MAX(k, 0), n - 1) * channel;
+            T weight = radius + 1 - MATH_ABS(k);
+            for (int32_t c = 0; c < channel; c++) {
+                sum[c] += weight * pixel[c];
+                if (k <= 0) {
+                    sumOut[c] += pixel[c];
+                } else {
+                    sumIn[c] += pixel[c];
+                }
+            }
+        }
+        for (int32_t i = 0; i < n; i++) {
+            const uint16_t* leave = src + MATH_MAX(i - radius, 0) * channel;
+            const uint16_t* center = src + MATH_MIN(i + 1, n - 1) * channel;
+            const uint16_t* enter = src + MATH_MIN(i + radius + 1, n - 1) * channel;
+            StoreKernelPixel(sum, divisor, dst + i * dstStep, channel, weightByAlpha);
+            for (int32_t c = 0; c < channel; c++) {
+                sum[c] -= sumOut[c];
+                sumOut[c] -= leave[c];
+                sumIn[c] += enter[c];
+                sum[c] += sumIn[c];
+                sumIn[c] -= center[c];
+                sumOut[c] += center[c];
+            }
+        }
+    }
+
+    void KernelBlurRows(uint8_t* buf, int32_t width, int32_t height, int32_t radius, int32_t channel,
+                        int32_t stride, const uint32_t* weights, bool weightByAlpha)
+    {
+#pragma omp parallel
+        {
+            uint16_t* line = (uint16_t*)malloc(width * channel * sizeof(uint16_t));
+#pragma omp for
+            for (int32_t y = 0; y < height; y++) {
+                if (line == nullptr) {
+                    continue;
+                }
+                const uint8_t* pixel = buf + y * stride;
+                for (int32_t x = 0; x < width; x++) {
+                    LoadKernelPixel(pixel + x * channel, line + x * channel, channel, weightByAlpha);
+                }
+                KernelBlurLine(line, width, buf + y * stride, channel, channel, radius, weights, weightByAlpha);
+            }
+            free(line);
+        }
+    }
+
+    void KernelBlurColumns(uint8_t* buf, int32_t width, int32_t height, int32_t radius, int32_t channel,
+                           int32_t stride, const uint32_t* weights, bool weightByAlpha)
+    {
+        int32_t stripNum = (width + COLUMN_STRIP - 1) / COLUMN_STRIP;
+#pragma omp parallel
+        {
+            // the strip is stored column by column so that every column is a contiguous line
+            uint16_t* strip = (uint16_t*)malloc(height * COLUMN_STRIP * channel * sizeof(uint16_t));
+#pragma omp for
+            for (int32_t s = 0; s < stripNum; s++) {
+                if (strip == nullptr) {
+                    continue;
+                }
+                int32_t x0 = s * COLUMN_STRIP;
+                int32_t columns = MATH_MIN(COLUMN_STRIP, width - x0);
+                for (int32_t y = 0; y < height; y++) {
+                    const uint8_t* pixel = buf + y * stride + x0 * channel;
+                    for (int32_t col = 0; col < columns; col++) {
+                        LoadKernelPixel(pixel + col * channel, strip + (col * height + y) * channel,
+                                        channel, weightByAlpha);
+                    }
+                }
+                for (int32_t col = 0; col < columns; col++) {
+                    KernelBlurLine(strip + col * height * channel, height, buf + (x0 + col) * channel,
+                                   stride, channel, radius, weights, weightByAlpha);
+                }
+            }
+            free(strip);
+        }
+    }
+
     void GetRGBAIntegralImage(uint8_t* src, uint16_t width, uint16_t height, uint16_t stride)
     {
         int32_t channel = FOUR_TIMES;
@@ -128,6 +636,9 @@ private:
     int32_t* integral_;
     int32_t imageWidth_;
     int32_t imageHeight_;
+    BlurMode blurMode_;
+    uint8_t boxBlurPasses_;
+    bool premultiplied_;
 #endif
 };
 } // namespace OHOS
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_cell_arena.h
+ * @brief Defines the memory arena of the rasterizer cells
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_CELL_ARENA_H
+#define GRAPHIC_LITE_RASTERIZER_CELL_ARENA_H
+
+#include <cstdint>
+
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief Size of a cell block, 4096 cells of CellBuildAntiAlias.
+ */
+const uint32_t CELL_ARENA_BLOCK_SHIFT = 16;
+const uint32_t CELL_ARENA_BLOCK_BYTES = 1 << CELL_ARENA_BLOCK_SHIFT;
+/**
+ * @brief A chunk of blocks is one UIMalloc, chunks double up to this many blocks.
+ */
+const uint32_t CELL_ARENA_MAX_CHUNK_BLOCKS = 16;
+/**
+ * @brief Number of released index buffers kept for reuse.
+ */
+const uint32_t CELL_ARENA_BUFFER_SLOTS = 4;
+
+/**
+ * @brief Memory arena of cell blocks and sorted index buffers, backed by UIMalloc.
+ * Rasterizers on the same thread can share one arena, blocks and buffers released by one rasterizer
+ * are handed to the next one without going back to the heap. The arena is not thread safe.
+ * The high-water statistics tell how much to Reserve at startup.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerCellArena : public HeapBase {
+public:
+    RasterizerCellArena()
+        : chunks_(nullptr), freeBlocks_(nullptr), nextChunkBlocks_(1), blocksAllocated_(0),
+          blocksInUse_(0), blocksHighWater_(0), bufferBytesInUse_(0), bufferBytesHighWater_(0)
+    {
+        for (uint32_t i = 0; i < CELL_ARENA_BUFFER_SLOTS; i++) {
+            buffers_[i].data = nullptr;
+            buffers_[i].capacity = 0;
+        }
+    }
+
+    /**
+     * @brief Frees every chunk and cached buffer, blocks and buffers in use must be released before.
+     */
+    ~RasterizerCellArena();
+
+    /**
+     * @brief Returns a block of CELL_ARENA_BLOCK_BYTES bytes, nullptr when the heap is exhausted.
+     */
+    void* AllocateBlock();
+
+    void FreeBlock(void* block);
+
+    /**
+     * @brief Returns a buffer of at least size bytes, a released buffer is reused when one is large enough.
+     * New buffers are allocated one half larger than asked so that growing frames do not reallocate each time.
+     * @param capacity Receives the real size of the buffer, 0 on failure
+     */
+    void* AllocateBuffer(uint32_t size, uint32_t& capacity);
+
+    void FreeBuffer(void* buffer, uint32_t capacity);
+
+    /**
+     * @brief Makes sure blockNum blocks are available without further allocation.
+     */
+    void Reserve(uint32_t blockNum);
+
+    uint32_t GetBlocksAllocated() const
+    {
+        return blocksAllocated_;
+    }
+
+    uint32_t GetBlocksInUse() const
+    {
+        return blocksInUse_;
+    }
+
+    uint32_t GetBlocksHighWater() const
+    {
+        return blocksHighWater_;
+    }
+
+    uint32_t GetBufferBytesInUse() const
+    {
+        return bufferBytesInUse_;
+    }
+
+    uint32_t GetBufferBytesHighWater() const
+    {
+        return bufferBytesHighWater_;
+    }
+
+    void ResetHighWater()
+    {
+        blocksHighWater_ = blocksInUse_;
+        bufferBytesHighWater_ = bufferBytesInUse_;
+    }
+
+private:
+    RasterizerCellArena(const RasterizerCellArena&);
+    RasterizerCellArena& operator=(const RasterizerCellArena&);
+
+    struct Chunk {
+        Chunk* next;
+        uint32_t blockNum;
+    };
+
+    struct FreeBlockNode {
+        FreeBlockNode* next;
+    };
+
+    struct CachedBuffer {
+        void* data;
+        uint32_t capacity;
+    };
+
+    bool Grow(uint32_t blockNum);
+
+    Chunk* chunks_;
+    FreeBlockNode* freeBlocks_;
+    uint32_t nextChunkBlocks_;
+    uint32_t blocksAllocated_;
+    uint32_t blocksInUse_;
+    uint32_t blocksHighWater_;
+    uint32_t bufferBytesInUse_;
+    uint32_t bufferBytesHighWater_;
+    CachedBuffer buffers_[CELL_ARENA_BUFFER_SLOTS];
+};
+} // namespace OHOS
+#endif
@@ -24,9 +24,19 @@
 #define GRAPHIC_LITE_RASTERIZER_CELLS_ANTIALIAS_H
 
 #include "gfx_utils/diagram/common/common_math.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_cell_arena.h"
 #include "gfx_utils/vector.h"
 
 namespace OHOS {
+/**
+ * @brief Rows are sorted with RadixSortCells instead of QsortCells from this many cells per radix pass on.
+ * Measured on shuffled rows, the crossover is about 12 cells for one pass (x range below 256),
+ * 16 for two passes and 24 for three. Rows in path order favour QsortCells a little.
+ */
+const uint32_t RADIX_SORT_PASS_CELLS = 16;
+const uint32_t RADIX_SORT_DIGIT_BITS = 8;
+const uint32_t RADIX_SORT_BUCKETS = 1 << RADIX_SORT_DIGIT_BITS;
+const uint32_t RADIX_SORT_DIGIT_MASK = RADIX_SORT_BUCKETS - 1;
 // There is no constructor defined for pixel cells,
 // which is to avoid the additional overhead of allocating cell arrays
 struct CellBuildAntiAlias {
@@ -52,14 +62,160 @@ struct CellBuildAntiAlias {
     }
 };
 
+/**
+ * @brief Cell of the compound rasterizer for one style. An edge cell is stored once for the style
+ * on its left and once, with cover and area negated, for the style on its right. A cover beyond
+ * int16 is split over several cells of the same x, the sweep adds them up again.
+ */
+struct CellStyleAntiAlias {
+    int32_t x;
+    int32_t y;
+    int32_t area;
+    int16_t cover;
+    int16_t style;
+};
+
+/**
+ * @brief CellStyleAntiAlias sorted into its row, the row gives its y.
+ */
+struct CellStyleRowAntiAlias {
+    int32_t x;
+    int32_t area;
+    int16_t cover;
+    int16_t style;
+};
+
+/**
+ * @brief Storage of the cells of a RasterizerCellsAntiAlias.
+ * CELL_LAYOUT_WIDE keeps CellBuildAntiAlias (16 bytes) and sorts pointers to them,
+ * CELL_LAYOUT_COMPACT keeps CellCompactAntiAlias (8 bytes) and sorts the cells themselves,
+ * CELL_LAYOUT_STYLED keeps CellStyleAntiAlias (16 bytes) for the compound rasterizer and sorts them by value
+ * as CellStyleRowAntiAlias (12 bytes) by style and x, one row at a time.
+ */
+enum CellLayout {
+    CELL_LAYOUT_WIDE,
+    CELL_LAYOUT_COMPACT,
+    CELL_LAYOUT_STYLED
+};
+
+/**
+ * @brief Largest style of CELL_LAYOUT_STYLED.
+ */
+const int32_t CELL_STYLE_MAX = INT16_MAX;
+
+const int32_t COMPACT_COVER_BITS = 10;
+const int32_t COMPACT_AREA_BITS = 22;
+const uint32_t COMPACT_COVER_MASK = (1 << COMPACT_COVER_BITS) - 1;
+const int32_t COMPACT_COVER_MAX = (1 << (COMPACT_COVER_BITS - 1)) - 1;
+const int32_t COMPACT_COVER_MIN = -(1 << (COMPACT_COVER_BITS - 1));
+const int32_t COMPACT_AREA_MAX = (1 << (COMPACT_AREA_BITS - 1)) - 1;
+const int32_t COMPACT_AREA_MIN = -(1 << (COMPACT_AREA_BITS - 1));
+
+/**
+ * @brief Cell of the compact layout. x and y are int16 offsets from the origin of the outline,
+ * cover (10 bits) and area (22 bits) share one word. A cell whose cover or area does not fit
+ * is stored as several cells with the same x and y, the sweep adds them up again.
+ */
+struct CellCompactAntiAlias {
+    int16_t x;
+    int16_t y;
+    uint32_t coverArea;
+
+    void Set(int32_t cellX, int32_t cellY, int32_t cover, int32_t area)
+    {
+        x = static_cast<int16_t>(cellX);
+        y = static_cast<int16_t>(cellY);
+        coverArea = (static_cast<uint32_t>(area) << COMPACT_COVER_BITS) |
+                    (static_cast<uint32_t>(cover) & COMPACT_COVER_MASK);
+    }
+
+    int32_t GetCover() const
+    {
+        return static_cast<int32_t>(coverArea << COMPACT_AREA_BITS) >> COMPACT_AREA_BITS;
+    }
+
+    int32_t GetArea() const
+    {
+        return static_cast<int32_t>(coverArea) >> COMPACT_COVER_BITS;
+    }
+};
+
+/**
+ * @brief Walks the sorted cells of a scanline in the wide layout.
+ */
+class CellWideIterator {
+public:
+    explicit CellWideIterator(const CellBuildAntiAlias* const* cells) : cells_(cells) {}
+
+    int32_t GetX() const
+    {
+        return (*cells_)->x;
+    }
+    int32_t GetCover() const
+    {
+        return (*cells_)->cover;
+    }
+    int32_t GetArea() const
+    {
+        return (*cells_)->area;
+    }
+    void Next()
+    {
+        ++cells_;
+    }
+
+private:
+    const CellBuildAntiAlias* const* cells_;
+};
+
+/**
+ * @brief Walks the sorted cells of a scanline in the compact layout.
+ */
+class CellCompactIterator {
+public:
+    CellCompactIterator(const CellCompactAntiAlias* cells, int32_t originX) : cells_(cells), originX_(originX) {}
+
+    int32_t GetX() const
+    {
+        return originX_ + cells_->x;
+    }
+    int32_t GetCover() const
+    {
+        return cells_->GetCover();
+    }
+    int32_t GetArea() const
+    {
+        return cells_->GetArea();
+    }
+    void Next()
+    {
+        ++cells_;
+    }
+
+private:
+    const CellCompactAntiAlias* cells_;
+    int32_t originX_;
+};
+
 class RasterizerCellsAntiAlias {
     struct SortedYLevel {
         uint32_t start;
         uint32_t num;
     };
 
+    /**
+     * @brief A clipped line of the outline in 1 / 256 pixel, kept for the band streaming.
+     */
+    struct RasterizerEdge {
+        int32_t x1;
+        int32_t y1;
+        int32_t x2;
+        int32_t y2;
+    };
+
     /**
      * @brief Build the offset of 'cell unit', mask mask, cell pool capacity, etc
+     * A cell block must fit in CELL_ARENA_BLOCK_BYTES.
      * @since 1.0
      * @version 1.0
      */
@@ -67,7 +223,13 @@ class RasterizerCellsAntiAlias {
         CELL_BLOCK_SHIFT = 12,
         CELL_BLOCK_SIZE = 1 << CELL_BLOCK_SHIFT,
         CELL_BLOCK_MASK = CELL_BLOCK_SIZE - 1,
-        CELL_BLOCK_POOL = 256
+        CELL_BLOCK_POOL = 256,
+        COMPACT_CELL_BLOCK_SHIFT = CELL_BLOCK_SHIFT + 1,
+        COMPACT_CELL_BLOCK_SIZE = 1 << COMPACT_CELL_BLOCK_SHIFT,
+        COMPACT_CELL_BLOCK_MASK = COMPACT_CELL_BLOCK_SIZE - 1,
+        STYLED_CELL_BLOCK_SHIFT = CELL_BLOCK_SHIFT,
+        STYLED_CELL_BLOCK_SIZE = 1 << STYLED_CELL_BLOCK_SHIFT,
+        STYLED_CELL_BLOCK_MASK = STYLED_CELL_BLOCK_SIZE - 1
     };
 
     enum DxLimit {
@@ -91,7 +253,101 @@ public:
      * @version 1.0
      */
     void Reset();
-    void SetStyle(const CellBuildAntiAlias& styleCell);
+
+    /**
+     * @brief Takes cell blocks and sorted index buffers from the arena, nullptr selects the private arena.
+     * The memory held so far is released to the previous arena and the cells are reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetArena(RasterizerCellArena* arena);
+
+    RasterizerCellArena* GetArena() const
+    {
+        return arena_;
+    }
+
+    /**
+     * @brief Selects the cell storage, the cells are reset.
+     * The compact layout halves the bytes per cell and lets the sweep read the sorted cells linearly.
+     * It needs the outline to span less than 32768 pixels in x and y around its first cell,
+     * otherwise the cells are widened on the fly and GetCellLayout reports CELL_LAYOUT_WIDE until the next Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellLayout(CellLayout layout);
+
+    CellLayout GetCellLayout() const
+    {
+        return layout_;
+    }
+
+    /**
+     * @brief Bytes of the cell blocks filled since Reset plus the sorted index buffers and the recorded lines.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetMemoryUsage() const
+    {
+        return currBlock_ * CELL_ARENA_BLOCK_BYTES + sortedCellsCapacity_ + sortedYCapacity_ + edgeCapacity_;
+    }
+
+    /**
+     * @brief Rasterizes the outline in horizontal bands of bandHeight rows, 0 builds all cells at once.
+     * In band mode LineOperate only records the lines, each band replays them and keeps the cells of its rows,
+     * so the cell memory is bounded by one band. A band that reaches the cell block limit is split in halves
+     * instead of dropping cells. The recorded lines carry no styles, CELL_LAYOUT_STYLED is never streamed.
+     * The cells are reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetBandHeight(int32_t bandHeight);
+
+    int32_t GetBandHeight() const
+    {
+        return bandHeight_;
+    }
+
+    /**
+     * @brief Number of bands rasterized since Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetBandCount() const
+    {
+        return bandCount_;
+    }
+
+    /**
+     * @brief Makes the sorted cells of row y available, in band mode the band starting at y is rasterized
+     * when y is outside of the current band. Only valid after SortAllCells.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SeekBand(int32_t y)
+    {
+        if (bandHeight_ > 0 && (y < bandMinY_ || y > bandMaxY_)) {
+            RasterizeBand(y);
+        }
+    }
+
+    /**
+     * @brief True when nothing was added since Reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool IsEmpty() const
+    {
+        return (bandHeight_ > 0) ? (edgeNum_ == 0) : (numCells_ == 0);
+    }
+
+    /**
+     * @brief Sets the styles left and right of the following lines in CELL_LAYOUT_STYLED, -1 is no style.
+     * The current cell is closed so that cells never mix styles.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetStyle(int32_t left, int32_t right);
 
     /**
      * @brief According to the incoming 2 coordinate points (both with sub pixels),
@@ -140,13 +396,18 @@ public:
 
     /**
      * @brief In the process of rasterization, it is calculated according to the coordinate height of Y
-     * Total number of cells.
+     * Total number of cells, rows outside of the current band have none.
      * @since 1.0
      * @version 1.0
      */
-    uint32_t GetScanlineNumCells(uint32_t yLevel)
+    uint32_t GetScanlineNumCells(uint32_t yLevel) const
     {
-        return sortedY_[yLevel - minY_].num;
+        // A band without cells has no sorted rows, the rows outside of the band are not sorted
+        int32_t y = static_cast<int32_t>(yLevel);
+        if (numCells_ == 0 || y < sortedMinY_ || y > sortedMaxY_) {
+            return 0;
+        }
+        return sortedY_[y - sortedMinY_].num;
     }
 
     /**
@@ -155,9 +416,43 @@ public:
      * @since 1.0
      * @version 1.0
      */
-    const CellBuildAntiAlias * const *GetScanlineCells(uint32_t yLevel)
+    const CellBuildAntiAlias * const *GetScanlineCells(uint32_t yLevel) const
+    {
+        return sortedCells_ + sortedY_[yLevel - sortedMinY_].start;
+    }
+
+    /**
+     * @brief The sorted cells of the Y row in the compact layout, their x is relative to GetOriginX.
+     * @since 1.0
+     * @version 1.0
+     */
+    const CellCompactAntiAlias* GetScanlineCompactCells(uint32_t yLevel) const
     {
-        return sortedCells_ + sortedY_[yLevel - minY_].start;
+        return reinterpret_cast<const CellCompactAntiAlias*>(sortedCells_) + sortedY_[yLevel - sortedMinY_].start;
+    }
+
+    /**
+     * @brief Sorts the cells of the Y row in the styled layout by style and by x within a style.
+     * SortAllCells only groups the styled cells by row, each row is sorted when it is swept while it is in cache.
+     * Sorting a row again leaves it as it is.
+     * @param styles Receives the style of every run of cells of one style, room for every style of the row
+     * @param starts Receives the first cell of every run and the number of cells of the row after the last one
+     * @return The number of styles of the row.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t SortScanlineStyledCells(uint32_t yLevel, int32_t* styles, uint32_t* starts);
+
+    /**
+     * @brief The cells of the Y row in the styled layout, see SortScanlineStyledCells.
+     * @since 1.0
+     * @version 1.0
+     */
+    const CellStyleRowAntiAlias* GetScanlineStyledCells(uint32_t yLevel) const;
+
+    int32_t GetOriginX() const
+    {
+        return originX_;
     }
 
     bool GetSorted() const
@@ -178,6 +473,26 @@ private:
 
     void OutLineLegal(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 
+    /**
+     * @brief Builds the cells of a line, LineOperate without the band recording.
+     * @since 1.0
+     * @version 1.0
+     */
+    void RenderLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    void RecordEdge(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    /**
+     * @brief Replays the recorded lines into the cells of the band starting at row y and sorts them.
+     * @since 1.0
+     * @version 1.0
+     */
+    void RasterizeBand(int32_t y);
+
+    void ResetCells();
+
+    void SortCells();
+
     /**
      * @brief Add the current cell during rasterization.
      * @since 1.0
@@ -185,6 +500,29 @@ private:
      */
     void AddCurrentCell();
 
+    void AddWideCell(const CellBuildAntiAlias& cell);
+
+    void AddCompactCell(const CellBuildAntiAlias& cell);
+
+    void AddStyledCell(const CellBuildAntiAlias& cell);
+    void AddStyledCell(const CellBuildAntiAlias& cell, int32_t style, int32_t cover, int32_t area);
+
+    /**
+     * @brief Converts the stored compact cells to the wide layout when a cell is out of the int16 range.
+     * @return false when the cells could not be saved, they are then kept in the compact layout
+     * @since 1.0
+     * @version 1.0
+     */
+    bool ExpandCompactCells();
+
+    bool PrepareCellSlot(uint32_t blockMask);
+
+    void SortPointerCells(uint32_t sortedYSize);
+
+    void SortCompactCells(uint32_t sortedYSize);
+
+    void SortStyledCells(uint32_t sortedYSize);
+
     /**
      * @brief n the rasterization process, the horizontal direction is
      * from x1 to x2 according to the coordinate height value of ey,
@@ -197,6 +535,8 @@ private:
     void RenderVerticalLine(int32_t& x1, int32_t& ex1, int64_t& dy, int32_t& first, int32_t& increase, int32_t& xFrom,
                             int32_t& submaskFlagsY1, int32_t& submaskFlagsY2, int32_t& ey1, int32_t& ey2, int32_t& delta);
 
+    int32_t GetRowsBeforeBand(int32_t ey, int32_t eyEnd, int32_t increase) const;
+
     void RenderObliqueLine(int64_t& dx, int64_t& dy, int32_t& first, int32_t& increase, int32_t& xFrom,
                            int64_t& deltaxMask, int32_t& ey1, int32_t& ey2, int32_t& delta);
     /**
@@ -204,7 +544,11 @@ private:
      * @since 1.0
      * @version 1.0
      */
-    void AllocateBlock();
+    bool AllocateBlock();
+
+    bool ReserveBuffer(void*& buffer, uint32_t& capacity, uint32_t size);
+
+    void ReleaseMemory();
 
 private:
     uint32_t numBlocks_;
@@ -214,14 +558,39 @@ private:
     uint32_t cellBlockLimit_;
     CellBuildAntiAlias** cells_;
     CellBuildAntiAlias* currCellPtr_;
+    CellCompactAntiAlias* currCompactPtr_;
+    CellStyleAntiAlias* currStyledPtr_;
     CellBuildAntiAlias** sortedCells_;
     SortedYLevel* sortedY_;
+    uint32_t sortedCellsCapacity_;
+    uint32_t sortedYCapacity_;
+    CellStyleRowAntiAlias* rowBuffer_;
+    uint32_t rowBufferCapacity_;
+    uint32_t rowRadixThreshold_;
+    int32_t sortedMinY_;
+    int32_t sortedMaxY_;
+    RasterizerCellArena localArena_;
+    RasterizerCellArena* arena_;
     CellBuildAntiAlias currCell_;
     CellBuildAntiAlias styleCell_;
     int32_t minX_;
     int32_t minY_;
     int32_t maxX_;
     int32_t maxY_;
+    int16_t styleLeft_;
+    int16_t styleRight_;
+    int32_t originX_;
+    int32_t originY_;
+    CellLayout layout_;
+    CellLayout requestedLayout_;
+    RasterizerEdge* edges_;
+    uint32_t edgeNum_;
+    uint32_t edgeCapacity_;
+    int32_t bandHeight_;
+    int32_t bandMinY_;
+    int32_t bandMaxY_;
+    uint32_t bandCount_;
+    bool cellsOverflow_;
     bool sorted_;
 };
 
@@ -277,6 +646,35 @@ void QsortCellsSweep(CellBuildAntiAlias*** base, CellBuildAntiAlias*** iIndex, C
  */
 void QsortCells(CellBuildAntiAlias** start, uint32_t num);
 
+/**
+ * @brief In the rasterization process, the cells of a row are sorted by value with an LSD radix sort.
+ * It is faster than QsortCells from RADIX_SORT_PASS_CELLS cells per pass on.
+ * @param cellBuffer Scratch for num cell pointers
+ * @param keyBuffer Scratch for 2 * num keys
+ * @since 1.0
+ * @version 1.0
+ */
+void RadixSortCells(CellBuildAntiAlias** start, uint32_t num, CellBuildAntiAlias** cellBuffer, uint32_t* keyBuffer);
+
+/**
+ * @brief Sorts a row of compact cells by x, short rows by insertion, long rows with an LSD radix sort.
+ * @param cellBuffer Scratch for num cells, only used from radixThreshold cells on
+ * @since 1.0
+ * @version 1.0
+ */
+void SortCompactCellRow(CellCompactAntiAlias* start, uint32_t num, CellCompactAntiAlias* cellBuffer,
+                        uint32_t radixThreshold);
+
+/**
+ * @brief Sorts a row of styled cells by style and then by x, short rows by insertion,
+ * long rows with an LSD radix sort on x followed by one on the style.
+ * @param cellBuffer Scratch for num cells, only used from radixThreshold cells on
+ * @since 1.0
+ * @version 1.0
+ */
+void SortStyledCellRow(CellStyleRowAntiAlias* start, uint32_t num, CellStyleRowAntiAlias* cellBuffer,
+                       uint32_t radixThreshold);
+
 void QsortCellsFor(CellBuildAntiAlias*** iIndex, CellBuildAntiAlias*** jIndex,
                    CellBuildAntiAlias*** limit, CellBuildAntiAlias*** base);
 } // namespace OHOS
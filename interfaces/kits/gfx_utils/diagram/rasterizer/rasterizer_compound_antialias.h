@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rasterizer_compound_antialias.h
+ * @brief Defines the compound rasterizer, several styled shapes are rasterized in one pass
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_COMPOUND_ANTIALIAS_H
+#define GRAPHIC_LITE_RASTERIZER_COMPOUND_ANTIALIAS_H
+
+#include "rasterizer_cells_antialias.h"
+#include "rasterizer_scanline_clip.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+
+namespace OHOS {
+#if GRAPHIC_ENABLE_COMPOUND_RASTERIZER_FLAG
+/**
+ * @class RasterizerCompoundAntialias
+ * @brief Rasterizes shapes of several styles into one cell array.
+ * Every edge carries the style on its left and on its right side (-1 for none), its cells are
+ * stored once per style and sorted once by row, style and x, every scanline then holds one run of
+ * cells per style. Two shapes sharing an edge therefore meet without a seam, and hundreds of small
+ * shapes cost one sort instead of one rasterizer pass each. Coordinates follow
+ * RasterizerScanlineAntialias, 24.8 or float pixels. Each style may have its own filling rule.
+ * @since 1.0
+ * @version 1.0
+ */
+class RasterizerCompoundAntialias {
+    enum RasterizerStatus {
+        STATUS_INITIAL,
+        STATUS_MOVE_TO,
+        STATUS_LINE_TO,
+        STATUS_CLOSED
+    };
+
+public:
+    enum AntialiasScale {
+        AA_SHIFT = 8,
+        AA_SCALE = 1 << AA_SHIFT,
+        AA_MASK = AA_SCALE - 1,
+        AA_SCALE2 = AA_SCALE * 2,
+        AA_MASK2 = AA_SCALE2 - 1
+    };
+
+    RasterizerCompoundAntialias(uint32_t cellBlockLimit = (1 << (AA_SHIFT + 2)))
+        : outline_(cellBlockLimit),
+          clipper_(),
+          fillingRule_(FILL_NON_ZERO),
+          autoClose_(true),
+          startX_(0),
+          startY_(0),
+          status_(STATUS_INITIAL),
+          minStyle_(INT32_MAX),
+          maxStyle_(INT32_MIN),
+          scanY_(0),
+          currY_(0),
+          activeNum_(0),
+          currCells_(nullptr)
+    {
+        outline_.SetCellLayout(CELL_LAYOUT_STYLED);
+    }
+
+    void Reset();
+
+    /**
+     * @brief Shares a cell arena with other rasterizers of the same thread, nullptr selects a private one.
+     */
+    void SetCellArena(RasterizerCellArena* arena)
+    {
+        outline_.SetArena(arena);
+        Reset();
+    }
+
+    void ResetClipping();
+    void ClipBox(float x1, float y1, float x2, float y2);
+
+    void AutoClose(bool flag)
+    {
+        autoClose_ = flag;
+    }
+
+    /**
+     * @brief Sets the filling rule of the styles without an own rule.
+     */
+    void SetFillingRule(FillingRule rule)
+    {
+        fillingRule_ = rule;
+    }
+
+    /**
+     * @brief Sets the filling rule of one style, it is kept across Reset.
+     */
+    void SetStyleFillingRule(int32_t style, FillingRule rule);
+
+    FillingRule GetStyleFillingRule(int32_t style) const
+    {
+        if (style < 0 || static_cast<uint32_t>(style) >= styleRules_.GetSize() ||
+            styleRules_[style] == STYLE_RULE_DEFAULT) {
+            return fillingRule_;
+        }
+        return static_cast<FillingRule>(styleRules_[style]);
+    }
+
+    /**
+     * @brief Sets the styles of the following edges, left for the area on the left of the edge
+     * and right for the area on its right, -1 for no style. The open polygon is closed first
+     * with the previous styles when auto close is on.
+     * @param left Style id of 0 to CELL_STYLE_MAX or -1
+     * @param right Style id of 0 to CELL_STYLE_MAX or -1
+     * @since 1.0
+     * @version 1.0
+     */
+    void Styles(int32_t left, int32_t right);
+
+    void MoveTo(int32_t x, int32_t y);
+    void LineTo(int32_t x, int32_t y);
+    void MoveToByfloat(float x, float y);
+    void LineToByfloat(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    /**
+     * @brief Adds num vertices, each one like AddVertex.
+     * @since 1.0
+     * @version 1.0
+     */
+    void AddVertices(const PathVertex* vertices, uint32_t num);
+
+    /**
+     * @brief Adds the path of a vertex source with the current styles.
+     */
+    template <typename VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        PathVertex vertices[VERTEX_BATCH_SIZE];
+        uint32_t num;
+        vs.Rewind(pathId);
+        if (outline_.GetSorted()) {
+            Reset();
+        }
+        do {
+            num = GenerateSourceVertices(vs, vertices, VERTEX_BATCH_SIZE);
+            AddVertices(vertices, num);
+        } while (num == VERTEX_BATCH_SIZE);
+    }
+
+    int32_t GetMinX() const
+    {
+        return outline_.GetMinX();
+    }
+    int32_t GetMinY() const
+    {
+        return outline_.GetMinY();
+    }
+    int32_t GetMaxX() const
+    {
+        return outline_.GetMaxX();
+    }
+    int32_t GetMaxY() const
+    {
+        return outline_.GetMaxY();
+    }
+
+    int32_t GetMinStyle() const
+    {
+        return minStyle_;
+    }
+    int32_t GetMaxStyle() const
+    {
+        return maxStyle_;
+    }
+
+    /**
+     * @brief Sorts the cells and prepares the style tables.
+     * @return false if there is nothing to sweep.
+     */
+    bool RewindScanlines();
+
+    /**
+     * @brief Moves to the next scanline with styled cells and finds the run of cells of every style.
+     * @return The number of styles on the scanline, 0 when all scanlines were swept.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t SweepStyles();
+
+    /**
+     * @brief Style id of the styleIdx-th style of the current scanline, the styles are in ascending order.
+     */
+    int32_t GetStyle(uint32_t styleIdx) const
+    {
+        return activeStyles_[styleIdx];
+    }
+
+    /**
+     * @brief Y of the scanline split by the last SweepStyles.
+     */
+    int32_t GetScanY() const
+    {
+        return currY_;
+    }
+
+    uint32_t CalculateAlpha(int32_t area, FillingRule rule) const;
+
+    /**
+     * @brief Sweeps the cells of the styleIdx-th style of the current scanline into sl,
+     * with the filling rule of that style.
+     * @return true if the scanline contains at least one span.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl, uint32_t styleIdx) const
+    {
+        sl.ResetSpans();
+        if (styleIdx >= activeNum_) {
+            return false;
+        }
+        const CellStyleRowAntiAlias* cells = currCells_ + styleStarts_[styleIdx];
+        uint32_t numCells = styleStarts_[styleIdx + 1] - styleStarts_[styleIdx];
+        FillingRule rule = GetStyleFillingRule(activeStyles_[styleIdx]);
+        int32_t cover = 0;
+        while (numCells) {
+            int32_t x = cells->x;
+            int32_t area = cells->area;
+            int32_t nextX = x;
+            uint32_t alpha;
+
+            cover += cells->cover;
+            // accumulate all cells with the same X
+            while (--numCells) {
+                ++cells;
+                nextX = cells->x;
+                if (nextX != x) {
+                    break;
+                }
+                area += cells->area;
+                cover += cells->cover;
+            }
+            if (area) {
+                alpha = CalculateAlpha(cover * COVER_AREA_SCALE - area, rule);
+                if (alpha) {
+                    sl.AddCell(x, alpha);
+                }
+                x++;
+            }
+            if (numCells && nextX > x) {
+                alpha = CalculateAlpha(cover * COVER_AREA_SCALE, rule);
+                if (alpha) {
+                    sl.AddSpan(x, nextX - x, alpha);
+                }
+            }
+        }
+        if (sl.NumSpans() == 0) {
+            return false;
+        }
+        sl.Finalize(currY_);
+        return true;
+    }
+
+private:
+    static constexpr uint8_t STYLE_RULE_DEFAULT = 0xFF;
+
+    /**
+     * @brief Area of a cell fully covered by its cover, the cover may be negative so it is not shifted.
+     */
+    static constexpr int32_t COVER_AREA_SCALE = 1 << (POLY_SUBPIXEL_SHIFT + 1);
+
+    RasterizerCompoundAntialias(const RasterizerCompoundAntialias&);
+    const RasterizerCompoundAntialias& operator=(const RasterizerCompoundAntialias&);
+
+    RasterizerCellsAntiAlias outline_;
+    RasterizerScanlineClip clipper_;
+    FillingRule fillingRule_;
+    bool autoClose_;
+    int32_t startX_;
+    int32_t startY_;
+    uint32_t status_;
+    int32_t minStyle_;
+    int32_t maxStyle_;
+    int32_t scanY_;
+    int32_t currY_;
+    uint32_t activeNum_;
+    const CellStyleRowAntiAlias* currCells_;
+    GeometryPlainDataArray<uint8_t> styleRules_;
+    GeometryPlainDataArray<int32_t> activeStyles_;
+    GeometryPlainDataArray<uint32_t> styleStarts_;
+};
+#endif
+} // namespace OHOS
+#endif
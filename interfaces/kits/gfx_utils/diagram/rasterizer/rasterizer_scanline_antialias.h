@@ -51,6 +51,13 @@ class RasterizerScanlineAntialias {
     };
 
 public:
+    /**
+     * @brief Receives every scanline produced by SweepScanlineParallel.
+     * @since 1.0
+     * @version 1.0
+     */
+    using ScanlineRender = void (*)(const GeometryScanline& sl, void* param);
+
     enum AntialiasScale {
         AA_SHIFT = 8,
         AA_SCALE = 1 << AA_SHIFT,
@@ -73,7 +80,10 @@ public:
           autoClose_(true),
           startX_(0),
           startY_(0),
-          status_(STATUS_INITIAL)
+          status_(STATUS_INITIAL),
+          sweepBandHeight_(SWEEP_BAND_HEIGHT),
+          sweepThreadNum_(0),
+          sweepOrdered_(false)
     {
         for (int32_t coverIndex = 0; coverIndex < AA_SCALE; coverIndex++) {
             gammar_[coverIndex] = coverIndex;
@@ -88,6 +98,68 @@ public:
      */
     void Reset();
 
+    /**
+     * @brief Shares a cell arena with other rasterizers of the same thread, nullptr selects a private one.
+     * Resets the outline.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellArena(RasterizerCellArena* arena)
+    {
+        outline_.SetArena(arena);
+        Reset();
+    }
+
+    /**
+     * @brief Selects the cell storage of the outline, see RasterizerCellsAntiAlias::SetCellLayout.
+     * Resets the outline.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetCellLayout(CellLayout layout)
+    {
+        outline_.SetCellLayout(layout);
+        Reset();
+    }
+
+    CellLayout GetCellLayout() const
+    {
+        return outline_.GetCellLayout();
+    }
+
+    /**
+     * @brief Rasterizes and sweeps the outline band by band, see RasterizerCellsAntiAlias::SetBandHeight.
+     * The peak cell memory is then bounded by one band of bandHeight rows and no cell is dropped,
+     * 0 builds all cells at once. Resets the outline.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetStreamBandHeight(int32_t bandHeight)
+    {
+        outline_.SetBandHeight(bandHeight);
+        Reset();
+    }
+
+    int32_t GetStreamBandHeight() const
+    {
+        return outline_.GetBandHeight();
+    }
+
+    /**
+     * @brief Number of bands the streaming needed since the outline was reset.
+     * @since 1.0
+     * @version 1.0
+     */
+    uint32_t GetStreamBandCount() const
+    {
+        return outline_.GetBandCount();
+    }
+
+    uint32_t GetCellMemoryUsage() const
+    {
+        return outline_.GetMemoryUsage();
+    }
+
     /**
      * @brief Reset the clipping range and clipping flag of the clipper.
      * @since 1.0
@@ -96,11 +168,26 @@ public:
     void ResetClipping();
     void ClipBox(float x1, float y1, float x2, float y2);
 
+    /**
+     * @brief Clips to the union of rectangles in pixels, right and bottom included like Rect.
+     * The path is rasterized once, edges are clipped to the bounding box of the region and every swept
+     * scanline keeps the parts inside the X intervals of its band, so a window partly covered by others
+     * does not rasterize the path once per visible rectangle.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ClipRegion(const Rect* rects, uint32_t rectNum);
+
     void AutoClose(bool flag)
     {
         autoClose_ = flag;
     }
 
+    void SetFillingRule(FillingRule rule)
+    {
+        fillingRule_ = rule;
+    }
+
     /**
      * @brief Set the starting position of the element according to the of 1 / 256 pixel unit.
      * @since 1.0
@@ -134,6 +221,13 @@ public:
     void ClosePolygon();
     void AddVertex(float x, float y, uint32_t cmd);
 
+    /**
+     * @brief Adds num vertices, each one like AddVertex.
+     * @since 1.0
+     * @version 1.0
+     */
+    void AddVertices(const PathVertex* vertices, uint32_t num);
+
     /**
      * @brief Obtain the vertex information coordinates from the vertex source and follow the scanning process
      * Sets the procedure for adding an array of cells.
@@ -143,17 +237,16 @@ public:
     template <typename VertexSource>
     void AddPath(VertexSource& vs, uint32_t pathId = 0)
     {
-        float x;
-        float y;
-
-        uint32_t cmd;
+        PathVertex vertices[VERTEX_BATCH_SIZE];
+        uint32_t num;
         vs.Rewind(pathId);
         if (outline_.GetSorted()) {
             Reset();
         }
-        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
-            AddVertex(x, y, cmd);
-        }
+        do {
+            num = GenerateSourceVertices(vs, vertices, VERTEX_BATCH_SIZE);
+            AddVertices(vertices, num);
+        } while (num == VERTEX_BATCH_SIZE);
     }
 
     /**
@@ -199,12 +292,166 @@ public:
      * The color information is obtained successfully,
      * and then the alpha information of color is calculated by gamma function
      * Fill in the new scanline and have subsequent render.
+     * The scanline type is GeometryScanline, or GeometryScanlineSparse to keep solid spans as runs.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl)
+    {
+        while (true) {
+            if (scanY_ > outline_.GetMaxY()) {
+                return false;
+            }
+            outline_.SeekBand(scanY_);
+            if (SweepScanline(sl, scanY_)) {
+                break;
+            }
+            ++scanY_;
+        }
+        ++scanY_;
+        return true;
+    }
+
+    /**
+     * @brief Sweep the scanline at yLevel into sl without moving the internal scan position.
+     * It only reads the sorted cells, so after Sort() different rows may be swept concurrently.
+     * With band streaming only the rows of the current band have cells.
+     * @return true if the scanline contains at least one span.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl, int32_t yLevel) const
+    {
+        sl.ResetSpans();
+        uint32_t numCells = outline_.GetScanlineNumCells(yLevel);
+        if (numCells == 0) {
+            return false;
+        }
+        if (clipper_.HasRegion()) {
+            const ClipRegionBand* band = clipper_.FindRegionBand(yLevel);
+            if (band == nullptr) {
+                return false;
+            }
+            ClipRegionScanline<Scanline> clipped(sl, clipper_.GetRegionSpans(*band), band->spanNum);
+            SweepRow(clipped, yLevel, numCells);
+        } else {
+            SweepRow(sl, yLevel, numCells);
+        }
+
+        if (sl.NumSpans() == 0) {
+            return false;
+        }
+        sl.Finalize(yLevel);
+        return true;
+    }
+
+    /**
+     * @brief Sort the cells and sweep all scanlines band by band on several threads.
+     * The Y range is split into bands of SetSweepBandHeight rows, the calling thread and the workers
+     * of a pool shared by all rasterizers take bands in turn, every one with its own GeometryScanline,
+     * and render is invoked once per non-empty scanline. The pool threads are started on first use and
+     * kept. Concurrent parallel sweeps, of the same or of different rasterizers, are serialized: a sweep
+     * started on another thread waits until the running one is done.
+     * Without ordering render may be called concurrently for different rows,
+     * with ordering the calls are serialized in ascending Y exactly like the serial
+     * RewindScanlines/SweepScanline loop. With band streaming the scanlines are swept on the calling thread,
+     * and so is a sweep started from within render, e.g. for a nested layer or mask.
+     * @return false if there is nothing to sweep.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool SweepScanlineParallel(ScanlineRender render, void* param);
+
+    /**
+     * @brief Set the number of rows handled by a worker at a time, default 32.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetSweepBandHeight(int32_t bandHeight)
+    {
+        sweepBandHeight_ = (bandHeight > 0) ? bandHeight : SWEEP_BAND_HEIGHT;
+    }
+
+    /**
+     * @brief Set the number of threads used by SweepScanlineParallel, 0 means one per cpu core.
      * @since 1.0
      * @version 1.0
      */
-    bool SweepScanline(GeometryScanline& sl);
+    void SetSweepThreadNum(uint32_t threadNum)
+    {
+        sweepThreadNum_ = threadNum;
+    }
+
+    /**
+     * @brief Deliver scanlines of SweepScanlineParallel in ascending Y one at a time.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetSweepOrdered(bool ordered)
+    {
+        sweepOrdered_ = ordered;
+    }
 
 private:
+    static constexpr int32_t SWEEP_BAND_HEIGHT = 32;
+    static constexpr uint32_t SWEEP_MAX_THREAD = 8;
+
+    template <class Scanline>
+    void SweepRow(Scanline& sl, int32_t yLevel, uint32_t numCells) const
+    {
+        if (outline_.GetCellLayout() == CELL_LAYOUT_COMPACT) {
+            SweepCells(sl, CellCompactIterator(outline_.GetScanlineCompactCells(yLevel), outline_.GetOriginX()),
+                       numCells);
+        } else {
+            SweepCells(sl, CellWideIterator(outline_.GetScanlineCells(yLevel)), numCells);
+        }
+    }
+
+    /**
+     * @brief Accumulates the sorted cells of one row into spans, the iterator hides the cell layout.
+     */
+    template <class Scanline, class CellIterator>
+    void SweepCells(Scanline& sl, CellIterator cells, uint32_t numCells) const
+    {
+        int32_t cover = 0;
+        while (numCells) {
+            int32_t x = cells.GetX();
+            int32_t area = cells.GetArea();
+            int32_t nextX = x;
+            uint32_t alpha;
+
+            cover += cells.GetCover();
+            // accumulate all cells with the same X
+            while (--numCells) {
+                cells.Next();
+                nextX = cells.GetX();
+                if (nextX != x) {
+                    break;
+                }
+                area += cells.GetArea();
+                cover += cells.GetCover();
+            }
+            if (area) {
+                // Span interval from area to  (cover << (POLY_SUBPIXEL_SHIFT + 1))
+                // Cover can be understood as a delta mask with an area of 1
+                alpha = CalculateAlpha((cover << (POLY_SUBPIXEL_SHIFT + 1)) - area);
+                if (alpha) {
+                    sl.AddCell(x, alpha);
+                }
+                x++;
+            }
+            if (numCells && nextX > x) {
+                // At this time, area is 0, that is, 0 to cover << (POLY_SUBPIXEL_SHIFT + 1)
+                alpha = CalculateAlpha(cover << (POLY_SUBPIXEL_SHIFT + 1));
+                if (alpha) {
+                    sl.AddSpan(x, nextX - x, alpha);
+                }
+            }
+        }
+    }
+
     // Disable copying
     RasterizerScanlineAntialias(const RasterizerScanlineAntialias&);
     const RasterizerScanlineAntialias& operator=(const RasterizerScanlineAntialias&);
@@ -218,6 +465,9 @@ private:
     int32_t startY_;
     uint32_t status_;
     int32_t scanY_;
+    int32_t sweepBandHeight_;
+    uint32_t sweepThreadNum_;
+    bool sweepOrdered_;
 };
 } // namespace OHOS
 #endif
@@ -26,6 +26,7 @@
 #include "gfx_utils/diagram/common/common_clip_operate.h"
 #include "gfx_utils/graphic_math.h"
 #include "gfx_utils/diagram/rasterizer/rasterizer_cells_antialias.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
 namespace OHOS {
 /**
  * The PolyMaxCoord enumeration type
@@ -86,6 +87,72 @@ struct RasterDepictInt {
     }
 };
 
+/**
+ * @brief Rows top <= y < bottom of a clip region, they share the X intervals
+ * spanStart .. spanStart + spanNum - 1 of the region.
+ * @since 1.0
+ * @version 1.0
+ */
+struct ClipRegionBand {
+    int32_t top;
+    int32_t bottom;
+    uint32_t spanStart;
+    uint32_t spanNum;
+};
+
+/**
+ * @brief Pixels left <= x < right of a clip region band, the intervals of a band are sorted and disjoint.
+ * @since 1.0
+ * @version 1.0
+ */
+struct ClipRegionSpan {
+    int32_t left;
+    int32_t right;
+};
+
+/**
+ * @brief Scanline adaptor which keeps the parts of the swept cells and spans inside the X intervals
+ * of a clip region band. Cells and spans must arrive in ascending X, as RasterizerScanlineAntialias sweeps them.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+class ClipRegionScanline {
+public:
+    ClipRegionScanline(Scanline& sl, const ClipRegionSpan* spans, uint32_t spanNum)
+        : sl_(sl), spans_(spans), end_(spans + spanNum) {}
+
+    void AddCell(int32_t x, uint32_t cover)
+    {
+        SkipSpans(x);
+        if (spans_ != end_ && x >= spans_->left) {
+            sl_.AddCell(x, cover);
+        }
+    }
+
+    void AddSpan(int32_t x, uint32_t spanLength, uint32_t cover)
+    {
+        SkipSpans(x);
+        int32_t right = x + static_cast<int32_t>(spanLength);
+        for (const ClipRegionSpan* span = spans_; span != end_ && span->left < right; ++span) {
+            int32_t left = MATH_MAX(x, span->left);
+            sl_.AddSpan(left, MATH_MIN(right, span->right) - left, cover);
+        }
+    }
+
+private:
+    void SkipSpans(int32_t x)
+    {
+        while (spans_ != end_ && spans_->right <= x) {
+            ++spans_;
+        }
+    }
+
+    Scanline& sl_;
+    const ClipRegionSpan* spans_;
+    const ClipRegionSpan* end_;
+};
+
 /**
  * @class RasterizerScanlineClip
  * @brief Defines In the rasterization stage, when exchanging scan line processing, for
@@ -106,11 +173,14 @@ public:
           x1_(0),
           y1_(0),
           clippingFlags_(0),
-          clipping_(false) {}
+          clipping_(false),
+          bandNum_(0),
+          hasRegion_(false) {}
 
     void ResetClipping()
     {
         clipping_ = false;
+        hasRegion_ = false;
     }
 
     /**
@@ -123,6 +193,55 @@ public:
         clipBox_ = Rect32(left, top, right, bottom);
         clipBox_.Normalize();
         clipping_ = true;
+        hasRegion_ = false;
+    }
+
+    /**
+     * @brief Sets a clip region made of rectangles in pixels, right and bottom included like Rect.
+     * The rectangles are split into bands of rows with the same X intervals, the edges are clipped
+     * to the bounding box of the region in subpixels and the swept spans to the intervals of their band.
+     * An empty list clips everything.
+     * @since 1.0
+     * @version 1.0
+     */
+    void ClipRegion(const Rect* rects, uint32_t rectNum);
+
+    bool HasRegion() const
+    {
+        return hasRegion_;
+    }
+
+    /**
+     * @brief Returns the band of the region containing row y, nullptr when the row is clipped out.
+     * @since 1.0
+     * @version 1.0
+     */
+    const ClipRegionBand* FindRegionBand(int32_t y) const
+    {
+        uint32_t low = 0;
+        uint32_t high = bandNum_;
+        while (low < high) {
+            uint32_t mid = (low + high) >> 1;
+            const ClipRegionBand& band = bands_[mid];
+            if (y < band.top) {
+                high = mid;
+            } else if (y >= band.bottom) {
+                low = mid + 1;
+            } else {
+                return &band;
+            }
+        }
+        return nullptr;
+    }
+
+    const ClipRegionSpan* GetRegionSpans(const ClipRegionBand& band) const
+    {
+        return spans_.Data() + band.spanStart;
+    }
+
+    uint32_t GetRegionBandNum() const
+    {
+        return bandNum_;
     }
 
     /**
@@ -176,6 +295,10 @@ private:
     int32_t y1_;
     uint32_t clippingFlags_;
     bool clipping_;
+    uint32_t bandNum_;
+    bool hasRegion_;
+    GeometryPlainDataArray<ClipRegionBand> bands_;
+    GeometryPlainDataArray<ClipRegionSpan> spans_;
 };
 } // namespace OHOS
 #endif
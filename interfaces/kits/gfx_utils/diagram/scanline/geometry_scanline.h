@@ -185,5 +185,136 @@ private:
     GeometryPlainDataArray<SpanBlock> arraySpans_;
     SpanBlock* curSpanBlock_;
 };
+/**
+ * @class GeometryScanlineSparse
+ * @brief Scanline container which keeps solid spans as (x, len, cover) runs.
+ * Cells keep one cover byte per pixel like GeometryScanline, a solid span stores a single cover byte
+ * and a negative spanLength, so wide fills never touch per pixel cover memory.
+ * Renderers test spanLength < 0 and blend the whole run with the one cover.
+ * @since 1.0
+ * @version 1.0
+ */
+class GeometryScanlineSparse {
+public:
+    using SpanBlock = GeometryScanline::SpanBlock;
+    using Iterator = SpanBlock*;
+    using ConstIterator = const SpanBlock*;
+
+    GeometryScanlineSparse()
+        : lastScaneLineXCoord_(0x7FFFFFF0), scaneLineYCoord_(0), curSpanBlock_(0), coverPtr_(0) {}
+
+    void Reset(int32_t minX, int32_t maxX)
+    {
+        const int32_t liftNumber = 3;
+        uint32_t maxLen = maxX - minX + liftNumber;
+        if (maxLen > arraySpans_.GetSize()) {
+            arraySpans_.Resize(maxLen);
+            arrayCovers_.Resize(maxLen);
+        }
+        ResetSpans();
+    }
+
+    void AddCell(int32_t x, uint32_t cover)
+    {
+        *coverPtr_ = static_cast<uint8_t>(cover);
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength++;
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = 1;
+            curSpanBlock_->covers = coverPtr_;
+        }
+        coverPtr_++;
+        lastScaneLineXCoord_ = x;
+    }
+
+    void AddCells(int32_t x, uint32_t cellLength, const uint8_t* covers)
+    {
+        if (memcpy_s(coverPtr_, cellLength * sizeof(uint8_t), covers, cellLength * sizeof(uint8_t)) != EOK) {
+            GRAPHIC_LOGE("AddCells fail");
+            return;
+        }
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength > 0) {
+            curSpanBlock_->spanLength += static_cast<int16_t>(cellLength);
+        } else {
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = static_cast<int16_t>(cellLength);
+            curSpanBlock_->covers = coverPtr_;
+        }
+        coverPtr_ += cellLength;
+        lastScaneLineXCoord_ = x + cellLength - 1;
+    }
+
+    /**
+     * A solid span is stored with one cover byte, adjacent solid spans of the same cover are merged.
+     * A run never grows beyond INT16_MAX pixels so that its negative spanLength stays in range,
+     * longer runs continue in a new span.
+     */
+    void AddSpan(int32_t x, uint32_t spanLength, uint32_t cover)
+    {
+        if (x == lastScaneLineXCoord_ + 1 && curSpanBlock_->spanLength < 0 &&
+            *curSpanBlock_->covers == static_cast<uint8_t>(cover)) {
+            uint32_t room = static_cast<uint32_t>(INT16_MAX + curSpanBlock_->spanLength);
+            uint32_t merged = MATH_MIN(spanLength, room);
+            curSpanBlock_->spanLength -= static_cast<int16_t>(merged);
+            x += merged;
+            spanLength -= merged;
+        }
+        while (spanLength > 0) {
+            uint32_t len = MATH_MIN(spanLength, static_cast<uint32_t>(INT16_MAX));
+            *coverPtr_ = static_cast<uint8_t>(cover);
+            curSpanBlock_++;
+            curSpanBlock_->x = static_cast<int16_t>(x);
+            curSpanBlock_->spanLength = static_cast<int16_t>(-static_cast<int32_t>(len));
+            curSpanBlock_->covers = coverPtr_++;
+            x += len;
+            spanLength -= len;
+        }
+        lastScaneLineXCoord_ = x - 1;
+    }
+
+    void Finalize(int32_t y)
+    {
+        scaneLineYCoord_ = y;
+    }
+
+    void ResetSpans()
+    {
+        lastScaneLineXCoord_ = 0x7FFFFFF0;
+        coverPtr_ = &arrayCovers_[0];
+        curSpanBlock_ = &arraySpans_[0];
+        curSpanBlock_->spanLength = 0;
+    }
+
+    int32_t GetYLevel() const
+    {
+        return scaneLineYCoord_;
+    }
+    uint32_t NumSpans() const
+    {
+        return uint32_t(curSpanBlock_ - &arraySpans_[0]);
+    }
+    ConstIterator Begin() const
+    {
+        return &arraySpans_[1];
+    }
+    Iterator Begin()
+    {
+        return &arraySpans_[1];
+    }
+
+private:
+    GeometryScanlineSparse(const GeometryScanlineSparse&);
+    const GeometryScanlineSparse& operator=(const GeometryScanlineSparse&);
+
+    int32_t lastScaneLineXCoord_;
+    int32_t scaneLineYCoord_;
+    GeometryPlainDataArray<uint8_t> arrayCovers_;
+    GeometryPlainDataArray<SpanBlock> arraySpans_;
+    SpanBlock* curSpanBlock_;
+    uint8_t* coverPtr_;
+};
 } // namespace OHOS
 #endif
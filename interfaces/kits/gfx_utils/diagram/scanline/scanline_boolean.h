@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_boolean.h
+ * @brief Defines the boolean operations of anti-aliased scanlines
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_BOOLEAN_H
+#define GRAPHIC_LITE_SCANLINE_BOOLEAN_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+namespace OHOS {
+/**
+ * @brief Boolean operations of two coverages a and b, covers are in 0..255.
+ * Intersect gives a * b, union a + b - a * b, xor a + b folded back above full cover
+ * and subtract a * (1 - b).
+ * @since 1.0
+ * @version 1.0
+ */
+enum ScanlineBoolOperation {
+    SCANLINE_BOOL_INTERSECT,
+    SCANLINE_BOOL_UNION,
+    SCANLINE_BOOL_XOR,
+    SCANLINE_BOOL_SUBTRACT
+};
+
+/**
+ * @brief Combines the covers a and b with the operation.
+ * @since 1.0
+ * @version 1.0
+ */
+inline uint8_t CombineCovers(ScanlineBoolOperation op, uint8_t a, uint8_t b)
+{
+    switch (op) {
+        case SCANLINE_BOOL_INTERSECT:
+            return Rgba8T::Multiply(a, b);
+        case SCANLINE_BOOL_UNION:
+            return a + b - Rgba8T::Multiply(a, b);
+        case SCANLINE_BOOL_XOR: {
+            uint32_t cover = a + b;
+            return (cover > OPA_OPAQUE) ? (OPA_OPAQUE * 2 - cover) : cover; // 2: fold back above full cover
+        }
+        case SCANLINE_BOOL_SUBTRACT:
+            return Rgba8T::Multiply(a, OPA_OPAQUE - b);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Walks the spans of a scanline pixel range by pixel range, solid runs of GeometryScanlineSparse
+ * (negative spanLength) give one cover for the whole run.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline>
+class ScanlineSpanCursor {
+public:
+    explicit ScanlineSpanCursor(const Scanline& sl) : span_(sl.Begin()), remain_(sl.NumSpans())
+    {
+        Load();
+    }
+
+    bool IsEnd() const
+    {
+        return remain_ == 0;
+    }
+
+    /**
+     * @brief First pixel not consumed yet.
+     */
+    int32_t GetX() const
+    {
+        return x_;
+    }
+
+    /**
+     * @brief End of the current span, exclusive.
+     */
+    int32_t GetEnd() const
+    {
+        return end_;
+    }
+
+    bool IsSolid() const
+    {
+        return span_->spanLength < 0;
+    }
+
+    uint8_t GetCover(int32_t x) const
+    {
+        return IsSolid() ? *span_->covers : span_->covers[x - span_->x];
+    }
+
+    /**
+     * @brief Covers from pixel x on, only for a span which is not solid.
+     */
+    const uint8_t* GetCovers(int32_t x) const
+    {
+        return span_->covers + (x - span_->x);
+    }
+
+    /**
+     * @brief Consumes the pixels up to x, exclusive.
+     */
+    void Skip(int32_t x)
+    {
+        x_ = x;
+        if (x_ >= end_) {
+            ++span_;
+            --remain_;
+            Load();
+        }
+    }
+
+private:
+    void Load()
+    {
+        if (remain_ > 0) {
+            x_ = span_->x;
+            end_ = x_ + ((span_->spanLength < 0) ? -span_->spanLength : span_->spanLength);
+        }
+    }
+
+    typename Scanline::ConstIterator span_;
+    uint32_t remain_;
+    int32_t x_ = 0;
+    int32_t end_ = 0;
+};
+
+/**
+ * @brief Copies the pixels x .. end - 1 of the current span of a cursor into sl.
+ */
+template <class Cursor, class Scanline>
+void CopyCoverRange(const Cursor& cursor, int32_t x, int32_t end, Scanline& sl)
+{
+    if (cursor.IsSolid()) {
+        sl.AddSpan(x, end - x, cursor.GetCover(x));
+    } else {
+        sl.AddCells(x, end - x, cursor.GetCovers(x));
+    }
+}
+
+/**
+ * @brief Combines two scanlines of the same row into sl, both are walked once from left to right
+ * so the cost is linear in the number of spans. Pixels covered by only one side keep their cover
+ * when the operation allows it, a range where both sides are solid becomes one solid span.
+ * sl must be reset to a range holding both scanlines and is not finalized.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline1, class Scanline2, class Scanline>
+void CombineScanlines(ScanlineBoolOperation op, const Scanline1& sl1, const Scanline2& sl2, Scanline& sl)
+{
+    ScanlineSpanCursor<Scanline1> a(sl1);
+    ScanlineSpanCursor<Scanline2> b(sl2);
+    bool keepA = op != SCANLINE_BOOL_INTERSECT;
+    bool keepB = op == SCANLINE_BOOL_UNION || op == SCANLINE_BOOL_XOR;
+    while (!a.IsEnd() || !b.IsEnd()) {
+        bool inA = !a.IsEnd() && (b.IsEnd() || a.GetX() <= b.GetX());
+        bool inB = !b.IsEnd() && (a.IsEnd() || b.GetX() <= a.GetX());
+        int32_t x = inA ? a.GetX() : b.GetX();
+        int32_t end;
+        if (inA && inB) {
+            end = MATH_MIN(a.GetEnd(), b.GetEnd());
+        } else if (inA) {
+            end = b.IsEnd() ? a.GetEnd() : MATH_MIN(a.GetEnd(), b.GetX());
+        } else {
+            end = a.IsEnd() ? b.GetEnd() : MATH_MIN(b.GetEnd(), a.GetX());
+        }
+        if (inA && inB) {
+            if (a.IsSolid() && b.IsSolid()) {
+                uint8_t cover = CombineCovers(op, a.GetCover(x), b.GetCover(x));
+                if (cover != 0) {
+                    sl.AddSpan(x, end - x, cover);
+                }
+            } else {
+                for (int32_t i = x; i < end; i++) {
+                    uint8_t cover = CombineCovers(op, a.GetCover(i), b.GetCover(i));
+                    if (cover != 0) {
+                        sl.AddCell(i, cover);
+                    }
+                }
+            }
+        } else if (inA && keepA) {
+            CopyCoverRange(a, x, end, sl);
+        } else if (inB && keepB) {
+            CopyCoverRange(b, x, end, sl);
+        }
+        if (inA) {
+            a.Skip(end);
+        }
+        if (inB) {
+            b.Skip(end);
+        }
+    }
+}
+
+/**
+ * @brief Sweeps the scanlines of two rasterizers row by row in lockstep and combines them, the
+ * result is swept like a rasterizer: RewindScanlines, then SweepScanline until it returns false.
+ * ras1 is the first operand, for clipping a fill the clip path with SCANLINE_BOOL_INTERSECT,
+ * or the fill with SCANLINE_BOOL_SUBTRACT to cut the clip path out of it. Rows where only one side
+ * has spans are skipped for intersect, and for subtract when only ras2 has spans.
+ * No mask of the whole area is kept, only the two scanlines of the current row.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline1, class Scanline2>
+class ScanlineBooleanSweeper {
+public:
+    ScanlineBooleanSweeper(RasterizerScanlineAntialias& ras1, RasterizerScanlineAntialias& ras2,
+                           Scanline1& sl1, Scanline2& sl2, ScanlineBoolOperation op)
+        : ras1_(ras1), ras2_(ras2), sl1_(sl1), sl2_(sl2), op_(op), has1_(false), has2_(false),
+          minX_(0), maxX_(0) {}
+
+    /**
+     * @brief Rewinds both rasterizers and reads their first rows.
+     * @return false if the result is empty for sure.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool RewindScanlines()
+    {
+        has1_ = ras1_.RewindScanlines();
+        has2_ = ras2_.RewindScanlines();
+        if (has1_) {
+            sl1_.Reset(ras1_.GetMinX(), ras1_.GetMaxX());
+            has1_ = ras1_.SweepScanline(sl1_);
+        }
+        if (has2_) {
+            sl2_.Reset(ras2_.GetMinX(), ras2_.GetMaxX());
+            has2_ = ras2_.SweepScanline(sl2_);
+        }
+        if (has1_ && has2_) {
+            if (op_ == SCANLINE_BOOL_INTERSECT) {
+                minX_ = MATH_MAX(ras1_.GetMinX(), ras2_.GetMinX());
+                maxX_ = MATH_MIN(ras1_.GetMaxX(), ras2_.GetMaxX());
+                return minX_ <= maxX_ && MATH_MAX(ras1_.GetMinY(), ras2_.GetMinY()) <=
+                                             MATH_MIN(ras1_.GetMaxY(), ras2_.GetMaxY());
+            }
+            if (op_ == SCANLINE_BOOL_SUBTRACT) {
+                minX_ = ras1_.GetMinX();
+                maxX_ = ras1_.GetMaxX();
+            } else {
+                minX_ = MATH_MIN(ras1_.GetMinX(), ras2_.GetMinX());
+                maxX_ = MATH_MAX(ras1_.GetMaxX(), ras2_.GetMaxX());
+            }
+            return true;
+        }
+        if (has1_ && op_ != SCANLINE_BOOL_INTERSECT) {
+            minX_ = ras1_.GetMinX();
+            maxX_ = ras1_.GetMaxX();
+            return true;
+        }
+        if (has2_ && (op_ == SCANLINE_BOOL_UNION || op_ == SCANLINE_BOOL_XOR)) {
+            minX_ = ras2_.GetMinX();
+            maxX_ = ras2_.GetMaxX();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Range of the result, sl of SweepScanline is reset with it.
+     */
+    int32_t GetMinX() const
+    {
+        return minX_;
+    }
+
+    int32_t GetMaxX() const
+    {
+        return maxX_;
+    }
+
+    /**
+     * @brief Combines the next rows into sl.
+     * @return false when there is no more row with spans.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class Scanline>
+    bool SweepScanline(Scanline& sl)
+    {
+        bool keep2 = op_ == SCANLINE_BOOL_UNION || op_ == SCANLINE_BOOL_XOR;
+        while (has1_ || has2_) {
+            if (op_ == SCANLINE_BOOL_INTERSECT && !(has1_ && has2_)) {
+                has1_ = false;
+                has2_ = false;
+                return false;
+            }
+            sl.ResetSpans();
+            int32_t y;
+            if (has1_ && (!has2_ || sl1_.GetYLevel() < sl2_.GetYLevel())) {
+                y = sl1_.GetYLevel();
+                if (op_ != SCANLINE_BOOL_INTERSECT) {
+                    CombineScanlines(op_, sl1_, empty_, sl);
+                }
+                has1_ = ras1_.SweepScanline(sl1_);
+            } else if (!has1_ || sl2_.GetYLevel() < sl1_.GetYLevel()) {
+                y = sl2_.GetYLevel();
+                if (keep2) {
+                    CombineScanlines(op_, empty_, sl2_, sl);
+                } else if (!has1_) {
+                    has2_ = false;
+                    return false;
+                }
+                has2_ = ras2_.SweepScanline(sl2_);
+            } else {
+                y = sl1_.GetYLevel();
+                CombineScanlines(op_, sl1_, sl2_, sl);
+                has1_ = ras1_.SweepScanline(sl1_);
+                has2_ = ras2_.SweepScanline(sl2_);
+            }
+            if (sl.NumSpans() > 0) {
+                sl.Finalize(y);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    /* A scanline without spans for the rows of one side only */
+    struct EmptyScanline {
+        using ConstIterator = typename Scanline1::ConstIterator;
+        ConstIterator Begin() const
+        {
+            return nullptr;
+        }
+        uint32_t NumSpans() const
+        {
+            return 0;
+        }
+    };
+
+    ScanlineBooleanSweeper(const ScanlineBooleanSweeper&);
+    ScanlineBooleanSweeper& operator=(const ScanlineBooleanSweeper&);
+
+    RasterizerScanlineAntialias& ras1_;
+    RasterizerScanlineAntialias& ras2_;
+    Scanline1& sl1_;
+    Scanline2& sl2_;
+    ScanlineBoolOperation op_;
+    bool has1_;
+    bool has2_;
+    int32_t minX_;
+    int32_t maxX_;
+    EmptyScanline empty_;
+};
+} // namespace OHOS
+#endif
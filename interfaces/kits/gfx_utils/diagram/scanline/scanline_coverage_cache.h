@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_coverage_cache.h
+ * @brief Defines the cache of swept scanline coverage
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_COVERAGE_CACHE_H
+#define GRAPHIC_LITE_SCANLINE_COVERAGE_CACHE_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/trans_affine.h"
+
+namespace OHOS {
+const uint32_t SCANLINE_COVERAGE_CACHE_MEMORY = 256 * 1024;
+const uint32_t SCANLINE_COVERAGE_CACHE_BUCKETS = 64;
+
+/**
+ * @brief Identifies a cached coverage: the path, the transform without its integer translation
+ * and the filling rule. The fraction of the translation is kept in 1/256 pixel.
+ */
+struct CoverageCacheKey {
+    uint32_t pathHash;
+    uint32_t matrix[4]; // 4: scale and shear, bit patterns of the floats
+    int32_t fracX;
+    int32_t fracY;
+    uint32_t rule;
+    uint32_t hash;
+};
+
+/**
+ * @brief Recorded scanline, numSpans CoverageCacheSpan follow it.
+ */
+struct CoverageCacheRow {
+    int32_t y;
+    uint32_t numSpans;
+};
+
+/**
+ * @brief Recorded span, the covers follow it padded to 4 bytes: spanLength bytes,
+ * or one byte for a solid run of -spanLength pixels.
+ */
+struct CoverageCacheSpan {
+    int32_t x;
+    int32_t spanLength;
+};
+
+/**
+ * @brief Recorded scanlines of one path.
+ */
+struct CoverageCacheData {
+    const uint8_t* data;
+    uint32_t size;
+};
+
+struct CoverageCacheEntry;
+
+/**
+ * @brief Caches the swept scanlines of static paths so that a path drawn again with the same
+ * transform, up to an integer translation, is replayed at an offset instead of being flattened,
+ * rasterized and sorted again. Entries are evicted in LRU order once the memory limit is exceeded.
+ * The cache is not thread safe.
+ * @since 1.0
+ * @version 1.0
+ */
+class ScanlineCoverageCache : public HeapBase {
+public:
+    explicit ScanlineCoverageCache(uint32_t memoryLimit = SCANLINE_COVERAGE_CACHE_MEMORY);
+
+    ~ScanlineCoverageCache();
+
+    /**
+     * @brief Hashes the commands and the coordinates of a vertex source, the untransformed path
+     * is the usual identity of a cached shape.
+     */
+    template <class VertexSource>
+    static uint32_t HashPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        float x;
+        float y;
+        uint32_t cmd;
+        uint32_t hash = HashWord(FNV_OFFSET_BASIS, pathId);
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&x, &y))) {
+            hash = HashWord(HashWord(HashWord(hash, cmd), FloatBits(x)), FloatBits(y));
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Builds the key of a path drawn with transform.
+     * @param local Receives transform with the integer translation removed, the path is rasterized with it
+     * @param offsetX Receives the integer x translation the coverage is replayed at
+     * @param offsetY Receives the integer y translation the coverage is replayed at
+     */
+    static CoverageCacheKey MakeKey(uint32_t pathHash, const TransAffine& transform, FillingRule rule,
+                                    TransAffine& local, int32_t& offsetX, int32_t& offsetY);
+
+    /**
+     * @brief Looks the key up and counts a hit or a miss.
+     * @return The recorded scanlines, data is nullptr on a miss. Valid until the next Record.
+     */
+    CoverageCacheData Find(const CoverageCacheKey& key);
+
+    /**
+     * @brief Sweeps the rasterizer and records its scanlines under key, the least recently used
+     * entries are evicted to make room.
+     * @return The recorded scanlines, valid until the next Record. When the scanlines do not fit in
+     * the memory limit they are returned without being cached.
+     */
+    CoverageCacheData Record(const CoverageCacheKey& key, RasterizerScanlineAntialias& ras);
+
+    /**
+     * @brief Rasterizes path with the filling rule and without clipping on a rasterizer owned by the cache,
+     * then records it under key like Record. Rasterizers of the caller are left untouched.
+     */
+    template <class VertexSource>
+    CoverageCacheData RecordPath(const CoverageCacheKey& key, VertexSource& path, FillingRule rule)
+    {
+        ras_.Reset();
+        ras_.SetFillingRule(rule);
+        ras_.AddPath(path);
+        return Record(key, ras_);
+    }
+
+    /**
+     * @brief Blends the recorded scanlines moved by (offsetX, offsetY) with a solid color,
+     * the renderer is a ScanlineSolidBlenderARGB8888 or provides the same two blend functions.
+     */
+    template <class Renderer>
+    static void Replay(const CoverageCacheData& coverage, int32_t offsetX, int32_t offsetY,
+                       Renderer& renderer, const Rgba8T& color)
+    {
+        const uint8_t* ptr = coverage.data;
+        const uint8_t* end = ptr + coverage.size;
+        while (ptr < end) {
+            const CoverageCacheRow* row = reinterpret_cast<const CoverageCacheRow*>(ptr);
+            ptr += sizeof(CoverageCacheRow);
+            int32_t y = row->y + offsetY;
+            for (uint32_t i = 0; i < row->numSpans; i++) {
+                const CoverageCacheSpan* span = reinterpret_cast<const CoverageCacheSpan*>(ptr);
+                const uint8_t* covers = ptr + sizeof(CoverageCacheSpan);
+                if (span->spanLength > 0) {
+                    renderer.BlendSolidHSpan(span->x + offsetX, y, span->spanLength, color, covers);
+                } else {
+                    renderer.BlendHLine(span->x + offsetX, y, -span->spanLength, color, *covers);
+                }
+                ptr = covers + GetCoverBytes(span->spanLength);
+            }
+        }
+    }
+
+    /**
+     * @brief Sets the memory kept for the recorded scanlines, entries are evicted until it fits.
+     * @param bytes Memory limit in bytes, 0 disables caching
+     */
+    void SetMemoryLimit(uint32_t bytes);
+
+    uint32_t GetMemoryLimit() const
+    {
+        return memoryLimit_;
+    }
+
+    uint32_t GetMemoryUsage() const
+    {
+        return memoryUsage_;
+    }
+
+    uint32_t GetEntryCount() const
+    {
+        return entryCount_;
+    }
+
+    uint32_t GetHitCount() const
+    {
+        return hitCount_;
+    }
+
+    uint32_t GetMissCount() const
+    {
+        return missCount_;
+    }
+
+    void ResetCounters()
+    {
+        hitCount_ = 0;
+        missCount_ = 0;
+    }
+
+    /**
+     * @brief Frees every entry.
+     */
+    void Clear();
+
+    /**
+     * @brief Bytes of the covers behind a span, padded to 4.
+     */
+    static uint32_t GetCoverBytes(int32_t spanLength)
+    {
+        uint32_t bytes = (spanLength > 0) ? static_cast<uint32_t>(spanLength) : 1;
+        return (bytes + 3) & ~3U; // 3: pad to 4 bytes
+    }
+
+private:
+    static constexpr uint32_t FNV_OFFSET_BASIS = 2166136261;
+    static constexpr uint32_t FNV_PRIME = 16777619;
+
+    ScanlineCoverageCache(const ScanlineCoverageCache&);
+    ScanlineCoverageCache& operator=(const ScanlineCoverageCache&);
+
+    static uint32_t HashWord(uint32_t hash, uint32_t word);
+    static uint32_t FloatBits(float value);
+    static bool Match(const CoverageCacheKey& key1, const CoverageCacheKey& key2);
+
+    bool AppendScanline(uint32_t& size, const GeometryScanlineSparse& sl);
+    bool ReserveScratch(uint32_t size);
+    void Unlink(CoverageCacheEntry* entry);
+    void PushFront(CoverageCacheEntry* entry);
+    void Free(CoverageCacheEntry* entry);
+    void Trim(uint32_t limit);
+
+    CoverageCacheEntry* buckets_[SCANLINE_COVERAGE_CACHE_BUCKETS];
+    CoverageCacheEntry* head_;
+    CoverageCacheEntry* tail_;
+    RasterizerScanlineAntialias ras_;
+    GeometryScanlineSparse sl_;
+    uint8_t* scratch_;
+    uint32_t scratchCapacity_;
+    uint32_t memoryLimit_;
+    uint32_t memoryUsage_;
+    uint32_t entryCount_;
+    uint32_t hitCount_;
+    uint32_t missCount_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_mask_a8.h
+ * @brief Defines the A8 coverage mask of a rasterized path
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_MASK_A8_H
+#define GRAPHIC_LITE_SCANLINE_MASK_A8_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+
+namespace OHOS {
+/**
+ * @brief Coverage of a rasterized path as one byte per pixel.
+ * Render sweeps the rasterizer straight into the mask: covers are copied and solid runs are filled.
+ * The mask keeps the position of the path, so it can be computed once and blended for clipping,
+ * shadows or hit regions on later frames and other layers, moved by an offset.
+ * @since 1.0
+ * @version 1.0
+ */
+class ScanlineMaskA8 : public HeapBase {
+public:
+    ScanlineMaskA8()
+        : buffer_(nullptr), ownBuffer_(nullptr), capacity_(0), width_(0), height_(0), stride_(0),
+          originX_(0), originY_(0), attached_(false) {}
+
+    ~ScanlineMaskA8();
+
+    /**
+     * @brief Renders into an external buffer instead of an own one, the path is clipped to it.
+     * @param buffer width x height bytes with rows of stride bytes
+     * @param originX x of the first column of the buffer
+     * @param originY y of the first row of the buffer
+     * @since 1.0
+     * @version 1.0
+     */
+    void Attach(uint8_t* buffer, int32_t width, int32_t height, int32_t stride, int32_t originX, int32_t originY);
+
+    /**
+     * @brief Renders into an own buffer sized from the bounds of the next rasterizer, the default.
+     */
+    void Detach();
+
+    /**
+     * @brief Clears the mask and sweeps the rasterizer into it.
+     * An own buffer covers GetMinX to GetMaxX and GetMinY to GetMaxY of the rasterizer, rows padded to 4 bytes.
+     * @return false if the rasterizer is empty, its bounds need a too large buffer or no memory is left,
+     * the mask is then empty.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Render(RasterizerScanlineAntialias& ras);
+
+    /**
+     * @brief Blends a solid color through the mask into an ARGB8888 buffer, the mask is moved by offset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlendSolid(uint8_t* dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride,
+                    int32_t offsetX, int32_t offsetY, const Rgba8T& color) const;
+
+    /**
+     * @brief Blends an ARGB8888 source through the mask into an ARGB8888 buffer of the same size,
+     * every pixel gets the source pixel with its alpha times the mask. Transparent mask words are skipped,
+     * opaque mask words over an opaque source are copied. The mask is moved by offset.
+     * @since 1.0
+     * @version 1.0
+     */
+    void BlendARGB8888(uint8_t* dst, int32_t dstWidth, int32_t dstHeight, int32_t dstStride,
+                       const uint8_t* src, int32_t srcStride, int32_t offsetX, int32_t offsetY) const;
+
+    /**
+     * @brief Cover at (x, y) in path coordinates, 0 outside of the mask.
+     */
+    uint8_t GetCover(int32_t x, int32_t y) const
+    {
+        x -= originX_;
+        y -= originY_;
+        if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+            return 0;
+        }
+        return buffer_[static_cast<size_t>(y) * stride_ + x];
+    }
+
+    const uint8_t* GetBuffer() const
+    {
+        return buffer_;
+    }
+
+    int32_t GetWidth() const
+    {
+        return width_;
+    }
+
+    int32_t GetHeight() const
+    {
+        return height_;
+    }
+
+    int32_t GetStride() const
+    {
+        return stride_;
+    }
+
+    int32_t GetOriginX() const
+    {
+        return originX_;
+    }
+
+    int32_t GetOriginY() const
+    {
+        return originY_;
+    }
+
+private:
+    ScanlineMaskA8(const ScanlineMaskA8&);
+    ScanlineMaskA8& operator=(const ScanlineMaskA8&);
+
+    bool Allocate(int32_t width, int32_t height);
+    void Clear();
+    bool Clip(int32_t dstWidth, int32_t dstHeight, int32_t offsetX, int32_t offsetY,
+              int32_t& left, int32_t& top, int32_t& right, int32_t& bottom) const;
+
+    GeometryScanlineSparse sl_;
+    uint8_t* buffer_;
+    uint8_t* ownBuffer_;
+    uint32_t capacity_;
+    int32_t width_;
+    int32_t height_;
+    int32_t stride_;
+    int32_t originX_;
+    int32_t originY_;
+    bool attached_;
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file scanline_render_solid.h
+ * @brief Defines the solid color scanline render
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_SCANLINE_RENDER_SOLID_H
+#define GRAPHIC_LITE_SCANLINE_RENDER_SOLID_H
+
+#include "gfx_utils/color.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_compound_antialias.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/scanline_coverage_cache.h"
+
+namespace OHOS {
+/**
+ * @brief Blends a solid color into an ARGB8888 buffer.
+ * Covered pixels blend with alpha * cover each, a constant cover run computes its alpha once and
+ * an opaque run is a plain fill.
+ * @since 1.0
+ * @version 1.0
+ */
+class ScanlineSolidBlenderARGB8888 {
+public:
+    ScanlineSolidBlenderARGB8888(uint8_t* buffer, int32_t width, int32_t height, int32_t stride)
+        : buffer_(buffer), width_(width), height_(height), stride_(stride) {}
+
+    /**
+     * @brief Blends len pixels from (x, y), every pixel has its own cover.
+     */
+    void BlendSolidHSpan(int32_t x, int32_t y, int32_t len, const Rgba8T& color, const uint8_t* covers)
+    {
+        int32_t skip = 0;
+        if (!ClipSpan(x, y, len, skip)) {
+            return;
+        }
+        covers += skip;
+        uint8_t* pixel = buffer_ + y * stride_ + x * ARGB_BYTES;
+        for (int32_t i = 0; i < len; i++, pixel += ARGB_BYTES) {
+            BlendPixel(pixel, color, Rgba8T::Multiply(color.alpha, covers[i]));
+        }
+    }
+
+    /**
+     * @brief Blends len pixels from (x, y) with one cover.
+     */
+    void BlendHLine(int32_t x, int32_t y, int32_t len, const Rgba8T& color, uint8_t cover)
+    {
+        int32_t skip = 0;
+        if (!ClipSpan(x, y, len, skip)) {
+            return;
+        }
+        uint8_t* pixel = buffer_ + y * stride_ + x * ARGB_BYTES;
+        uint8_t alpha = Rgba8T::Multiply(color.alpha, cover);
+        if (alpha == OPA_OPAQUE) {
+            Color32 fill;
+            fill.red = color.red;
+            fill.green = color.green;
+            fill.blue = color.blue;
+            fill.alpha = OPA_OPAQUE;
+            uint32_t* dst = reinterpret_cast<uint32_t*>(pixel);
+            for (int32_t i = 0; i < len; i++) {
+                dst[i] = fill.full;
+            }
+            return;
+        }
+        for (int32_t i = 0; i < len; i++, pixel += ARGB_BYTES) {
+            BlendPixel(pixel, color, alpha);
+        }
+    }
+
+private:
+    static constexpr int32_t ARGB_BYTES = 4;
+
+    static void BlendPixel(uint8_t* pixel, const Rgba8T& color, uint8_t alpha)
+    {
+        Color32* dst = reinterpret_cast<Color32*>(pixel);
+        dst->red = Rgba8T::Lerp(dst->red, color.red, alpha);
+        dst->green = Rgba8T::Lerp(dst->green, color.green, alpha);
+        dst->blue = Rgba8T::Lerp(dst->blue, color.blue, alpha);
+        dst->alpha = Rgba8T::Prelerp(dst->alpha, alpha, alpha);
+    }
+
+    bool ClipSpan(int32_t& x, int32_t y, int32_t& len, int32_t& skip) const
+    {
+        if (y < 0 || y >= height_) {
+            return false;
+        }
+        if (x < 0) {
+            skip = -x;
+            len += x;
+            x = 0;
+        }
+        if (x + len > width_) {
+            len = width_ - x;
+        }
+        return len > 0;
+    }
+
+    uint8_t* buffer_;
+    int32_t width_;
+    int32_t height_;
+    int32_t stride_;
+};
+
+/**
+ * @brief Renders one scanline with a solid color.
+ * Spans with per pixel covers go to BlendSolidHSpan, solid runs of GeometryScanlineSparse
+ * (negative spanLength) go to BlendHLine with their single cover.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline, class Renderer>
+void RenderScanlineSolid(const Scanline& sl, Renderer& renderer, const Rgba8T& color)
+{
+    int32_t y = sl.GetYLevel();
+    uint32_t numSpans = sl.NumSpans();
+    typename Scanline::ConstIterator span = sl.Begin();
+    for (; numSpans > 0; --numSpans, ++span) {
+        if (span->spanLength > 0) {
+            renderer.BlendSolidHSpan(span->x, y, span->spanLength, color, span->covers);
+        } else {
+            renderer.BlendHLine(span->x, y, -span->spanLength, color, *span->covers);
+        }
+    }
+}
+
+/**
+ * @brief Sweeps every scanline of the rasterizer and renders it with a solid color.
+ * The scanline type selects the storage: GeometryScanline keeps a cover byte per pixel,
+ * GeometryScanlineSparse keeps solid spans as runs which are filled with a constant alpha.
+ * The rasterizer is RasterizerScanlineAntialias or anything swept the same way, like ScanlineBooleanSweeper.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Rasterizer, class Scanline, class Renderer>
+void RenderScanlinesSolid(Rasterizer& raster, Scanline& sl, Renderer& renderer, const Rgba8T& color)
+{
+    if (!raster.RewindScanlines()) {
+        return;
+    }
+    sl.Reset(raster.GetMinX(), raster.GetMaxX());
+    while (raster.SweepScanline(sl)) {
+        RenderScanlineSolid(sl, renderer, color);
+    }
+}
+
+#if GRAPHIC_ENABLE_COMPOUND_RASTERIZER_FLAG
+/**
+ * @brief Sweeps every scanline of the compound rasterizer and renders the spans of each style with
+ * colors[style], styles without a color are skipped. Styles of a scanline are rendered in ascending
+ * order so a higher style covers a lower one.
+ * @since 1.0
+ * @version 1.0
+ */
+template <class Scanline, class Renderer>
+void RenderScanlinesCompoundSolid(RasterizerCompoundAntialias& raster, Scanline& sl, Renderer& renderer,
+                                  const Rgba8T* colors, uint32_t colorNum)
+{
+    if (colors == nullptr || !raster.RewindScanlines()) {
+        return;
+    }
+    sl.Reset(raster.GetMinX(), raster.GetMaxX());
+    uint32_t numStyles;
+    while ((numStyles = raster.SweepStyles()) > 0) {
+        for (uint32_t i = 0; i < numStyles; i++) {
+            uint32_t style = static_cast<uint32_t>(raster.GetStyle(i));
+            if (style < colorNum && raster.SweepScanline(sl, i)) {
+                RenderScanlineSolid(sl, renderer, colors[style]);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Renders a static path with a solid color through a coverage cache.
+ * On a hit the recorded scanlines are replayed at the integer translation of transform, on a miss the path
+ * is rasterized with the remaining fractional transform and recorded first.
+ * Misses are rasterized with the rasterizer of the cache, without clipping since the device clip box does
+ * not apply at the fractional transform. The renderer clips the replayed spans.
+ * @param pathHash Identity of the path, for example ScanlineCoverageCache::HashPath of it
+ * @since 1.0
+ * @version 1.0
+ */
+template <class VertexSource, class Renderer>
+void RenderScanlinesSolidCached(ScanlineCoverageCache& cache, VertexSource& path, uint32_t pathHash,
+                                const TransAffine& transform, FillingRule rule, Renderer& renderer, const Rgba8T& color)
+{
+    TransAffine local;
+    int32_t offsetX;
+    int32_t offsetY;
+    CoverageCacheKey key = ScanlineCoverageCache::MakeKey(pathHash, transform, rule, local, offsetX, offsetY);
+    CoverageCacheData coverage = cache.Find(key);
+    if (coverage.data == nullptr) {
+        DepictTransform<VertexSource> transformed(path, local);
+        coverage = cache.RecordPath(key, transformed, rule);
+    }
+    ScanlineCoverageCache::Replay(coverage, offsetX, offsetY, renderer, color);
+}
+} // namespace OHOS
+#endif
@@ -161,6 +161,50 @@ public:
         return index;
     }
 
+    /**
+     * @brief Terms of Calculate that only depend on y, shared by the pixels of one row.
+     */
+    struct RadialRow {
+        float dy;
+        float dyDx;
+        float dyDy;
+        float dySquare;
+    };
+
+    void PrepareRow(int16_t y, RadialRow& row) const
+    {
+        row.dy = y - dy_;
+        row.dyDx = row.dy * dx_;
+        row.dyDy = row.dy * dy_;
+        row.dySquare = row.dy * row.dy;
+    }
+
+    /**
+     * @brief Same result as Calculate(x, y, ...) for the y given to PrepareRow.
+     */
+    int16_t CalculateInRow(int16_t x, const RadialRow& row, int16_t startRadius, int16_t endRadius,
+                           int16_t size) const
+    {
+        float dx = x - dx_;
+        float distanceRadius = dx * dy_ - row.dyDx;
+        float radiusDistance = endRadiusSquare_ * (dx * dx + row.dySquare)
+                - distanceRadius * distanceRadius;
+        float deltaRadius = endRadius - startRadius; // Difference of radius
+        if (deltaRadius < 1) {
+            deltaRadius = 1;
+        }
+        int16_t index = (((dx * dx_ + row.dyDy +
+                        Sqrt(fabs(radiusDistance)))
+                        * mul_ - startRadius) * size) / deltaRadius;
+        if (index < 0) {
+            index = 0;
+        }
+        if (index >= size) {
+            index = size - 1;
+        }
+        return index;
+    }
+
 private:
     /**
      * @brief update mul_
@@ -232,5 +276,133 @@ public:
     }
 #endif
 };
+
+/**
+ * @brief Gradient scanline fill bound to the gradient function type at compile time.
+ * Calculate is called without virtual dispatch and every pixel is stored as a whole Rgba8T.
+ * GradientLinearCalculate and GradientRadialCalculate have dedicated span loops: the linear index is
+ * stepped with integer increments when the transformed span advances by a constant whole step
+ * (identity, translation and integer scales), the radial one shares the row terms when y is constant.
+ * The output is the same as FillGradient with the same arguments.
+ */
+template <class GradientFunction>
+class FillGradientFast : public SpanBase {
+#if GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+public:
+    FillGradientFast(FillInterpolator& inter, GradientFunction& gradientFunction,
+                     FillGradientLut& colorFunction, float distance1, float distance2)
+        : interpolator_(&inter),
+          gradientFunction_(&gradientFunction),
+          colorFunction_(&colorFunction),
+          distance1_(distance1 * GRADIENT_SUBPIXEL_SCALE),
+          distance2_(distance2 * GRADIENT_SUBPIXEL_SCALE) {}
+
+    void Prepare() {}
+
+    void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        interpolator_->Begin(x, y, len);
+        GenerateSpan(gradientFunction_, span, len);
+    }
+
+private:
+    static constexpr int32_t DOWNSCALE_SHIFT = FillInterpolator::SUBPIXEL_SHIFT - GRADIENT_SUBPIXEL_SHIFT;
+
+    template <class Function>
+    void GenerateSpan(Function* function, Rgba8T* span, uint32_t len)
+    {
+        int32_t x;
+        int32_t y;
+        int16_t size = colorFunction_->GetSize();
+        for (; len; --len, ++(*interpolator_), ++span) {
+            interpolator_->Coordinates(&x, &y);
+            *span = (*colorFunction_)[function->Function::Calculate(x >> DOWNSCALE_SHIFT, y >> DOWNSCALE_SHIFT,
+                                                                    distance1_, distance2_, size)];
+        }
+    }
+
+    void GenerateSpan(GradientRadialCalculate* function, Rgba8T* span, uint32_t len)
+    {
+        int32_t deltaX;
+        int32_t deltaY;
+        interpolator_->GetSpanDelta(&deltaX, &deltaY);
+        if (deltaY != 0) {
+            GenerateSpan<GradientRadialCalculate>(function, span, len);
+            return;
+        }
+        int32_t x;
+        int32_t y;
+        int16_t size = colorFunction_->GetSize();
+        interpolator_->Coordinates(&x, &y);
+        GradientRadialCalculate::RadialRow row;
+        function->PrepareRow(y >> DOWNSCALE_SHIFT, row);
+        for (; len; --len, ++(*interpolator_), ++span) {
+            interpolator_->Coordinates(&x, &y);
+            *span = (*colorFunction_)[function->CalculateInRow(x >> DOWNSCALE_SHIFT, row, distance1_,
+                                                               distance2_, size)];
+        }
+    }
+
+    void GenerateSpan(GradientLinearCalculate* function, Rgba8T* span, uint32_t len)
+    {
+        int32_t deltaX;
+        int32_t deltaY;
+        interpolator_->GetSpanDelta(&deltaX, &deltaY);
+        int32_t x;
+        int32_t y;
+        interpolator_->Coordinates(&x, &y);
+        int32_t step = (len > 0) ? deltaX / static_cast<int32_t>(len) : 0;
+        int32_t first = x >> DOWNSCALE_SHIFT;
+        int32_t last = first + (step >> DOWNSCALE_SHIFT) * static_cast<int32_t>(len);
+        // the index is only exact when every pixel moves by the same number of gradient subpixels
+        if (len == 0 || deltaX % static_cast<int32_t>(len) != 0 || (step & ((1 << DOWNSCALE_SHIFT) - 1)) != 0 ||
+            MATH_MIN(first, last) < INT16_MIN || MATH_MAX(first, last) > INT16_MAX ||
+            MATH_MAX(MATH_ABS(first), MATH_ABS(last)) * colorFunction_->GetSize() /
+            MATH_MAX(static_cast<int16_t>(distance2_), 1) > INT16_MAX) {
+            GenerateSpan<GradientLinearCalculate>(function, span, len);
+            return;
+        }
+        int16_t size = colorFunction_->GetSize();
+        int32_t distance = MATH_MAX(static_cast<int16_t>(distance2_), 1);
+        // index = floor(numerator / distance), which equals the truncated division of Calculate
+        // whenever it is not clamped to 0
+        int32_t numerator = first * size;
+        int32_t numeratorStep = (step >> DOWNSCALE_SHIFT) * size;
+        int32_t quotient = FloorDiv(numerator, distance);
+        int32_t remainder = numerator - quotient * distance;
+        int32_t quotientStep = FloorDiv(numeratorStep, distance);
+        int32_t remainderStep = numeratorStep - quotientStep * distance;
+        const Rgba8T& firstColor = (*colorFunction_)[0];
+        const Rgba8T& lastColor = (*colorFunction_)[size - 1];
+        for (; len; --len, ++span) {
+            if (quotient <= 0) {
+                *span = firstColor;
+            } else if (quotient >= size) {
+                *span = lastColor;
+            } else {
+                *span = (*colorFunction_)[quotient];
+            }
+            quotient += quotientStep;
+            remainder += remainderStep;
+            if (remainder >= distance) {
+                remainder -= distance;
+                quotient++;
+            }
+        }
+    }
+
+    static int32_t FloorDiv(int32_t numerator, int32_t denominator)
+    {
+        int32_t quotient = numerator / denominator;
+        return (numerator % denominator != 0 && numerator < 0) ? quotient - 1 : quotient;
+    }
+
+    FillInterpolator* interpolator_;
+    GradientFunction* gradientFunction_;
+    FillGradientLut* colorFunction_;
+    int32_t distance1_;
+    int32_t distance2_;
+#endif
+};
 } // namespace OHOS
 #endif
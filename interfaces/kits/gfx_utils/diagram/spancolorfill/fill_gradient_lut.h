@@ -29,9 +29,131 @@
 #include "gfx_utils/diagram/vertexprimitive/geometry_range_adapter.h"
 #include "gfx_utils/diagram/spancolorfill/fill_interpolator.h"
 #include "gfx_utils/vector.h"
+#include "graphic_mutex.h"
 namespace OHOS {
 const uint32_t COLOR_PROFILE_SIZE = 4;
 const uint16_t COLOR_LUT_SIZE = 512;
+const uint32_t GRADIENT_LUT_CACHE_MEMORY = 32 * 1024;
+#if GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
+/**
+ * @brief A gradient stop: the position (0-1) and the color at that position
+ * @since 1.0
+ * @version 1.0
+ */
+struct GradientColorPoint {
+    float offset;
+    Rgba8T color;
+
+    GradientColorPoint() {}
+    /**
+     * @brief Input parameter
+     * @param offsetValue (0-1)
+     * @param color_ Added color
+     */
+    GradientColorPoint(float offsetValue, const Rgba8T& colorValue)
+        : offset(offsetValue), color(colorValue)
+    {
+        if (offset < 0.0) {
+            offset = 0.0;
+        }
+        if (offset > 1.0) {
+            offset = 1.0;
+        }
+    }
+};
+
+struct GradientLutTable;
+
+/**
+ * @brief Process-wide cache of gradient color tables.
+ * Tables are keyed by the sorted stop list and the table size, so gradients with the same stops
+ * share one table no matter how many FillGradientLut objects use them. Tables are reference counted,
+ * unreferenced tables stay cached and are evicted in LRU order once the memory limit is exceeded.
+ * @since 1.0
+ * @version 1.0
+ */
+class GradientLutCache : public HeapBase {
+public:
+    static GradientLutCache* GetInstance();
+
+    /**
+     * @brief Returns the table for the stop list, building it on a miss. The caller owns one reference.
+     * @param points Stops sorted by offset without duplicate offsets, at least two
+     * @param pointNum Number of stops
+     * @param lutSize Number of table entries
+     * @return The table, or nullptr when memory allocation fails
+     */
+    GradientLutTable* Acquire(const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize);
+
+    void AddRef(GradientLutTable* table);
+
+    void Release(GradientLutTable* table);
+
+    static const Rgba8T* GetColors(const GradientLutTable* table);
+
+    /**
+     * @brief Table used before any table is built, COLOR_LUT_SIZE transparent entries.
+     */
+    static const Rgba8T* GetEmptyColors();
+
+    /**
+     * @brief Sets the memory kept for unreferenced tables, tables in use are never evicted.
+     * @param bytes Memory limit in bytes, 0 disables caching of unreferenced tables
+     */
+    void SetMemoryLimit(uint32_t bytes);
+
+    uint32_t GetMemoryLimit() const
+    {
+        return memoryLimit_;
+    }
+
+    uint32_t GetMemoryUsage() const
+    {
+        return memoryUsage_;
+    }
+
+    uint32_t GetHitCount() const
+    {
+        return hitCount_;
+    }
+
+    uint32_t GetMissCount() const
+    {
+        return missCount_;
+    }
+
+    void ResetCounters();
+
+    /**
+     * @brief Frees every table which is not referenced.
+     */
+    void Clear();
+
+private:
+    GradientLutCache()
+        : head_(nullptr), tail_(nullptr), memoryLimit_(GRADIENT_LUT_CACHE_MEMORY),
+          memoryUsage_(0), hitCount_(0), missCount_(0) {}
+    ~GradientLutCache() {}
+
+    static uint32_t Hash(const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize);
+    static bool Match(const GradientLutTable* table, uint32_t hash,
+                      const GradientColorPoint* points, uint16_t pointNum, uint16_t lutSize);
+    static void BuildColors(const GradientColorPoint* points, uint16_t pointNum, Rgba8T* colors, uint16_t lutSize);
+    void Unlink(GradientLutTable* table);
+    void PushFront(GradientLutTable* table);
+    void Free(GradientLutTable* table);
+    void Trim();
+
+    GraphicMutex mutex_;
+    GradientLutTable* head_;
+    GradientLutTable* tail_;
+    uint32_t memoryLimit_;
+    uint32_t memoryUsage_;
+    uint32_t hitCount_;
+    uint32_t missCount_;
+};
+#endif
+
 /**
 * @brief According to remove_all,add_color,and build_lut,
 * build the color gradient process, start, end and middle gradient colors
@@ -42,7 +164,44 @@ const uint16_t COLOR_LUT_SIZE = 512;
 class FillGradientLut {
 #if GRAPHIC_ENABLE_GRADIENT_FILL_FLAG
 public:
-    FillGradientLut() : colorType_(COLOR_LUT_SIZE), colorLutSize_(COLOR_LUT_SIZE), colorProfile_(COLOR_PROFILE_SIZE) {}
+    FillGradientLut()
+        : colorProfile_(COLOR_PROFILE_SIZE), table_(nullptr),
+          colorType_(GradientLutCache::GetEmptyColors()), colorLutSize_(COLOR_LUT_SIZE) {}
+
+    FillGradientLut(const FillGradientLut& lut)
+        : colorProfile_(lut.colorProfile_), table_(lut.table_),
+          colorType_(lut.colorType_), colorLutSize_(lut.colorLutSize_)
+    {
+        if (table_ != nullptr) {
+            GradientLutCache::GetInstance()->AddRef(table_);
+        }
+    }
+
+    ~FillGradientLut()
+    {
+        if (table_ != nullptr) {
+            GradientLutCache::GetInstance()->Release(table_);
+        }
+    }
+
+    FillGradientLut& operator=(const FillGradientLut& lut)
+    {
+        if (this == &lut) {
+            return *this;
+        }
+        if (lut.table_ != nullptr) {
+            GradientLutCache::GetInstance()->AddRef(lut.table_);
+        }
+        if (table_ != nullptr) {
+            GradientLutCache::GetInstance()->Release(table_);
+        }
+        colorProfile_ = lut.colorProfile_;
+        table_ = lut.table_;
+        colorType_ = lut.colorType_;
+        colorLutSize_ = lut.colorLutSize_;
+        return *this;
+    }
+
     /**
      * @brief Remove all colors
      * @since 1.0
@@ -68,7 +227,8 @@ public:
     /**
      * @brief Building a color_typ array from gradient colors
      * Array length 0-255
-     * The contents of the array are distributed on the array according to the gradient color
+     * The contents of the array are distributed on the array according to the gradient color.
+     * The array is looked up in GradientLutCache, so identical gradients share one array
      * @since 1.0
      * @version 1.0
      */
@@ -80,39 +240,16 @@ public:
         QuickSort(colorProfile_, OffsetLess);
         colorProfile_.ReSize(RemoveDuplicates(colorProfile_, OffsetEqual));
         if (colorProfile_.Size() > 1) {
-            uint32_t index;
-            uint32_t start = colorProfile_[0].offset * colorLutSize_;
-            uint32_t end;
-            Rgba8T color = colorProfile_[0].color;
-
-            /*
-             * Assign initial color calculation to colorprofile [0]
-             */
-            for (index = 0; index < start; index++) {
-                colorType_[index] = color;
-            }
-            /*
-             * From 1 to colorprofile Interpolation color calculation between size ()
-             */
-            for (index = 1; index < colorProfile_.Size(); index++) {
-                end = colorProfile_[index].offset * colorLutSize_;
-                ColorInterpolator ci(colorProfile_[index - 1].color,
-                                     colorProfile_[index].color,
-                                     end - start + 1);
-                while (start < end) {
-                    colorType_[start] = ci.GetColor();
-                    ++ci;
-                    ++start;
-                }
+            GradientLutCache* cache = GradientLutCache::GetInstance();
+            GradientLutTable* table = cache->Acquire(colorProfile_.Begin(), colorProfile_.Size(), colorLutSize_);
+            if (table == nullptr) {
+                return;
             }
-            color = colorProfile_.End()->color;
-            /*
-             * Give end color to colorprofile last
-             */
-            for (; end < colorType_.GetSize(); end++) {
-                color = colorProfile_.End()->color;
-                colorType_[end] = color;
+            if (table_ != nullptr) {
+                cache->Release(table_);
             }
+            table_ = table;
+            colorType_ = GradientLutCache::GetColors(table);
         }
     }
 
@@ -132,27 +269,7 @@ public:
         return colorType_[i];
     }
 private:
-    struct ColorPoint {
-        float offset;
-        Rgba8T color;
-
-        ColorPoint() {}
-        /**
-         * @brief Input parameter
-         * @param offsetValue (0-1)
-         * @param color_ Added color
-         */
-        ColorPoint(float offsetValue, const Rgba8T& colorValue)
-            : offset(offsetValue), color(colorValue)
-        {
-            if (offset < 0.0) {
-                offset = 0.0;
-            }
-            if (offset > 1.0) {
-                offset = 1.0;
-            }
-        }
-    };
+    using ColorPoint = GradientColorPoint;
 
     /**
      * @brief OffsetLess Returns the comparison result that the offset of a is smaller than that of B
@@ -178,7 +295,8 @@ private:
         return colorPoint1.offset == colorPoint2.offset;
     }
     Graphic::Vector<ColorPoint> colorProfile_;
-    GeometryPlainDataArray<Rgba8T> colorType_;
+    GradientLutTable* table_;
+    const Rgba8T* colorType_;
     uint16_t colorLutSize_;
 #endif
 };
@@ -96,24 +96,27 @@ public:
      */
     void Begin(float x, float y, uint32_t len)
     {
-        float tx;
-        float ty;
-
-        tx = x;
-        ty = y;
-
-        transType_->Transform(&tx, &ty);
-        int32_t x1 = MATH_ROUND32(tx * SUBPIXEL_SCALE);
-        int32_t y1 = MATH_ROUND32(ty * SUBPIXEL_SCALE);
-
-        tx = x + len;
-        ty = y;
-        transType_->Transform(&tx, &ty);
-        int32_t x2 = MATH_ROUND32(tx * SUBPIXEL_SCALE);
-        int32_t y2 = MATH_ROUND32(ty * SUBPIXEL_SCALE);
+        float tx[2] = {x, x + len}; // 2: start and end of the span
+        float ty[2] = {y, y};       // 2: start and end of the span
+        transType_->TransformBatch(tx, ty, 2); // 2: start and end of the span
+        int32_t x1 = MATH_ROUND32(tx[0] * SUBPIXEL_SCALE);
+        int32_t y1 = MATH_ROUND32(ty[0] * SUBPIXEL_SCALE);
+        int32_t x2 = MATH_ROUND32(tx[1] * SUBPIXEL_SCALE);
+        int32_t y2 = MATH_ROUND32(ty[1] * SUBPIXEL_SCALE);
 
         dda2LineInterpolatorX_ = GeometryDdaLine(x1, x2, len);
         dda2LineInterpolatorY_ = GeometryDdaLine(y1, y2, len);
+        spanDeltaX_ = x2 - x1;
+        spanDeltaY_ = y2 - y1;
+    }
+
+    /**
+     * @brief Subpixel distance between the transformed start and end of the span set by Begin.
+     */
+    void GetSpanDelta(int32_t* deltaX, int32_t* deltaY) const
+    {
+        *deltaX = spanDeltaX_;
+        *deltaY = spanDeltaY_;
     }
 
     /**
@@ -135,6 +138,8 @@ private:
     TransAffine* transType_;
     GeometryDdaLine dda2LineInterpolatorX_;
     GeometryDdaLine dda2LineInterpolatorY_;
+    int32_t spanDeltaX_ = 0;
+    int32_t spanDeltaY_ = 0;
 };
 } // namespace OHOS
 #endif
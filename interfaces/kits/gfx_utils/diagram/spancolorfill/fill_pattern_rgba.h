@@ -15,9 +15,12 @@
 #ifndef GRAPHIC_LITE_FILL_PATTERN_RGBA_H
 #define GRAPHIC_LITE_FILL_PATTERN_RGBA_H
 
+#include <cmath>
 #include <gfx_utils/image_info.h>
 #include "gfx_utils/color.h"
+#include "gfx_utils/trans_affine.h"
 #include "fill_base.h"
+#include "fill_interpolator.h"
 /**
  * @file span_pattern_rgba.h
  * @brief Defines Scan line of pattern
@@ -26,26 +29,26 @@
  */
 
 namespace OHOS {
+const float PATTERN_PIXEL_CENTER = 0.5f;
+/* Transformed sample coordinates are clamped so that 24.8 fixed point never overflows. */
+const float PATTERN_COORD_LIMIT = 4194304.0f;
+const int32_t PATTERN_TRANSFORM_SIZE = 6;
+
 class FillPatternRgba : public SpanBase {
 #if GRAPHIC_ENABLE_PATTERN_FILL_FLAG
 public:
     FillPatternRgba() {}
 
     FillPatternRgba(const ImageInfo* image, PatternRepeatMode patternRepeat, float startX, float startY)
-        : patternRepeat_(patternRepeat)
     {
-        if (image->header.colorMode == ARGB8888) {
-            patternImage_ = reinterpret_cast<Color32*>(const_cast<uint8_t*>(image->data));
-            patternImageheigth_ = image->header.height;
-            patternImagewidth_ = image->header.width;
-            patternStartX_ = startX;
-            patternStartY_ = startY;
-        }
+        Attach(image, patternRepeat, startX, startY);
     }
 
     void Attach(const ImageInfo* image, PatternRepeatMode patternRepeat, float startX, float startY)
     {
         patternRepeat_ = patternRepeat;
+        repeatX_ = (patternRepeat == REPEAT || patternRepeat == REPEAT_X);
+        repeatY_ = (patternRepeat == REPEAT || patternRepeat == REPEAT_Y);
         if (image->header.colorMode == ARGB8888) {
             patternImage_ = reinterpret_cast<Color32*>(const_cast<uint8_t*>(image->data));
             patternImageheigth_ = image->header.height;
@@ -55,6 +58,30 @@ public:
         }
     }
 
+    /**
+     * @brief Scales or rotates the pattern around its start point.
+     * A singular transform has no inverse, the pattern is then drawn untransformed.
+     * @param transform Maps pattern coordinates to canvas coordinates before the start offset is added
+     * @param filter Sampler used while the transform is not identity
+     */
+    void SetTransform(const TransAffine& transform, PatternFilterMode filter = PATTERN_FILTER_NEAREST)
+    {
+        filter_ = filter;
+        const float* data = transform.GetData();
+        float determinant = data[0] * data[4] - data[3] * data[1]; // 4, 3: the linear part is data 0, 1, 3, 4
+        inverse_ = transform;
+        inverse_.Invert();
+        bool invertible = (determinant != 0);
+        const float* inverse = inverse_.GetData();
+        for (int32_t i = 0; invertible && i < PATTERN_TRANSFORM_SIZE; i++) {
+            invertible = std::isfinite(inverse[i]);
+        }
+        if (!invertible) {
+            inverse_ = TransAffine();
+        }
+        transformed_ = invertible && !transform.IsIdentity();
+    }
+
     /**
      * @brief black
      * @return black
@@ -74,75 +101,176 @@ public:
      */
     void Prepare() {}
 
+    /**
+     * @brief The row is resolved once per span, then the span is split at the tile edges into
+     * runs which are copied without per pixel repeat tests.
+     */
     void Generate(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
     {
+        if (patternImage_ == nullptr || patternImagewidth_ == 0 || patternImageheigth_ == 0) {
+            FillRun(span, len);
+            return;
+        }
+        if (transformed_) {
+            GenerateTransformed(span, x, y, len);
+            return;
+        }
         y = y - patternStartY_;
         x = x - patternStartX_;
-        for (; len; --len, span++, x++) {
-            if (patternRepeat_ == NO_REPEAT) {
-                if (x >= patternImagewidth_ ||
-                        y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                }
-            }
-
-            if (patternRepeat_ == REPEAT) {
-                x = x % patternImagewidth_;
-                y = y % patternImageheigth_;
-                if (x >= patternImagewidth_ || y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                }
-            }
-
-            if (patternRepeat_ == REPEAT_X) {
-                x = x % patternImagewidth_;
-                if (y >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    y = y % patternImageheigth_;
-                    if (x >= patternImagewidth_ || y >= patternImageheigth_) {
-                        ChangeColor(span, NoColor());
-                    } else {
-                        ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                    }
-                }
-            }
-
-            if (patternRepeat_ == REPEAT_Y) {
-                y = y % patternImageheigth_;
-                if (x >= patternImageheigth_) {
-                    ChangeColor(span, NoColor());
-                } else {
-                    x = x % patternImagewidth_;
-                    if (x >= patternImagewidth_ ||
-                       y >= patternImageheigth_) {
-                        ChangeColor(span, NoColor());
-                    } else {
-                        ChangeColor(span, patternImage_[patternImagewidth_ * y + x]);
-                    }
-                }
+        int32_t row = WrapIndex(y, patternImageheigth_, repeatY_);
+        if (row < 0) {
+            FillRun(span, len);
+            return;
+        }
+        const Color32* rowImage = patternImage_ + patternImagewidth_ * row;
+        int32_t width = patternImagewidth_;
+        if (repeatX_) {
+            x = WrapIndex(x, width, true);
+            while (len > 0) {
+                uint32_t run = MATH_MIN(len, static_cast<uint32_t>(width - x));
+                CopyRun(span, rowImage + x, run);
+                span += run;
+                len -= run;
+                x = 0;
             }
+            return;
+        }
+        if (x < 0) {
+            uint32_t run = MATH_MIN(len, static_cast<uint32_t>(-static_cast<int64_t>(x)));
+            FillRun(span, run);
+            span += run;
+            len -= run;
+            x = 0;
+        }
+        if (len > 0 && x < width) {
+            uint32_t run = MATH_MIN(len, static_cast<uint32_t>(width - x));
+            CopyRun(span, rowImage + x, run);
+            span += run;
+            len -= run;
         }
+        FillRun(span, len);
     }
 private:
-    PatternRepeatMode patternRepeat_;
-    const Color32* patternImage_;
-    uint16_t patternImageheigth_;
-    uint16_t patternImagewidth_;
-    float patternStartX_;
-    float patternStartY_;
+    PatternRepeatMode patternRepeat_ = REPEAT;
+    const Color32* patternImage_ = nullptr;
+    uint16_t patternImageheigth_ = 0;
+    uint16_t patternImagewidth_ = 0;
+    float patternStartX_ = 0;
+    float patternStartY_ = 0;
+    bool repeatX_ = true;
+    bool repeatY_ = true;
+    bool transformed_ = false;
+    PatternFilterMode filter_ = PATTERN_FILTER_NEAREST;
+    TransAffine inverse_;
 
-    void ChangeColor(Rgba8T* color, ColorType colorType)
+    static void ChangeColor(Rgba8T* color, ColorType colorType)
     {
         color->red = colorType.red;
         color->green = colorType.green;
         color->blue = colorType.blue;
         color->alpha = colorType.alpha;
     }
+
+    /**
+     * @brief Maps a texel index into the image, -1 when it lies outside a non repeating axis.
+     */
+    static int32_t WrapIndex(int32_t index, int32_t size, bool repeat)
+    {
+        if (repeat) {
+            index %= size;
+            return (index < 0) ? index + size : index;
+        }
+        return (index >= 0 && index < size) ? index : -1;
+    }
+
+    /**
+     * @brief The pattern is stored as BGRA and the span as RGBA, so runs are swizzled in a branch free loop.
+     */
+    static void CopyRun(Rgba8T* span, const Color32* src, uint32_t len)
+    {
+        for (uint32_t i = 0; i < len; i++) {
+            span[i].red = src[i].red;
+            span[i].green = src[i].green;
+            span[i].blue = src[i].blue;
+            span[i].alpha = src[i].alpha;
+        }
+    }
+
+    void FillRun(Rgba8T* span, uint32_t len) const
+    {
+        ColorType noColor = NoColor();
+        Rgba8T color(noColor.red, noColor.green, noColor.blue, noColor.alpha);
+        for (uint32_t i = 0; i < len; i++) {
+            span[i] = color;
+        }
+    }
+
+    void Fetch(Rgba8T* color, int32_t u, int32_t v) const
+    {
+        int32_t col = WrapIndex(u, patternImagewidth_, repeatX_);
+        int32_t row = WrapIndex(v, patternImageheigth_, repeatY_);
+        if (col < 0 || row < 0) {
+            ChangeColor(color, NoColor());
+        } else {
+            ChangeColor(color, patternImage_[patternImagewidth_ * row + col]);
+        }
+    }
+
+    /**
+     * @brief Pixel centers are mapped back into the pattern with the inverse transform, the coordinates
+     * advance linearly along the span and are sampled in 24.8 fixed point.
+     */
+    void GenerateTransformed(Rgba8T* span, int32_t x, int32_t y, uint32_t len)
+    {
+        const float subpixelScale = 1 << SUB_PIXEL_SHIFT;
+        const int32_t halfTexel = 1 << (SUB_PIXEL_SHIFT - 1);
+        const int32_t subpixelMask = (1 << SUB_PIXEL_SHIFT) - 1;
+        float u0 = x + PATTERN_PIXEL_CENTER - patternStartX_;
+        float v0 = y + PATTERN_PIXEL_CENTER - patternStartY_;
+        inverse_.Transform(&u0, &v0);
+        const float* data = inverse_.GetData();
+        float du = data[0];
+        float dv = data[3];
+        for (uint32_t i = 0; i < len; i++, span++) {
+            float u = MATH_MAX(-PATTERN_COORD_LIMIT, MATH_MIN(PATTERN_COORD_LIMIT, u0 + du * i));
+            float v = MATH_MAX(-PATTERN_COORD_LIMIT, MATH_MIN(PATTERN_COORD_LIMIT, v0 + dv * i));
+            int32_t fu = static_cast<int32_t>(std::floor(u * subpixelScale));
+            int32_t fv = static_cast<int32_t>(std::floor(v * subpixelScale));
+            if (filter_ == PATTERN_FILTER_NEAREST) {
+                Fetch(span, fu >> SUB_PIXEL_SHIFT, fv >> SUB_PIXEL_SHIFT);
+                continue;
+            }
+            fu -= halfTexel;
+            fv -= halfTexel;
+            int32_t u1 = fu >> SUB_PIXEL_SHIFT;
+            int32_t v1 = fv >> SUB_PIXEL_SHIFT;
+            uint32_t fx = fu & subpixelMask;
+            uint32_t fy = fv & subpixelMask;
+            Rgba8T texels[4]; // 4: the four neighbours of the sample point
+            Fetch(&texels[0], u1, v1);
+            Fetch(&texels[1], u1 + 1, v1);
+            Fetch(&texels[2], u1, v1 + 1);    // 2: bottom left
+            Fetch(&texels[3], u1 + 1, v1 + 1); // 3: bottom right
+            const uint32_t one = 1 << SUB_PIXEL_SHIFT;
+            uint32_t weights[4] = {(one - fx) * (one - fy), fx * (one - fy), (one - fx) * fy, fx * fy};
+            uint32_t red = 0;
+            uint32_t green = 0;
+            uint32_t blue = 0;
+            uint32_t alpha = 0;
+            for (int32_t k = 0; k < 4; k++) { // 4: the four neighbours of the sample point
+                red += texels[k].red * weights[k];
+                green += texels[k].green * weights[k];
+                blue += texels[k].blue * weights[k];
+                alpha += texels[k].alpha * weights[k];
+            }
+            const uint32_t shift = SUB_PIXEL_SHIFT * 2; // 2: both weights carry SUB_PIXEL_SHIFT bits
+            const uint32_t round = 1 << (shift - 1);
+            span->red = static_cast<uint8_t>((red + round) >> shift);
+            span->green = static_cast<uint8_t>((green + round) >> shift);
+            span->blue = static_cast<uint8_t>((blue + round) >> shift);
+            span->alpha = static_cast<uint8_t>((alpha + round) >> shift);
+        }
+    }
 #endif
 };
 } // namespace OHOS
@@ -112,6 +112,7 @@ public:
 
     void Rewind(uint32_t pathId);
     uint32_t GenerateVertex(float* x, float* y);
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
     VertexGenerateFlags GetGenerateFlags()
     {
         return GENERATE_STROKE;
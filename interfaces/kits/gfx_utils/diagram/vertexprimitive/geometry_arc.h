@@ -18,6 +18,7 @@
 
 #include "gfx_utils/diagram/common/common_basics.h"
 #include "gfx_utils/heap_base.h"
+#include "gfx_utils/trans_affine.h"
 namespace OHOS {
 /**
  * @file graphic_geometry_arc.h
@@ -63,6 +64,17 @@ public:
      */
     void SetApproximationScale(float scale);
 
+    /**
+     * @brief Adjusts the approximation level to the transform the arc is drawn with.
+     * @param transform Transform from logical to viewport coordinates, see TransAffine::GetApproximationScale.
+     * @since 1.0
+     * @version 1.0
+     */
+    void SetApproximationScale(const TransAffine& transform)
+    {
+        SetApproximationScale(transform.GetApproximationScale());
+    }
+
     /**
      * @brief Get Approximation Level.
      * @param scale Is the ratio between viewport coordinates and logical coordinates.
@@ -83,6 +95,7 @@ public:
      * @version 1.0
      */
     uint32_t GenerateVertex(float* y, float* x);
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
     /**
      * @brief Initialize an arc.
      *
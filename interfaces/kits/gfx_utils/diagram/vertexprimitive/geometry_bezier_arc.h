@@ -114,6 +114,11 @@ public:
         }
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        return GenerateVerticesByVertex(*this, vertices, maxNum);
+    }
+
     /**
      * @brief Get the number of vertex sources.
      * @return Number of vertices.
@@ -226,6 +231,11 @@ public:
         return bezierArcModel_.GenerateVertex(x, y);
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        return bezierArcModel_.GenerateVertices(vertices, maxNum);
+    }
+
     /**
      * @brief Returns the vertex data of a Bezier arc.
      * @return Return vertex source.
@@ -80,6 +80,7 @@ public:
 
     void Rewind(uint32_t pathId);
     uint32_t GenerateVertex(float* x, float* y);
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
 
 private:
     int32_t numberSteps_;
@@ -163,6 +164,11 @@ public:
         return (count_ == 1) ? PATH_CMD_MOVE_TO : PATH_CMD_LINE_TO;
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        return GenerateVerticesByVertex(*this, vertices, maxNum);
+    }
+
 private:
     void Bezier(float x1, float y1,
                 float x2, float y2,
@@ -282,6 +288,7 @@ public:
 
     void Rewind(uint32_t pathId);
     uint32_t GenerateVertex(float* x, float* y);
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
 
 private:
     int32_t numberSteps_;
@@ -478,6 +485,11 @@ public:
         return (count_ == 1) ? PATH_CMD_MOVE_TO : PATH_CMD_LINE_TO;
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        return GenerateVerticesByVertex(*this, vertices, maxNum);
+    }
+
 private:
     void Bezier(float x1, float y1,
                 float x2, float y2,
@@ -591,6 +603,14 @@ public:
         return curveDiv_.GenerateVertex(x, y);
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        if (approximationMethod_ == CURVEINCREMENT) {
+            return curveInc_.GenerateVertices(vertices, maxNum);
+        }
+        return curveDiv_.GenerateVertices(vertices, maxNum);
+    }
+
 private:
     QuadBezierCurveIncr curveInc_;
     QuadrBezierCurveDividOp curveDiv_;
@@ -708,6 +728,14 @@ public:
         return curveDiv_.GenerateVertex(x, y);
     }
 
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum)
+    {
+        if (approximationMethod_ == CURVEINCREMENT) {
+            return curveInc_.GenerateVertices(vertices, maxNum);
+        }
+        return curveDiv_.GenerateVertices(vertices, maxNum);
+    }
+
 private:
     CubicBezierCurveIncrement curveInc_;
     CubicBezierCurveDividOperate curveDiv_;
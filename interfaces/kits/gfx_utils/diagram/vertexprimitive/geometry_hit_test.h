@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file geometry_hit_test.h
+ * @brief Defines the point in path test on flattened vertices
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_GEOMETRY_HIT_TEST_H
+#define GRAPHIC_LITE_GEOMETRY_HIT_TEST_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_plaindata_array.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief Tests whether points lie inside a path without rasterizing it.
+ * The path is taken from a flattened vertex source, e.g. UICanvasVertices through DepictCurve and
+ * DepictTransform, every subpath is closed like the rasterizer does. A point outside of the bounding box
+ * is rejected at once, otherwise the winding number of the edges around it decides with the filling rule.
+ * BuildIndex sorts the edges into horizontal buckets so that a test only visits the edges of one bucket,
+ * repeated touches on the same shape then cost a handful of edges.
+ * A point exactly on a left or top edge is inside, on a right or bottom edge outside.
+ * @since 1.0
+ * @version 1.0
+ */
+class GeometryHitTest : public HeapBase {
+public:
+    GeometryHitTest()
+        : edges_(nullptr), edgeNum_(0), edgeCapacity_(0), fillingRule_(FILL_NON_ZERO),
+          startX_(0), startY_(0), lastX_(0), lastY_(0), hasStart_(false),
+          minX_(0), minY_(0), maxX_(0), maxY_(0), bucketNum_(0), bucketScale_(0) {}
+
+    ~GeometryHitTest();
+
+    /**
+     * @brief Removes the edges and the index, the filling rule is kept.
+     */
+    void Reset();
+
+    void SetFillingRule(FillingRule rule)
+    {
+        fillingRule_ = rule;
+    }
+
+    FillingRule GetFillingRule() const
+    {
+        return fillingRule_;
+    }
+
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void ClosePolygon();
+    void AddVertex(float x, float y, uint32_t cmd);
+
+    /**
+     * @brief Adds the flattened vertices of a vertex source, the index is dropped.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class VertexSource>
+    void AddPath(VertexSource& vs, uint32_t pathId = 0)
+    {
+        PathVertex vertices[VERTEX_BATCH_SIZE];
+        uint32_t num;
+        vs.Rewind(pathId);
+        do {
+            num = GenerateSourceVertices(vs, vertices, VERTEX_BATCH_SIZE);
+            for (uint32_t i = 0; i < num; i++) {
+                AddVertex(vertices[i].x, vertices[i].y, vertices[i].cmd);
+            }
+        } while (num == VERTEX_BATCH_SIZE);
+        ClosePolygon();
+    }
+
+    /**
+     * @brief Sorts the edges into horizontal buckets, the index is kept until the path changes.
+     * @param bucketNum Number of buckets, 0 picks one bucket per two edges up to HIT_TEST_MAX_BUCKETS
+     * @since 1.0
+     * @version 1.0
+     */
+    void BuildIndex(uint32_t bucketNum = 0);
+
+    bool HasIndex() const
+    {
+        return bucketNum_ > 0;
+    }
+
+    /**
+     * @brief Winding number of the path around (x, y), 0 outside of the bounding box.
+     */
+    int32_t GetWinding(float x, float y) const;
+
+    /**
+     * @brief Whether (x, y) is inside the path with the filling rule.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool HitTest(float x, float y) const
+    {
+        return IsInside(GetWinding(x, y), fillingRule_);
+    }
+
+    /**
+     * @brief Tests one point against a vertex source in a single pass, without storing the edges.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class VertexSource>
+    static bool HitTestPath(VertexSource& vs, float x, float y, FillingRule rule, uint32_t pathId = 0)
+    {
+        float vx;
+        float vy;
+        float startX = 0;
+        float startY = 0;
+        float lastX = 0;
+        float lastY = 0;
+        bool hasStart = false;
+        int32_t winding = 0;
+        uint32_t cmd;
+        vs.Rewind(pathId);
+        while (!IsStop(cmd = vs.GenerateVertex(&vx, &vy))) {
+            if (IsMoveTo(cmd) || IsEndPoly(cmd)) {
+                if (hasStart) {
+                    winding += GetEdgeWinding(lastX, lastY, startX, startY, x, y);
+                }
+                hasStart = IsMoveTo(cmd);
+                startX = lastX = vx;
+                startY = lastY = vy;
+            } else if (IsVertex(cmd) && hasStart) {
+                winding += GetEdgeWinding(lastX, lastY, vx, vy, x, y);
+                lastX = vx;
+                lastY = vy;
+            }
+        }
+        if (hasStart) {
+            winding += GetEdgeWinding(lastX, lastY, startX, startY, x, y);
+        }
+        return IsInside(winding, rule);
+    }
+
+    float GetMinX() const
+    {
+        return minX_;
+    }
+    float GetMinY() const
+    {
+        return minY_;
+    }
+    float GetMaxX() const
+    {
+        return maxX_;
+    }
+    float GetMaxY() const
+    {
+        return maxY_;
+    }
+
+    uint32_t GetEdgeNum() const
+    {
+        return edgeNum_;
+    }
+
+    static bool IsInside(int32_t winding, FillingRule rule)
+    {
+        return (rule == FILL_EVEN_ODD) ? ((winding & 1) != 0) : (winding != 0);
+    }
+
+    /**
+     * @brief Contribution of the edge (x1, y1)-(x2, y2) to the winding number around (x, y):
+     * +1 for an upward edge right of the point, -1 for a downward one, 0 otherwise.
+     * An edge covers y1 <= y < y2 (or y2 <= y < y1), so a vertex on the ray counts once.
+     * @since 1.0
+     * @version 1.0
+     */
+    static int32_t GetEdgeWinding(float x1, float y1, float x2, float y2, float x, float y)
+    {
+        if (y1 <= y) {
+            if (y2 > y && (x2 - x1) * (y - y1) - (x - x1) * (y2 - y1) > 0) {
+                return 1;
+            }
+        } else if (y2 <= y && (x2 - x1) * (y - y1) - (x - x1) * (y2 - y1) < 0) {
+            return -1;
+        }
+        return 0;
+    }
+
+private:
+    static constexpr uint32_t HIT_TEST_MAX_BUCKETS = 1024;
+
+    struct HitEdge {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+    };
+
+    GeometryHitTest(const GeometryHitTest&);
+    GeometryHitTest& operator=(const GeometryHitTest&);
+
+    void AddEdge(float x1, float y1, float x2, float y2);
+    void DropIndex();
+    uint32_t GetBucket(float y) const;
+
+    HitEdge* edges_;
+    uint32_t edgeNum_;
+    uint32_t edgeCapacity_;
+    FillingRule fillingRule_;
+    float startX_;
+    float startY_;
+    float lastX_;
+    float lastY_;
+    bool hasStart_;
+    float minX_;
+    float minY_;
+    float maxX_;
+    float maxY_;
+    uint32_t bucketNum_;
+    float bucketScale_;
+    GeometryPlainDataArray<uint32_t> bucketStart_;
+    GeometryPlainDataArray<uint32_t> bucketEdges_;
+};
+} // namespace OHOS
+#endif
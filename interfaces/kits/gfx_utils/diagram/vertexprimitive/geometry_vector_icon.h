@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file geometry_vector_icon.h
+ * @brief Defines the precompiled binary format of flattened icon paths
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef GRAPHIC_LITE_GEOMETRY_VECTOR_ICON_H
+#define GRAPHIC_LITE_GEOMETRY_VECTOR_ICON_H
+
+#include "gfx_utils/diagram/common/common_basics.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+#include "gfx_utils/heap_base.h"
+
+namespace OHOS {
+/**
+ * @brief "VICN" in the byte order of the writer, a reader with another byte order rejects the data.
+ */
+const uint32_t VECTOR_ICON_MAGIC = 0x4E434956;
+const uint16_t VECTOR_ICON_VERSION = 1;
+
+/**
+ * @brief Storage of the coordinates in a vector icon.
+ */
+enum VectorIconCoordFormat : uint16_t {
+    /** Two floats per vertex, exact */
+    VECTOR_ICON_COORD_FLOAT = 0,
+    /** Two uint16_t per vertex on a grid spanning the bounds, half the size */
+    VECTOR_ICON_COORD_UINT16 = 1
+};
+
+/**
+ * @brief Header of a vector icon, followed by vertexNum coordinate pairs and vertexNum command bytes.
+ * The bounds cover the vertices of vertex commands, an icon without one has empty bounds at 0.
+ * Quantized coordinates decode to minX + qx * stepX and minY + qy * stepY, the coordinates of END_POLY
+ * commands decode to (minX, minY).
+ * @since 1.0
+ * @version 1.0
+ */
+struct VectorIconHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t coordFormat;
+    uint32_t vertexNum;
+    float stepX;
+    float stepY;
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+/**
+ * @brief Zero-copy vertex source over an encoded vector icon, for example a mapped VectorIconFile.
+ * The data is not copied and must outlive the source. It has to be 4 bytes aligned, which a mapping
+ * or a UIMalloc buffer always is.
+ * The vertices are flattened already, so the source goes straight into RasterizerScanlineAntialias::AddPath,
+ * through DepictTransform if it has to be placed.
+ * @since 1.0
+ * @version 1.0
+ */
+class VectorIconSource {
+public:
+    VectorIconSource() : header_(nullptr), coords_(nullptr), cmds_(nullptr), iterator_(0) {}
+
+    VectorIconSource(const uint8_t* data, uint32_t size)
+        : header_(nullptr), coords_(nullptr), cmds_(nullptr), iterator_(0)
+    {
+        Attach(data, size);
+    }
+
+    /**
+     * @brief Validates the header and the size of the data and attaches to it.
+     * @return Returns false and detaches for data which is not a complete vector icon.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Attach(const uint8_t* data, uint32_t size);
+
+    void Detach()
+    {
+        header_ = nullptr;
+        coords_ = nullptr;
+        cmds_ = nullptr;
+        iterator_ = 0;
+    }
+
+    bool IsValid() const
+    {
+        return header_ != nullptr;
+    }
+
+    uint32_t GetTotalVertices() const
+    {
+        return (header_ != nullptr) ? header_->vertexNum : 0;
+    }
+
+    /**
+     * @brief Returns the precomputed bounds, false for an empty or detached source.
+     */
+    bool GetBounds(float& minX, float& minY, float& maxX, float& maxY) const;
+
+    void Rewind(uint32_t pathId)
+    {
+        iterator_ = pathId;
+    }
+
+    uint32_t GenerateVertex(float* x, float* y)
+    {
+        if (iterator_ >= GetTotalVertices()) {
+            return PATH_CMD_STOP;
+        }
+        DecodeVertex(iterator_, x, y);
+        return cmds_[iterator_++];
+    }
+
+    uint32_t GenerateVertices(PathVertex* vertices, uint32_t maxNum);
+
+    /**
+     * @brief Size in bytes of an icon of vertexNum vertices.
+     */
+    static uint32_t GetEncodedSize(uint32_t vertexNum, VectorIconCoordFormat format)
+    {
+        uint32_t coordBytes = (format == VECTOR_ICON_COORD_UINT16) ? sizeof(uint16_t) : sizeof(float);
+        return sizeof(VectorIconHeader) + vertexNum * (coordBytes * 2 + 1); // 2: x and y, 1: command byte
+    }
+
+private:
+    void DecodeVertex(uint32_t idx, float* x, float* y) const;
+
+    const VectorIconHeader* header_;
+    const uint8_t* coords_;
+    const uint8_t* cmds_;
+    uint32_t iterator_;
+};
+
+/**
+ * @brief Read only view of a vector icon file, mapped with mmap where the platform has it and read into
+ * a UIMalloc buffer otherwise. Several VectorIconSource can share one file.
+ * @since 1.0
+ * @version 1.0
+ */
+class VectorIconFile : public HeapBase {
+public:
+    VectorIconFile() : data_(nullptr), size_(0), mapped_(false) {}
+
+    ~VectorIconFile()
+    {
+        Close();
+    }
+
+    /**
+     * @brief Maps the file, a mapping held before is closed first.
+     * @return Returns false if the file can not be opened or mapped.
+     * @since 1.0
+     * @version 1.0
+     */
+    bool Open(const char* fileName);
+
+    void Close();
+
+    const uint8_t* GetData() const
+    {
+        return data_;
+    }
+
+    uint32_t GetSize() const
+    {
+        return size_;
+    }
+
+private:
+    VectorIconFile(const VectorIconFile&);
+    VectorIconFile& operator=(const VectorIconFile&);
+
+    uint8_t* data_;
+    uint32_t size_;
+    bool mapped_;
+};
+
+/**
+ * @brief Converts paths into vector icons, normally ahead of time when the icons are packaged.
+ * The vertex source is read twice, once for the bounds and once for the data, and has to produce
+ * flattened vertices already, e.g. DepictCurve over a UICanvasVertices.
+ * @since 1.0
+ * @version 1.0
+ */
+class VectorIconWriter {
+public:
+    /**
+     * @brief Encodes the vertices of vs into buffer.
+     * @param buffer Receives the icon, nullptr only asks for the size
+     * @return Returns the size of the icon, 0 if buffer is too small.
+     * @since 1.0
+     * @version 1.0
+     */
+    template <class VertexSource>
+    static uint32_t Encode(VertexSource& vs, VectorIconCoordFormat format, uint8_t* buffer, uint32_t size,
+                           uint32_t pathId = 0)
+    {
+        PathVertex vertices[VERTEX_BATCH_SIZE];
+        VectorIconHeader header;
+        BeginHeader(header, format);
+        bool hasBounds = false;
+        uint32_t num;
+        vs.Rewind(pathId);
+        do {
+            num = GenerateSourceVertices(vs, vertices, VERTEX_BATCH_SIZE);
+            AddBounds(header, vertices, num, hasBounds);
+        } while (num == VERTEX_BATCH_SIZE);
+        EndHeader(header);
+        uint32_t encodedSize = VectorIconSource::GetEncodedSize(header.vertexNum, format);
+        if (buffer == nullptr) {
+            return encodedSize;
+        }
+        if (size < encodedSize || !WriteHeader(header, buffer)) {
+            return 0;
+        }
+        uint32_t idx = 0;
+        vs.Rewind(pathId);
+        do {
+            num = GenerateSourceVertices(vs, vertices, MATH_MIN(VERTEX_BATCH_SIZE, header.vertexNum - idx));
+            WriteVertices(header, vertices, num, idx, buffer);
+            idx += num;
+        } while (num > 0 && idx < header.vertexNum);
+        return encodedSize;
+    }
+
+    /**
+     * @brief Flattens the curves of path with DepictCurve and writes the icon to a file.
+     * @param approximationScale Scale the icon is designed for, see DepictCurve::ApproximationScale
+     * @since 1.0
+     * @version 1.0
+     */
+    static bool WriteFile(UICanvasVertices& path, const char* fileName,
+                          VectorIconCoordFormat format = VECTOR_ICON_COORD_FLOAT, float approximationScale = 1.0f);
+
+private:
+    static void BeginHeader(VectorIconHeader& header, VectorIconCoordFormat format);
+    static void AddBounds(VectorIconHeader& header, const PathVertex* vertices, uint32_t num, bool& hasBounds);
+    static void EndHeader(VectorIconHeader& header);
+    static bool WriteHeader(const VectorIconHeader& header, uint8_t* buffer);
+    static void WriteVertices(const VectorIconHeader& header, const PathVertex* vertices, uint32_t num,
+                              uint32_t idx, uint8_t* buffer);
+};
+} // namespace OHOS
+#endif
@@ -22,6 +22,27 @@
 namespace OHOS {
 const float affineEpsilon = 1e-14;
 const uint16_t parlIndexSize = 6;
+/**
+ * @brief Range of GetApproximationScale, a degenerate or extreme transform still flattens to a sane vertex count.
+ */
+const float MIN_APPROXIMATION_SCALE = 1.0f / 64; // 64: six octaves down
+const float MAX_APPROXIMATION_SCALE = 64.0f;     // 64.0f: six octaves up
+/**
+ * @brief Kind of a transform, each kind also covers the ones before it.
+ * The kind tells which terms of the matrix are exactly 0 or 1 so that they can be skipped.
+ * @since 1.0
+ * @version 1.0
+ */
+enum TransAffineType : uint8_t {
+    /* Scale 1, no shear, no translation. */
+    TRANS_AFFINE_IDENTITY,
+    /* Scale 1, no shear. */
+    TRANS_AFFINE_TRANSLATE,
+    /* No shear, scale and translation. */
+    TRANS_AFFINE_SCALE,
+    TRANS_AFFINE_GENERAL
+};
+
 /**
  * @brief Map source transformation
  * @since 1.0
@@ -34,26 +55,51 @@ public:
      * @since 1.0
      * @version 1.0
      */
-    TransAffine() : Matrix3<float>() {}
+    TransAffine() : Matrix3<float>(), type_(TRANS_AFFINE_IDENTITY) {}
     /**
      * @brief Custom matrix
      * @since 1.0
      * @version 1.0
      */
     TransAffine(float v0, float v1, float v2, float v3, float v4, float v5)
-        : Matrix3<float>(v0, v2, v4, v1, v3, v5, 0, 0, 1) {}
+        : Matrix3<float>(v0, v2, v4, v1, v3, v5, 0, 0, 1)
+    {
+        UpdateType();
+    }
     /**
      * @brief Converts a rectangle to a parallelogram
      * @since 1.0
      * @version 1.0
      */
-    TransAffine(float x1, float y1, float x2, float y2, const float* parl)
+    TransAffine(float x1, float y1, float x2, float y2, const float* parl) : type_(TRANS_AFFINE_GENERAL)
     {
         RectToParl(x1, y1, x2, y2, parl);
     }
     void SetData(int32_t index, float value)
     {
         data_[index] = value;
+        UpdateType();
+    }
+
+    /**
+     * @brief Writable column access, the transform is taken as general from then on.
+     * @since 1.0
+     * @version 1.0
+     */
+    float* operator[](uint8_t col)
+    {
+        type_ = TRANS_AFFINE_GENERAL;
+        return Matrix3<float>::operator[](col);
+    }
+
+    /**
+     * @brief Returns the kind of the transform, kept up to date by every change of the matrix.
+     * @since 1.0
+     * @version 1.0
+     */
+    TransAffineType GetType() const
+    {
+        return type_;
     }
     /**
      * @brief Convert the original parallelogram to the target parallelogram
@@ -153,6 +199,26 @@ public:
      */
     void InverseTransform(float* x, float* y) const;
 
+    /**
+     * @brief Transforms num points in place, the same as Transform on each of them.
+     * Identity returns at once, translations and scales skip the zero terms and the general
+     * transform runs four points at a time with NEON or SSE2 when available.
+     * @param x x-coordinates
+     * @param y y-coordinates
+     * @since 1.0
+     * @version 1.0
+     */
+    void TransformBatch(float* x, float* y, uint32_t num) const;
+
+    /**
+     * @brief Inverse transforms num points in place, the same as InverseTransform on each of them.
+     * @param x x-coordinates
+     * @param y y-coordinates
+     * @since 1.0
+     * @version 1.0
+     */
+    void InverseTransformBatch(float* x, float* y, uint32_t num) const;
+
     /**
      * @brief Computes the reciprocal of a determinant
      * @since 1.0
@@ -190,6 +256,24 @@ public:
      */
     void ScalingAbs(float* x, float* y) const;
 
+    /**
+     * @brief Approximation scale for flattening curves drawn with this transform.
+     * The larger of the two axis scales is taken so that the most stretched direction is not faceted,
+     * clamped to MIN_APPROXIMATION_SCALE and MAX_APPROXIMATION_SCALE.
+     * @since 1.0
+     * @version 1.0
+     */
+    float GetApproximationScale() const
+    {
+        if (type_ == TRANS_AFFINE_IDENTITY || type_ == TRANS_AFFINE_TRANSLATE) {
+            return 1.0f;
+        }
+        float scaleX;
+        float scaleY;
+        ScalingAbs(&scaleX, &scaleY);
+        return MATH_MIN(MATH_MAX(MATH_MAX(scaleX, scaleY), MIN_APPROXIMATION_SCALE), MAX_APPROXIMATION_SCALE);
+    }
+
     /**
      * @brief Set rotation matrix
      * @since 1.0
@@ -228,6 +312,12 @@ public:
     {
         return TransAffine(1.0f, 0.0f, 0.0f, 1.0f, x, y);
     }
+
+private:
+    /* Classifies the matrix, a term counts as 0 or 1 only when it is exactly that value. */
+    void UpdateType();
+
+    TransAffineType type_;
 };
 
 inline void TransAffine::Transform(float* x, float* y) const
@@ -250,6 +340,9 @@ inline const TransAffine& TransAffine::Translate(float deltaX, float deltaY)
 {
     data_[2] += deltaX;
     data_[5] += deltaY;
+    if (type_ == TRANS_AFFINE_IDENTITY) {
+        type_ = TRANS_AFFINE_TRANSLATE;
+    }
     return *this;
 }
 
@@ -264,6 +357,7 @@ inline const TransAffine& TransAffine::Rotate(float angle)
     data_[0] = scaleXTemp;
     data_[1] = shearXTemp;
     data_[2] = translateXTemp;
+    UpdateType();
     return *this;
 }
 
@@ -275,6 +369,9 @@ inline const TransAffine& TransAffine::Scale(float scaleX, float scaleY)
     data_[3] *= scaleY;
     data_[4] *= scaleY;
     data_[5] *= scaleY;
+    if (type_ != TRANS_AFFINE_GENERAL) {
+        type_ = TRANS_AFFINE_SCALE;
+    }
     return *this;
 }
 
@@ -286,6 +383,9 @@ inline const TransAffine& TransAffine::Scale(float scale)
     data_[3] *= scale;
     data_[4] *= scale;
     data_[5] *= scale;
+    if (type_ != TRANS_AFFINE_GENERAL) {
+        type_ = TRANS_AFFINE_SCALE;
+    }
     return *this;
 }
 
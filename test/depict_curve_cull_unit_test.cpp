@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const float CLIP_X1 = 100.0f;
+const float CLIP_Y1 = 100.0f;
+const float CLIP_X2 = 300.0f;
+const float CLIP_Y2 = 250.0f;
+const int32_t SHAPE_NUM = 400;
+
+/* A round shape of four cubics, centered at (x, y). */
+void AddShape(UICanvasVertices& path, float x, float y)
+{
+    path.MoveTo(x, y - 20.0f);
+    path.CubicBezierCurve(x + 11.0f, y - 20.0f, x + 20.0f, y - 11.0f, x + 20.0f, y);
+    path.CubicBezierCurve(x + 20.0f, y + 11.0f, x + 11.0f, y + 20.0f, x, y + 20.0f);
+    path.CubicBezierCurve(x - 11.0f, y + 20.0f, x - 20.0f, y + 11.0f, x - 20.0f, y);
+    path.CubicBezierCurve(x - 20.0f, y - 11.0f, x - 11.0f, y - 20.0f, x, y - 20.0f);
+    path.EndPoly(PATH_FLAGS_CLOSE);
+}
+
+/* A grid of shapes around the clip box, most of them outside, and a large shape crossing it. */
+void BuildScene(UICanvasVertices& path, int32_t shapeNum)
+{
+    for (int32_t i = 0; i < shapeNum; i++) {
+        AddShape(path, static_cast<float>(i % 20) * 37.0f - 50.0f,  // 20, 37.0f, 50.0f: grid
+                 static_cast<float>(i / 20) * 29.0f - 80.0f);       // 20, 29.0f, 80.0f: grid
+    }
+    path.MoveTo(50.0f, 50.0f);
+    path.CubicBezierCurve(400.0f, -100.0f, 500.0f, 300.0f, 350.0f, 400.0f);
+    path.CubicBezierCurve(200.0f, 500.0f, 0.0f, 320.0f, 40.0f, 200.0f);
+    path.EndPoly(PATH_FLAGS_CLOSE);
+}
+
+struct CoverCell {
+    int32_t x;
+    int32_t y;
+    uint32_t cover;
+};
+
+void CollectCovers(RasterizerScanlineAntialias& ras, std::vector<CoverCell>& cells)
+{
+    cells.clear();
+    if (!ras.RewindScanlines()) {
+        return;
+    }
+    GeometryScanline sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        GeometryScanline::ConstIterator span = sl.Begin();
+        for (uint32_t n = sl.NumSpans(); n > 0; --n, ++span) {
+            for (int32_t i = 0; i < span->spanLength; i++) {
+                cells.push_back({span->x + i, sl.GetYLevel(), span->covers[i]});
+            }
+        }
+    }
+}
+
+template <class VertexSource>
+void Rasterize(VertexSource& vs, std::vector<CoverCell>& cells)
+{
+    RasterizerScanlineAntialias ras;
+    ras.ClipBox(CLIP_X1, CLIP_Y1, CLIP_X2, CLIP_Y2);
+    ras.AddPath(vs);
+    CollectCovers(ras, cells);
+}
+
+void ExpectSameCovers(const std::vector<CoverCell>& expected, const std::vector<CoverCell>& actual)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (uint32_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(actual[i].x, expected[i].x) << "cell " << i;
+        EXPECT_EQ(actual[i].y, expected[i].y) << "cell " << i;
+        EXPECT_EQ(actual[i].cover, expected[i].cover) << "cell " << i;
+    }
+}
+} // namespace
+
+class DepictCurveCullTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: DepictCurveCullCounters_001
+ * @tc.desc: Curves beyond an edge of the box become lines, subpaths beyond an edge are skipped,
+ *           curves reaching into the box are flattened as before.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DepictCurveCullTest, DepictCurveCullCounters_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    AddShape(path, 0.0f, 0.0f);        // 0.0f: outside, skipped
+    path.MoveTo(150.0f, 150.0f);       // 150.0f: inside
+    path.LineTo(350.0f, 150.0f);       // 350.0f: right of the box
+    path.CubicBezierCurve(380.0f, 160.0f, 380.0f, 200.0f, 350.0f, 200.0f); // right of the box, culled
+    path.CubicBezierCurve(250.0f, 220.0f, 250.0f, 240.0f, 150.0f, 200.0f); // inside, flattened
+    path.EndPoly(PATH_FLAGS_CLOSE);
+    AddShape(path, 500.0f, 500.0f);    // 500.0f: outside, skipped
+
+    DepictCurve curve(path);
+    uint32_t fullNum = 0;
+    float x;
+    float y;
+    curve.Rewind(0);
+    while (!IsStop(curve.GenerateVertex(&x, &y))) {
+        fullNum++;
+    }
+    curve.SetCullBox(CLIP_X1, CLIP_Y1, CLIP_X2, CLIP_Y2);
+    uint32_t culledNum = 0;
+    uint32_t moveNum = 0;
+    uint32_t cmd;
+    curve.Rewind(0);
+    while (!IsStop(cmd = curve.GenerateVertex(&x, &y))) {
+        culledNum++;
+        moveNum += IsMoveTo(cmd) ? 1 : 0;
+    }
+    EXPECT_EQ(curve.GetCulledSubpathCount(), 2u);
+    EXPECT_EQ(curve.GetCulledCurveCount(), 1u);
+    EXPECT_EQ(moveNum, 1u);
+    EXPECT_LT(culledNum, fullNum);
+
+    curve.ResetCullCounters();
+    curve.ResetCullBox();
+    curve.Rewind(0);
+    uint32_t num = 0;
+    while (!IsStop(curve.GenerateVertex(&x, &y))) {
+        num++;
+    }
+    EXPECT_EQ(num, fullNum);
+    EXPECT_EQ(curve.GetCulledCurveCount(), 0u);
+    EXPECT_EQ(curve.GetCulledSubpathCount(), 0u);
+}
+
+/**
+ * @tc.name: DepictCurveCullCoverage_001
+ * @tc.desc: A fill clipped to the box covers the same pixels with and without culling, also
+ *           through a transform with the box given after the transform.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DepictCurveCullTest, DepictCurveCullCoverage_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildScene(path, SHAPE_NUM);
+    std::vector<CoverCell> expected;
+    std::vector<CoverCell> actual;
+
+    DepictCurve curve(path);
+    Rasterize(curve, expected);
+    curve.SetCullBox(CLIP_X1, CLIP_Y1, CLIP_X2, CLIP_Y2);
+    Rasterize(curve, actual);
+    EXPECT_GT(curve.GetCulledSubpathCount(), 0u);
+    EXPECT_GT(curve.GetCulledCurveCount(), 0u);
+    ExpectSameCovers(expected, actual);
+
+    TransAffine transform = TransAffine::TransAffineRotation(0.3f); // 0.3f: rotation in radians
+    transform.Scale(1.25f, 0.8f);        // 1.25f, 0.8f: scale
+    transform.Translate(60.0f, -20.0f);  // 60.0f, -20.0f: translation
+    curve.ResetCullBox();
+    curve.ResetCullCounters();
+    DepictTransform<DepictCurve> transformed(curve, transform);
+    Rasterize(transformed, expected);
+    curve.SetCullBox(CLIP_X1, CLIP_Y1, CLIP_X2, CLIP_Y2, transform);
+    Rasterize(transformed, actual);
+    EXPECT_GT(curve.GetCulledSubpathCount(), 0u);
+    ExpectSameCovers(expected, actual);
+}
+} // namespace OHOS
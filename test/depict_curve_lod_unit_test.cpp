@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/depiction/depict_curve_lod.h"
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t MAX_VERTICES = 16384;
+
+/* Round shapes made of cubic curves, the vertex count depends on the approximation scale only. */
+void BuildPath(UICanvasVertices& path, int32_t shapeNum)
+{
+    for (int32_t i = 0; i < shapeNum; i++) {
+        float x = static_cast<float>(i % 20) * 40.0f; // 20, 40.0f: a grid of shapes
+        float y = static_cast<float>(i / 20) * 40.0f; // 20, 40.0f: a grid of shapes
+        path.MoveTo(x + 20.0f, y);
+        path.CubicBezierCurve(x + 31.0f, y, x + 40.0f, y + 9.0f, x + 40.0f, y + 20.0f);
+        path.CubicBezierCurve(x + 40.0f, y + 31.0f, x + 31.0f, y + 40.0f, x + 20.0f, y + 40.0f);
+        path.CubicBezierCurve(x + 9.0f, y + 40.0f, x, y + 31.0f, x, y + 20.0f);
+        path.CubicBezierCurve(x, y + 9.0f, x + 9.0f, y, x + 20.0f, y);
+        path.EndPoly(PATH_FLAGS_CLOSE);
+    }
+}
+
+template <class VertexSource>
+uint32_t ReadVertices(VertexSource& vs, PathVertex* vertices)
+{
+    uint32_t num = 0;
+    float x;
+    float y;
+    uint32_t cmd;
+    vs.Rewind(0);
+    while (!IsStop(cmd = vs.GenerateVertex(&x, &y)) && num < MAX_VERTICES) {
+        vertices[num].x = x;
+        vertices[num].y = y;
+        vertices[num].cmd = cmd;
+        num++;
+    }
+    return num;
+}
+
+uint32_t CountVertices(DepictCurve& curve)
+{
+    static PathVertex vertices[MAX_VERTICES];
+    return ReadVertices(curve, vertices);
+}
+} // namespace
+
+class DepictCurveLodTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: DepictCurveLodAutoScale_001
+ * @tc.desc: The approximation scale follows the transform, so the vertex count of a curve follows
+ *           its size on the screen.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DepictCurveLodTest, DepictCurveLodAutoScale_001, TestSize.Level0)
+{
+    TransAffine transform;
+    EXPECT_FLOAT_EQ(transform.GetApproximationScale(), 1.0f);
+    transform.Translate(30.0f, 40.0f); // 30.0f, 40.0f: translation
+    EXPECT_FLOAT_EQ(transform.GetApproximationScale(), 1.0f);
+    transform.Scale(0.25f, 0.5f); // 0.25f, 0.5f: scale down
+    EXPECT_FLOAT_EQ(transform.GetApproximationScale(), 0.5f);
+    TransAffine rotate = TransAffine::TransAffineRotation(0.7f); // 0.7f: rotation in radians
+    rotate.Scale(3.0f);                                          // 3.0f: scale up
+    EXPECT_NEAR(rotate.GetApproximationScale(), 3.0f, 1e-5f);
+    TransAffine degenerate = TransAffine::TransAffineScaling(0.0f, 0.0f);
+    EXPECT_FLOAT_EQ(degenerate.GetApproximationScale(), MIN_APPROXIMATION_SCALE);
+    TransAffine huge = TransAffine::TransAffineScaling(1000.0f); // 1000.0f: beyond the range
+    EXPECT_FLOAT_EQ(huge.GetApproximationScale(), MAX_APPROXIMATION_SCALE);
+
+    UICanvasVertices path;
+    BuildPath(path, 1);
+    DepictCurve curve(path);
+    curve.ApproximationScale(TransAffine::TransAffineScaling(0.25f)); // 0.25f: zoomed out
+    uint32_t smallNum = CountVertices(curve);
+    curve.ApproximationScale(TransAffine());
+    uint32_t normalNum = CountVertices(curve);
+    curve.ApproximationScale(TransAffine::TransAffineScaling(8.0f)); // 8.0f: zoomed in
+    uint32_t largeNum = CountVertices(curve);
+    EXPECT_LT(smallNum, normalNum);
+    EXPECT_LT(normalNum, largeNum);
+}
+
+/**
+ * @tc.name: DepictCurveLodLevels_001
+ * @tc.desc: Scales are quantized to half octaves, every level replays what DepictCurve flattens at
+ *           the scale of the level.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DepictCurveLodTest, DepictCurveLodLevels_001, TestSize.Level0)
+{
+    EXPECT_EQ(DepictCurveLod::GetLevel(1.0f), 0);
+    EXPECT_EQ(DepictCurveLod::GetLevel(1.1f), 0);
+    EXPECT_EQ(DepictCurveLod::GetLevel(2.0f), 2);   // 2: one octave up
+    EXPECT_EQ(DepictCurveLod::GetLevel(0.5f), -2);  // -2: one octave down
+    EXPECT_EQ(DepictCurveLod::GetLevel(1.45f), 1);  // 1: close to sqrt(2)
+    EXPECT_FLOAT_EQ(DepictCurveLod::GetLevelScale(-2), 0.5f); // -2: one octave down
+
+    static PathVertex expected[MAX_VERTICES];
+    static PathVertex actual[MAX_VERTICES];
+    UICanvasVertices path;
+    BuildPath(path, 3); // 3: a few shapes
+    DepictCurve curve(path);
+    DepictCurveLod lod(path);
+    const float scales[] = {0.3f, 1.0f, 2.7f, 6.0f};
+    for (float scale : scales) {
+        lod.ApproximationScale(scale);
+        curve.ApproximationScale(lod.ApproximationScale());
+        uint32_t expectedNum = ReadVertices(curve, expected);
+        ASSERT_EQ(ReadVertices(lod, actual), expectedNum) << "scale " << scale;
+        for (uint32_t i = 0; i < expectedNum; i++) {
+            EXPECT_EQ(actual[i].cmd, expected[i].cmd) << "scale " << scale << " vertex " << i;
+            EXPECT_FLOAT_EQ(actual[i].x, expected[i].x) << "scale " << scale << " vertex " << i;
+            EXPECT_FLOAT_EQ(actual[i].y, expected[i].y) << "scale " << scale << " vertex " << i;
+        }
+        PathVertex block[VERTEX_BATCH_SIZE];
+        uint32_t idx = 0;
+        uint32_t num;
+        lod.Rewind(0);
+        while ((num = lod.GenerateVertices(block, VERTEX_BATCH_SIZE)) > 0) {
+            for (uint32_t i = 0; i < num; i++, idx++) {
+                EXPECT_EQ(block[i].cmd, expected[idx].cmd) << "scale " << scale << " vertex " << idx;
+            }
+        }
+        EXPECT_EQ(idx, expectedNum);
+    }
+}
+
+/**
+ * @tc.name: DepictCurveLodCache_001
+ * @tc.desc: Cached levels are hits, the least recently used level makes room and Invalidate flattens again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(DepictCurveLodTest, DepictCurveLodCache_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildPath(path, 1);
+    DepictCurveLod lod(path);
+    lod.ApproximationScale(1.0f);
+    lod.ApproximationScale(1.05f); // 1.05f: the same level
+    EXPECT_EQ(lod.GetMissCount(), 1u);
+    EXPECT_EQ(lod.GetHitCount(), 1u);
+
+    lod.ApproximationScale(2.0f);  // 2.0f: second level
+    lod.ApproximationScale(4.0f);  // 4.0f: third level
+    lod.ApproximationScale(8.0f);  // 8.0f: fourth level
+    lod.ApproximationScale(1.0f);
+    EXPECT_EQ(lod.GetMissCount(), 4u);
+    EXPECT_EQ(lod.GetHitCount(), 2u);
+    lod.ApproximationScale(16.0f); // 16.0f: evicts 2.0f, the least recently used
+    lod.ApproximationScale(1.0f);
+    EXPECT_EQ(lod.GetHitCount(), 3u);
+    lod.ApproximationScale(2.0f);
+    EXPECT_EQ(lod.GetMissCount(), 6u);
+
+    float x;
+    float y;
+    path.LineTo(100.0f, 100.0f); // 100.0f: a new vertex the cached levels do not have
+    lod.Invalidate();
+    uint32_t last = PATH_CMD_STOP;
+    uint32_t cmd;
+    lod.Rewind(0);
+    while (!IsStop(cmd = lod.GenerateVertex(&x, &y))) {
+        last = cmd;
+    }
+    EXPECT_EQ(lod.GetMissCount(), 7u);
+    EXPECT_EQ(last, static_cast<uint32_t>(PATH_CMD_LINE_TO));
+    EXPECT_FLOAT_EQ(x, 100.0f);
+}
+} // namespace OHOS
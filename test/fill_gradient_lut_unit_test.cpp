@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient_lut.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const Rgba8T RED(255, 0, 0, 255);
+const Rgba8T GREEN(0, 255, 0, 128);
+const Rgba8T BLUE(0, 0, 255, 255);
+
+void BuildLut(FillGradientLut& lut, const Rgba8T& start, const Rgba8T& end)
+{
+    lut.RemoveAll();
+    lut.AddColor(0, start);
+    lut.AddColor(1, end);
+    lut.BuildLut();
+}
+
+bool SameColor(const Rgba8T& a, const Rgba8T& b)
+{
+    return a.red == b.red && a.green == b.green && a.blue == b.blue && a.alpha == b.alpha;
+}
+} // namespace
+
+class FillGradientLutTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+
+    void SetUp()
+    {
+        cache_ = GradientLutCache::GetInstance();
+        cache_->SetMemoryLimit(GRADIENT_LUT_CACHE_MEMORY);
+        cache_->Clear();
+        cache_->ResetCounters();
+    }
+
+    void TearDown()
+    {
+        cache_->SetMemoryLimit(GRADIENT_LUT_CACHE_MEMORY);
+        cache_->Clear();
+    }
+
+    GradientLutCache* cache_ = nullptr;
+};
+
+/**
+ * @tc.name: FillGradientLutCache_001
+ * @tc.desc: Verify equal gradients hit one cached table and different gradients miss.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientLutTest, FillGradientLutCache_001, TestSize.Level0)
+{
+    FillGradientLut lut1;
+    BuildLut(lut1, RED, BLUE);
+    EXPECT_EQ(cache_->GetMissCount(), 1u);
+    EXPECT_EQ(cache_->GetHitCount(), 0u);
+
+    FillGradientLut lut2;
+    BuildLut(lut2, RED, BLUE);
+    EXPECT_EQ(cache_->GetMissCount(), 1u);
+    EXPECT_EQ(cache_->GetHitCount(), 1u);
+    EXPECT_EQ(&lut1[0], &lut2[0]);
+
+    FillGradientLut lut3;
+    BuildLut(lut3, RED, GREEN);
+    EXPECT_EQ(cache_->GetMissCount(), 2u);
+    EXPECT_EQ(cache_->GetHitCount(), 1u);
+    EXPECT_NE(&lut1[0], &lut3[0]);
+
+    cache_->ResetCounters();
+    EXPECT_EQ(cache_->GetMissCount(), 0u);
+    EXPECT_EQ(cache_->GetHitCount(), 0u);
+}
+
+/**
+ * @tc.name: FillGradientLutCache_002
+ * @tc.desc: Verify copies share the table by reference count and it outlives the gradient that built it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientLutTest, FillGradientLutCache_002, TestSize.Level0)
+{
+    cache_->SetMemoryLimit(0);
+    FillGradientLut* lut = new FillGradientLut();
+    BuildLut(*lut, RED, BLUE);
+    uint32_t tableBytes = cache_->GetMemoryUsage();
+    EXPECT_GT(tableBytes, 0u);
+
+    FillGradientLut copy(*lut);
+    FillGradientLut assigned;
+    assigned = *lut;
+    EXPECT_EQ(&copy[0], &(*lut)[0]);
+    EXPECT_EQ(&assigned[0], &(*lut)[0]);
+    delete lut;
+    EXPECT_EQ(cache_->GetMemoryUsage(), tableBytes);
+    EXPECT_TRUE(SameColor(copy[0], RED));
+
+    // rebuilding drops the reference of the old table, which goes once nobody uses it
+    BuildLut(assigned, GREEN, BLUE);
+    EXPECT_EQ(cache_->GetMemoryUsage(), 2 * tableBytes); // 2: both tables are in use
+    BuildLut(copy, GREEN, BLUE);
+    EXPECT_EQ(&copy[0], &assigned[0]);
+    EXPECT_EQ(cache_->GetMemoryUsage(), tableBytes);
+}
+
+/**
+ * @tc.name: FillGradientLutCache_003
+ * @tc.desc: Verify unreferenced tables are evicted in least recently used order above the memory limit.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientLutTest, FillGradientLutCache_003, TestSize.Level0)
+{
+    uint32_t tableBytes;
+    {
+        FillGradientLut lut;
+        BuildLut(lut, RED, BLUE);
+        tableBytes = cache_->GetMemoryUsage();
+    }
+    cache_->SetMemoryLimit(2 * tableBytes); // 2: room for two unreferenced tables
+    {
+        FillGradientLut lut;
+        BuildLut(lut, RED, GREEN);
+    }
+    {
+        // a hit moves the first table to the front, so the second one is the least recently used
+        FillGradientLut lut;
+        BuildLut(lut, RED, BLUE);
+    }
+    {
+        FillGradientLut lut;
+        BuildLut(lut, GREEN, BLUE);
+    }
+    EXPECT_EQ(cache_->GetMemoryUsage(), 2 * tableBytes); // 2: tables kept
+    EXPECT_EQ(cache_->GetMissCount(), 3u); // 3: tables built
+
+    cache_->ResetCounters();
+    FillGradientLut lut1;
+    BuildLut(lut1, RED, BLUE);
+    FillGradientLut lut2;
+    BuildLut(lut2, GREEN, BLUE);
+    EXPECT_EQ(cache_->GetHitCount(), 2u); // 2: both kept tables are found
+    FillGradientLut lut3;
+    BuildLut(lut3, RED, GREEN);
+    EXPECT_EQ(cache_->GetMissCount(), 1u);
+
+    // tables in use are kept over the limit
+    EXPECT_EQ(cache_->GetMemoryUsage(), 3 * tableBytes); // 3: tables in use
+    cache_->SetMemoryLimit(0);
+    EXPECT_EQ(cache_->GetMemoryUsage(), 3 * tableBytes); // 3: tables in use
+    EXPECT_TRUE(SameColor(lut3[0], RED));
+}
+
+/**
+ * @tc.name: FillGradientLutColors_001
+ * @tc.desc: Verify the entries before the first stop and after the last stop take the color of that stop.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientLutTest, FillGradientLutColors_001, TestSize.Level0)
+{
+    FillGradientLut lut;
+    lut.RemoveAll();
+    lut.AddColor(0.75f, BLUE); // 0.75: last stop
+    lut.AddColor(0.25f, RED);  // 0.25: first stop
+    lut.AddColor(0.5f, GREEN); // 0.5: middle stop
+    lut.BuildLut();
+    uint32_t first = COLOR_LUT_SIZE / 4; // 4: the first stop is at a quarter
+    uint32_t middle = COLOR_LUT_SIZE / 2; // 2: the middle stop is at a half
+    uint32_t last = COLOR_LUT_SIZE * 3 / 4; // 3, 4: the last stop is at three quarters
+    for (uint32_t i = 0; i <= first; i++) {
+        EXPECT_TRUE(SameColor(lut[i], RED)) << "index " << i;
+    }
+    EXPECT_TRUE(SameColor(lut[middle], GREEN));
+    for (uint32_t i = last; i < COLOR_LUT_SIZE; i++) {
+        EXPECT_TRUE(SameColor(lut[i], BLUE)) << "index " << i;
+    }
+}
+} // namespace OHOS
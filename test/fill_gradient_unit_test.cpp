@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_gradient.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t TRANSFORM_NUM = 200;
+const int32_t SPAN_NUM = 20;
+const uint32_t MAX_SPAN_LENGTH = 300;
+const float START_RADIUS = 5.0f;
+const float END_RADIUS = 100.0f;
+
+void BuildLut(FillGradientLut& lut)
+{
+    lut.RemoveAll();
+    lut.AddColor(0, Rgba8T(255, 0, 0, 255)); // 255: opaque red
+    lut.AddColor(0.5f, Rgba8T(0, 255, 0, 128)); // 0.5: middle stop, 128: half transparent green
+    lut.AddColor(1, Rgba8T(0, 0, 255, 255)); // 255: opaque blue
+    lut.BuildLut();
+}
+
+/* Identity, translations with a fraction, integer scales and rotations, the first three take the fast paths. */
+TransAffine RandomTransform(int32_t kind)
+{
+    TransAffine transform;
+    switch (kind) {
+        case 1: // 1: translation
+            transform.Translate(rand() % 200 - 100 + 0.25f * (rand() % 4), rand() % 50); // 200, 50: offsets
+            break;
+        case 2: // 2: integer scale
+            transform.Scale(static_cast<float>(rand() % 3 + 1)); // 3: scales 1 to 3
+            transform.Translate(rand() % 20 - 40, 3); // 20, 40, 3: offsets
+            break;
+        case 3: // 3: rotation
+            transform.Rotate(0.3f * (rand() % 10)); // 0.3: angle step
+            transform.Translate(rand() % 100, rand() % 100); // 100: offsets
+            break;
+        default:
+            break;
+    }
+    transform.Invert();
+    return transform;
+}
+} // namespace
+
+class FillGradientTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FillGradientFastLinear_001
+ * @tc.desc: Verify FillGradientFast generates the same linear gradient spans as FillGradient.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientTest, FillGradientFastLinear_001, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    GradientLinearCalculate linear;
+    srand(1);
+    for (int32_t t = 0; t < TRANSFORM_NUM; t++) {
+        TransAffine transform = RandomTransform(t % 4); // 4: kinds of transform
+        FillInterpolator interpolator(transform);
+        FillInterpolator fastInterpolator(transform);
+        float distance = static_cast<float>(rand() % 300 + 1); // 300: gradient lengths
+        FillGradient gradient(interpolator, linear, lut, 0, distance);
+        FillGradientFast<GradientLinearCalculate> fast(fastInterpolator, linear, lut, 0, distance);
+        for (int32_t s = 0; s < SPAN_NUM; s++) {
+            int32_t x = rand() % 600 - 100; // 600, 100: span start around the gradient
+            int32_t y = rand() % 400; // 400: rows
+            uint32_t len = rand() % MAX_SPAN_LENGTH + 1;
+            Rgba8T expect[MAX_SPAN_LENGTH];
+            Rgba8T span[MAX_SPAN_LENGTH];
+            gradient.Generate(expect, x, y, len);
+            fast.Generate(span, x, y, len);
+            EXPECT_EQ(memcmp(expect, span, len * sizeof(Rgba8T)), 0) << "transform " << t << " span " << s;
+        }
+    }
+}
+
+/**
+ * @tc.name: FillGradientFastRadial_001
+ * @tc.desc: Verify FillGradientFast generates the same radial gradient spans as FillGradient.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillGradientTest, FillGradientFastRadial_001, TestSize.Level0)
+{
+    FillGradientLut lut;
+    BuildLut(lut);
+    GradientRadialCalculate radial(100, 10, 5); // 100: end radius, 10, 5: start center
+    srand(2); // 2: seed
+    for (int32_t t = 0; t < TRANSFORM_NUM; t++) {
+        TransAffine transform = RandomTransform(t % 4); // 4: kinds of transform
+        FillInterpolator interpolator(transform);
+        FillInterpolator fastInterpolator(transform);
+        FillGradient gradient(interpolator, radial, lut, START_RADIUS, END_RADIUS);
+        FillGradientFast<GradientRadialCalculate> fast(fastInterpolator, radial, lut, START_RADIUS, END_RADIUS);
+        for (int32_t s = 0; s < SPAN_NUM; s++) {
+            int32_t x = rand() % 600 - 100; // 600, 100: span start around the gradient
+            int32_t y = rand() % 400; // 400: rows
+            uint32_t len = rand() % MAX_SPAN_LENGTH + 1;
+            Rgba8T expect[MAX_SPAN_LENGTH];
+            Rgba8T span[MAX_SPAN_LENGTH];
+            gradient.Generate(expect, x, y, len);
+            fast.Generate(span, x, y, len);
+            EXPECT_EQ(memcmp(expect, span, len * sizeof(Rgba8T)), 0) << "transform " << t << " span " << s;
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/spancolorfill/fill_pattern_rgba.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint16_t PATTERN_WIDTH = 7;
+const uint16_t PATTERN_HEIGHT = 5;
+const int32_t START_X = 10;
+const int32_t START_Y = 20;
+const uint32_t SPAN_LENGTH = 40;
+const uint8_t RED_STEP = 10;
+const uint8_t GREEN_STEP = 20;
+
+/* Red counts the columns and green the rows, so every texel of the pattern is different. */
+class PatternImage {
+public:
+    PatternImage()
+    {
+        for (int32_t row = 0; row < PATTERN_HEIGHT; row++) {
+            for (int32_t col = 0; col < PATTERN_WIDTH; col++) {
+                Color32& texel = pixels_[row * PATTERN_WIDTH + col];
+                texel.red = col * RED_STEP;
+                texel.green = row * GREEN_STEP;
+                texel.blue = 1;
+                texel.alpha = OPA_OPAQUE;
+            }
+        }
+        info_.header.colorMode = ARGB8888;
+        info_.header.width = PATTERN_WIDTH;
+        info_.header.height = PATTERN_HEIGHT;
+        info_.dataSize = sizeof(pixels_);
+        info_.data = reinterpret_cast<const uint8_t*>(pixels_);
+        info_.userData = nullptr;
+    }
+
+    const ImageInfo* GetInfo() const
+    {
+        return &info_;
+    }
+
+private:
+    Color32 pixels_[PATTERN_WIDTH * PATTERN_HEIGHT];
+    ImageInfo info_;
+};
+
+int32_t Wrap(int32_t index, int32_t size, bool repeat)
+{
+    if (repeat) {
+        return ((index % size) + size) % size;
+    }
+    return (index >= 0 && index < size) ? index : -1;
+}
+
+/* The texel drawn at pattern coordinate (u, v), opaque black outside of a non repeating axis. */
+Rgba8T ExpectedTexel(int32_t u, int32_t v, PatternRepeatMode mode)
+{
+    int32_t col = Wrap(u, PATTERN_WIDTH, mode == REPEAT || mode == REPEAT_X);
+    int32_t row = Wrap(v, PATTERN_HEIGHT, mode == REPEAT || mode == REPEAT_Y);
+    if (col < 0 || row < 0) {
+        return Rgba8T(0, 0, 0, OPA_OPAQUE);
+    }
+    return Rgba8T(col * RED_STEP, row * GREEN_STEP, 1, OPA_OPAQUE);
+}
+
+bool SameColor(const Rgba8T& a, const Rgba8T& b)
+{
+    return a.red == b.red && a.green == b.green && a.blue == b.blue && a.alpha == b.alpha;
+}
+
+bool SameSpan(const Rgba8T* a, const Rgba8T* b, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        if (!SameColor(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+class FillPatternRgbaTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FillPatternRgbaRepeat_001
+ * @tc.desc: Verify every repeat mode draws the wrapped texel or black, also left of and above the start point.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillPatternRgbaTest, FillPatternRgbaRepeat_001, TestSize.Level0)
+{
+    PatternImage image;
+    const PatternRepeatMode modes[] = {REPEAT, REPEAT_X, REPEAT_Y, NO_REPEAT};
+    for (PatternRepeatMode mode : modes) {
+        FillPatternRgba pattern(image.GetInfo(), mode, START_X, START_Y);
+        // rows and span starts on both sides of the start point, -30: far left of the start point
+        for (int32_t y = START_Y - 2 * PATTERN_HEIGHT; y < START_Y + 2 * PATTERN_HEIGHT; y++) { // 2: two tiles
+            for (int32_t x = -30; x < START_X + PATTERN_WIDTH; x += 3) { // 3: span start step
+                Rgba8T span[SPAN_LENGTH];
+                pattern.Generate(span, x, y, SPAN_LENGTH);
+                bool same = true;
+                for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+                    int32_t u = x + static_cast<int32_t>(i) - START_X;
+                    same = same && SameColor(span[i], ExpectedTexel(u, y - START_Y, mode));
+                }
+                EXPECT_TRUE(same) << "mode " << mode << " x " << x << " y " << y;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FillPatternRgbaTransform_001
+ * @tc.desc: Verify the nearest sampler picks the texel under every pixel center of a scaled pattern.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillPatternRgbaTest, FillPatternRgbaTransform_001, TestSize.Level0)
+{
+    PatternImage image;
+    const PatternRepeatMode modes[] = {REPEAT, NO_REPEAT};
+    for (PatternRepeatMode mode : modes) {
+        FillPatternRgba pattern(image.GetInfo(), mode, START_X, START_Y);
+        pattern.SetTransform(TransAffine::TransAffineScaling(2.0f)); // 2.0: every texel covers 2 x 2 pixels
+        for (int32_t y = START_Y - PATTERN_HEIGHT; y < START_Y + 3 * PATTERN_HEIGHT; y++) { // 3: rows of tiles
+            Rgba8T span[SPAN_LENGTH];
+            int32_t x = START_X - PATTERN_WIDTH;
+            pattern.Generate(span, x, y, SPAN_LENGTH);
+            bool same = true;
+            for (uint32_t i = 0; i < SPAN_LENGTH; i++) {
+                int32_t px = x + static_cast<int32_t>(i) - START_X;
+                int32_t u = static_cast<int32_t>(std::floor(px / 2.0f)); // 2.0: scale
+                int32_t v = static_cast<int32_t>(std::floor((y - START_Y) / 2.0f)); // 2.0: scale
+                same = same && SameColor(span[i], ExpectedTexel(u, v, mode));
+            }
+            EXPECT_TRUE(same) << "mode " << mode << " y " << y;
+        }
+    }
+}
+
+/**
+ * @tc.name: FillPatternRgbaTransform_002
+ * @tc.desc: Verify the bilinear sampler hits texel centers exactly and blends between them.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillPatternRgbaTest, FillPatternRgbaTransform_002, TestSize.Level0)
+{
+    PatternImage image;
+    // an integer translation samples texel centers, so bilinear equals nearest
+    FillPatternRgba bilinear(image.GetInfo(), REPEAT, START_X, START_Y);
+    bilinear.SetTransform(TransAffine::TransAffineTranslation(3.0f, 1.0f), PATTERN_FILTER_BILINEAR); // 3, 1: offset
+    FillPatternRgba nearest(image.GetInfo(), REPEAT, START_X, START_Y);
+    nearest.SetTransform(TransAffine::TransAffineTranslation(3.0f, 1.0f)); // 3, 1: offset
+    Rgba8T span[SPAN_LENGTH];
+    Rgba8T expect[SPAN_LENGTH];
+    for (int32_t y = 0; y < START_Y + PATTERN_HEIGHT; y++) {
+        bilinear.Generate(span, -START_X, y, SPAN_LENGTH);
+        nearest.Generate(expect, -START_X, y, SPAN_LENGTH);
+        EXPECT_TRUE(SameSpan(span, expect, SPAN_LENGTH)) << "y " << y;
+    }
+
+    // scaled by 2 the pixel centers fall a quarter texel away from the texel centers
+    bilinear.SetTransform(TransAffine::TransAffineScaling(2.0f), PATTERN_FILTER_BILINEAR); // 2.0: scale
+    int32_t y = START_Y + 2; // 2: the first texel row, v = 0.75 of a texel
+    bilinear.Generate(span, START_X, y, PATTERN_WIDTH * 2); // 2: scale
+    for (int32_t col = 1; col < PATTERN_WIDTH - 1; col++) {
+        // u = col + 0.25 and col + 0.75, red is 10 * u rounded half up
+        EXPECT_EQ(span[col * 2 + 1].red, col * RED_STEP + 3) << "col " << col; // 2: scale, 3: 2.5 rounded
+        EXPECT_EQ(span[col * 2 + 2].red, col * RED_STEP + 8) << "col " << col; // 2: scale, 8: 7.5 rounded
+    }
+    EXPECT_EQ(span[PATTERN_WIDTH].green, GREEN_STEP * 3 / 4); // 3, 4: three quarters of the way to the next row
+}
+
+/**
+ * @tc.name: FillPatternRgbaTransform_003
+ * @tc.desc: Verify a singular transform is rejected and the pattern is drawn untransformed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FillPatternRgbaTest, FillPatternRgbaTransform_003, TestSize.Level0)
+{
+    PatternImage image;
+    FillPatternRgba plain(image.GetInfo(), REPEAT, START_X, START_Y);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const TransAffine singular[] = {
+        TransAffine(0, 0, 0, 0, 0, 0),
+        TransAffine(1.0f, 2.0f, 2.0f, 4.0f, 5.0f, 6.0f), // rows 1, 2 and 2, 4 are parallel, 5, 6: offset
+        TransAffine(1e-30f, 0, 0, 1e-30f, 0, 0), // 1e-30: the reciprocal of the determinant overflows
+        TransAffine(nan, 0, 0, 1.0f, 0, 0),
+    };
+    for (const TransAffine& transform : singular) {
+        FillPatternRgba pattern(image.GetInfo(), REPEAT, START_X, START_Y);
+        pattern.SetTransform(transform, PATTERN_FILTER_BILINEAR);
+        for (int32_t y = 0; y < START_Y + PATTERN_HEIGHT; y++) {
+            Rgba8T span[SPAN_LENGTH];
+            Rgba8T expect[SPAN_LENGTH];
+            pattern.Generate(span, 0, y, SPAN_LENGTH);
+            plain.Generate(expect, 0, y, SPAN_LENGTH);
+            EXPECT_TRUE(SameSpan(span, expect, SPAN_LENGTH)) << "y " << y;
+        }
+    }
+}
+} // namespace OHOS
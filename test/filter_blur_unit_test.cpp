@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/imagefilter/filter_blur.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 53;
+const int32_t IMAGE_HEIGHT = 29;
+const int32_t STRIDE_PADDING = 7;
+const uint8_t PADDING_VALUE = 0xA5;
+const uint16_t BLUR_RADIUS[] = {1, 3, 9, 40};
+const double MAX_REFERENCE_DIFF = 1.5; // 1.5: the rows and the columns are rounded to 8 bits each
+
+struct TestImage {
+    TestImage(int32_t width, int32_t height, int32_t channel)
+        : width(width), height(height), stride(width * channel + STRIDE_PADDING), data(stride * height)
+    {
+    }
+
+    int32_t GetWidth() const
+    {
+        return width;
+    }
+
+    int32_t GetHeight() const
+    {
+        return height;
+    }
+
+    uint8_t* PixValuePtr(int32_t x, int32_t y)
+    {
+        return data.data() + y * stride + x;
+    }
+
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    std::vector<uint8_t> data;
+};
+
+/* Random pixels, the bytes behind every row are set to PADDING_VALUE. */
+void FillRandom(TestImage& img, int32_t channel, uint32_t seed)
+{
+    srand(seed);
+    for (int32_t y = 0; y < img.height; y++) {
+        uint8_t* line = img.PixValuePtr(0, y);
+        for (int32_t i = 0; i < img.stride; i++) {
+            line[i] = (i < img.width * channel) ? static_cast<uint8_t>(rand()) : PADDING_VALUE;
+        }
+    }
+}
+
+bool PaddingUntouched(TestImage& img, int32_t channel)
+{
+    for (int32_t y = 0; y < img.height; y++) {
+        uint8_t* line = img.PixValuePtr(0, y);
+        for (int32_t i = img.width * channel; i < img.stride; i++) {
+            if (line[i] != PADDING_VALUE) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Straight blur in double precision with the edge pixels repeated, colors weighted by alpha for four channels. */
+void ReferenceBlurLine(std::vector<double>& line, int32_t channel, const std::vector<double>& kernel)
+{
+    int32_t n = static_cast<int32_t>(line.size()) / channel;
+    int32_t radius = static_cast<int32_t>(kernel.size()) / 2; // 2: the kernel has 2 * radius + 1 taps
+    std::vector<double> out(line.size(), 0);
+    for (int32_t i = 0; i < n; i++) {
+        for (int32_t k = -radius; k <= radius; k++) {
+            int32_t j = MATH_MIN(MATH_MAX(i + k, 0), n - 1);
+            for (int32_t c = 0; c < channel; c++) {
+                out[i * channel + c] += kernel[k + radius] * line[j * channel + c];
+            }
+        }
+    }
+    line.swap(out);
+}
+
+void ReferenceBlur(TestImage& img, int32_t channel, const std::vector<double>& kernel, std::vector<double>& result)
+{
+    result.assign(img.width * img.height * channel, 0);
+    for (int32_t y = 0; y < img.height; y++) {
+        for (int32_t i = 0; i < img.width * channel; i++) {
+            result[y * img.width * channel + i] = img.PixValuePtr(0, y)[i];
+        }
+    }
+    if (channel == FOUR_TIMES) {
+        for (size_t i = 0; i < result.size(); i += FOUR_TIMES) {
+            for (int32_t c = 0; c < 3; c++) { // 3: color channels
+                result[i + c] *= result[i + 3]; // 3: alpha index
+            }
+        }
+    }
+    for (int32_t y = 0; y < img.height; y++) {
+        std::vector<double> line(result.begin() + y * img.width * channel,
+                                 result.begin() + (y + 1) * img.width * channel);
+        ReferenceBlurLine(line, channel, kernel);
+        std::copy(line.begin(), line.end(), result.begin() + y * img.width * channel);
+    }
+    for (int32_t x = 0; x < img.width; x++) {
+        std::vector<double> line(img.height * channel);
+        for (int32_t y = 0; y < img.height; y++) {
+            for (int32_t c = 0; c < channel; c++) {
+                line[y * channel + c] = result[(y * img.width + x) * channel + c];
+            }
+        }
+        ReferenceBlurLine(line, channel, kernel);
+        for (int32_t y = 0; y < img.height; y++) {
+            for (int32_t c = 0; c < channel; c++) {
+                result[(y * img.width + x) * channel + c] = line[y * channel + c];
+            }
+        }
+    }
+    if (channel == FOUR_TIMES) {
+        for (size_t i = 0; i < result.size(); i += FOUR_TIMES) {
+            for (int32_t c = 0; c < 3; c++) { // 3: color channels
+                result[i + c] = (result[i + 3] > 0) ? result[i + c] / result[i + 3] : 0; // 3: alpha index
+            }
+        }
+    }
+}
+
+std::vector<double> GaussianKernel(int32_t radius)
+{
+    double sigma = MATH_MAX(radius / 3.0, 0.5); // 3.0: sigma is a third of the radius, 0.5: smallest sigma
+    std::vector<double> kernel(2 * radius + 1); // 2: taps on both sides
+    double total = 0;
+    for (int32_t i = -radius; i <= radius; i++) {
+        kernel[i + radius] = std::exp(-i * i / (2 * sigma * sigma)); // 2: gaussian exponent
+        total += kernel[i + radius];
+    }
+    for (double& weight : kernel) {
+        weight /= total;
+    }
+    return kernel;
+}
+
+std::vector<double> StackKernel(int32_t radius)
+{
+    std::vector<double> kernel(2 * radius + 1); // 2: taps on both sides
+    for (int32_t i = -radius; i <= radius; i++) {
+        kernel[i + radius] = static_cast<double>(radius + 1 - std::abs(i)) / ((radius + 1) * (radius + 1));
+    }
+    return kernel;
+}
+
+int32_t MaxDiff(TestImage& a, TestImage& b)
+{
+    int32_t maxDiff = 0;
+    for (size_t i = 0; i < a.data.size(); i++) {
+        maxDiff = MATH_MAX(maxDiff, std::abs(a.data[i] - b.data[i]));
+    }
+    return maxDiff;
+}
+} // namespace
+
+class FilterBlurTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: FilterBlurBoxBlurDefault_001
+ * @tc.desc: Verify BoxBlur uses the integral image unless another mode is set.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurDefault_001, TestSize.Level0)
+{
+    TestImage integral(IMAGE_WIDTH, IMAGE_HEIGHT, FOUR_TIMES);
+    FillRandom(integral, FOUR_TIMES, 1);
+    TestImage def = integral;
+    Filterblur integralBlur;
+    integralBlur.SetBlurMode(Filterblur::BLUR_MODE_INTEGRAL);
+    integralBlur.BoxBlur(integral, 3, FOUR_TIMES, integral.stride); // 3: radius
+    Filterblur defaultBlur;
+    defaultBlur.BoxBlur(def, 3, FOUR_TIMES, def.stride); // 3: radius
+    EXPECT_TRUE(def.data == integral.data);
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlurSeparable_001
+ * @tc.desc: Verify the separable box blur differs from the integral one by at most 1 per channel,
+ *           keeps the alpha channel and leaves the bytes behind every row untouched.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurSeparable_001, TestSize.Level0)
+{
+    for (uint16_t radius : BLUR_RADIUS) {
+        TestImage integral(IMAGE_WIDTH, IMAGE_HEIGHT, FOUR_TIMES);
+        FillRandom(integral, FOUR_TIMES, radius);
+        TestImage separable = integral;
+        TestImage source = integral;
+        Filterblur integralBlur;
+        integralBlur.SetBlurMode(Filterblur::BLUR_MODE_INTEGRAL);
+        integralBlur.BoxBlur(integral, radius, FOUR_TIMES, integral.stride);
+        Filterblur separableBlur;
+        separableBlur.SetBlurMode(Filterblur::BLUR_MODE_SEPARABLE);
+        separableBlur.BoxBlur(separable, radius, FOUR_TIMES, separable.stride);
+
+        EXPECT_LE(MaxDiff(integral, separable), 1) << "radius " << radius;
+        EXPECT_TRUE(PaddingUntouched(separable, FOUR_TIMES)) << "radius " << radius;
+        EXPECT_TRUE(PaddingUntouched(integral, FOUR_TIMES)) << "radius " << radius;
+        bool alphaKept = true;
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+                int32_t index = x * FOUR_TIMES + 3; // 3: alpha index
+                alphaKept = alphaKept && (separable.PixValuePtr(0, y)[index] == source.PixValuePtr(0, y)[index]);
+            }
+        }
+        EXPECT_TRUE(alphaKept) << "radius " << radius;
+    }
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlurSeparable_002
+ * @tc.desc: Verify the separable box blur of one and three channel images leaves the row padding untouched
+ *           and keeps a flat image flat.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurSeparable_002, TestSize.Level0)
+{
+    const int32_t channels[] = {1, THREE_TIMES};
+    for (int32_t channel : channels) {
+        TestImage img(IMAGE_WIDTH, IMAGE_HEIGHT, channel);
+        FillRandom(img, channel, channel);
+        Filterblur blur;
+        blur.SetBlurMode(Filterblur::BLUR_MODE_SEPARABLE);
+        blur.SetBoxBlurPasses(3); // 3: approximate a gaussian blur
+        blur.BoxBlur(img, 5, channel, img.stride); // 5: radius
+        EXPECT_TRUE(PaddingUntouched(img, channel)) << "channel " << channel;
+
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            memset_s(img.PixValuePtr(0, y), IMAGE_WIDTH * channel, 77, IMAGE_WIDTH * channel); // 77: any value
+        }
+        blur.BoxBlur(img, 5, channel, img.stride); // 5: radius
+        bool flat = true;
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t i = 0; i < IMAGE_WIDTH * channel; i++) {
+                flat = flat && (img.PixValuePtr(0, y)[i] == 77); // 77: the value filled above
+            }
+        }
+        EXPECT_TRUE(flat) << "channel " << channel;
+    }
+}
+
+/**
+ * @tc.name: FilterBlurBoxBlurSeparable_003
+ * @tc.desc: Verify the separable box blur rounds the average exactly for windows wider than 4096 pixels,
+ *           where a 32 bit reciprocal is off by one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurBoxBlurSeparable_003, TestSize.Level0)
+{
+    const int32_t width = 60000;
+    const uint16_t radius = 30000;
+    TestImage img(width, 1, 1);
+    FillRandom(img, 1, radius);
+    std::vector<int64_t> prefix(width + 1, 0);
+    for (int32_t x = 0; x < width; x++) {
+        prefix[x + 1] = prefix[x] + img.PixValuePtr(x, 0)[0];
+    }
+    Filterblur blur;
+    blur.SetBlurMode(Filterblur::BLUR_MODE_SEPARABLE);
+    blur.BoxBlur(img, radius, 1, img.stride);
+    int32_t errors = 0;
+    for (int32_t x = 0; x < width; x++) {
+        int32_t left = MATH_MAX(x - radius, 0);
+        int32_t right = MATH_MIN(x + radius + 1, width);
+        int64_t count = right - left;
+        int64_t average = (prefix[right] - prefix[left] + count / 2) / count; // 2: round to nearest
+        errors += (img.PixValuePtr(x, 0)[0] != average) ? 1 : 0;
+    }
+    EXPECT_EQ(errors, 0);
+}
+
+/**
+ * @tc.name: FilterBlurKernelFlat_001
+ * @tc.desc: Verify the gaussian and stack blurs keep a flat image exactly flat for every channel count,
+ *           including radii whose stack sums need 64 bits.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurKernelFlat_001, TestSize.Level0)
+{
+    const uint8_t pixel[] = {200, 77, 13, 10};
+    const int32_t channels[] = {1, THREE_TIMES, FOUR_TIMES};
+    const uint16_t radius[] = {1, 7, 300, 5000};
+    for (int32_t channel : channels) {
+        for (uint16_t r : radius) {
+            for (int32_t stack = 0; stack < 2; stack++) { // 2: gaussian and stack blur
+                TestImage img(IMAGE_WIDTH, IMAGE_HEIGHT, channel);
+                FillRandom(img, channel, 0);
+                for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+                    for (int32_t i = 0; i < IMAGE_WIDTH * channel; i++) {
+                        img.PixValuePtr(0, y)[i] = pixel[i % channel];
+                    }
+                }
+                TestImage source = img;
+                Filterblur blur;
+                if (stack != 0) {
+                    blur.StackBlur(img, r, channel, img.stride);
+                } else {
+                    blur.GaussianBlur(img, r, channel, img.stride);
+                }
+                EXPECT_TRUE(img.data == source.data) << "channel " << channel << " radius " << r << " stack " << stack;
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FilterBlurKernelReference_001
+ * @tc.desc: Verify the gaussian and stack blurs of random images match a double precision separable blur,
+ *           colors of four channel images being weighted by alpha and compared premultiplied.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurKernelReference_001, TestSize.Level0)
+{
+    const int32_t channels[] = {1, THREE_TIMES, FOUR_TIMES};
+    const uint16_t radius[] = {1, 4, 12};
+    for (int32_t channel : channels) {
+        for (uint16_t r : radius) {
+            for (int32_t stack = 0; stack < 2; stack++) { // 2: gaussian and stack blur
+                TestImage img(IMAGE_WIDTH, IMAGE_HEIGHT, channel);
+                FillRandom(img, channel, r + channel);
+                std::vector<double> reference;
+                ReferenceBlur(img, channel, (stack != 0) ? StackKernel(r) : GaussianKernel(r), reference);
+                Filterblur blur;
+                if (stack != 0) {
+                    blur.StackBlur(img, r, channel, img.stride);
+                } else {
+                    blur.GaussianBlur(img, r, channel, img.stride);
+                }
+                double maxDiff = 0;
+                for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+                    const double* expect = reference.data() + y * IMAGE_WIDTH * channel;
+                    const uint8_t* pixel = img.PixValuePtr(0, y);
+                    for (int32_t i = 0; i < IMAGE_WIDTH * channel; i++) {
+                        double value = pixel[i];
+                        double expectValue = expect[i];
+                        if (channel == FOUR_TIMES && (i % FOUR_TIMES) != 3) { // 3: alpha index
+                            // translucent colors are compared as they are composed, that is multiplied by alpha
+                            int32_t alphaIndex = i - (i % FOUR_TIMES) + 3; // 3: alpha index
+                            value = value * pixel[alphaIndex] / OPA_OPAQUE;
+                            expectValue = expectValue * expect[alphaIndex] / OPA_OPAQUE;
+                        }
+                        maxDiff = MATH_MAX(maxDiff, std::fabs(value - expectValue));
+                    }
+                }
+                EXPECT_LE(maxDiff, MAX_REFERENCE_DIFF) << "channel " << channel << " radius " << r
+                                                       << " stack " << stack;
+                EXPECT_TRUE(PaddingUntouched(img, channel));
+            }
+        }
+    }
+}
+
+/**
+ * @tc.name: FilterBlurKernelPremultiply_001
+ * @tc.desc: Verify blurring keeps the straight colors of translucent pixels for every alpha,
+ *           and keeps premultiplied images when SetPremultiplied is set.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FilterBlurTest, FilterBlurKernelPremultiply_001, TestSize.Level0)
+{
+    const uint8_t color[] = {200, 77, 13};
+    for (int32_t premultiplied = 0; premultiplied < 2; premultiplied++) { // 2: straight and premultiplied
+        Filterblur blur;
+        blur.SetPremultiplied(premultiplied != 0);
+        for (int32_t alpha = 1; alpha <= OPA_OPAQUE; alpha++) {
+            TestImage img(5, 5, FOUR_TIMES); // 5: width and height
+            for (int32_t y = 0; y < img.height; y++) {
+                for (int32_t x = 0; x < img.width; x++) {
+                    uint8_t* pixel = img.PixValuePtr(x * FOUR_TIMES, y);
+                    for (int32_t c = 0; c < 3; c++) { // 3: color channels
+                        pixel[c] = (premultiplied != 0) ? Rgba8T::Multiply(color[c], alpha) : color[c];
+                    }
+                    pixel[3] = alpha; // 3: alpha index
+                }
+            }
+            TestImage source = img;
+            blur.GaussianBlur(img, 2, FOUR_TIMES, img.stride); // 2: radius
+            EXPECT_TRUE(img.data == source.data) << "alpha " << alpha << " premultiplied " << premultiplied;
+            blur.StackBlur(img, 2, FOUR_TIMES, img.stride); // 2: radius
+            EXPECT_TRUE(img.data == source.data) << "alpha " << alpha << " premultiplied " << premultiplied;
+        }
+    }
+}
+} // namespace OHOS
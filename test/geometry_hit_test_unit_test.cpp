@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_hit_test.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 200;
+const int32_t IMAGE_HEIGHT = 160;
+const int32_t STAR_POINTS = 5;
+
+/*
+ * A pentagram, its center is wound twice, a curved blob and a ring whose hole is wound the same way
+ * as the outline, so the two filling rules disagree on the center and on the hole.
+ */
+void BuildShape(UICanvasVertices& path)
+{
+    for (int32_t i = 0; i < STAR_POINTS; i++) {
+        float angle = (i * 2 * 2 + 0.3f) * UI_PI / STAR_POINTS; // 2: every second point, 2: full turn, 0.3: tilt
+        float x = 60.1f + 45.0f * std::cos(angle);               // 60.1, 45: center and radius
+        float y = 60.3f + 45.0f * std::sin(angle);               // 60.3, 45: center and radius
+        if (i == 0) {
+            path.MoveTo(x, y);
+        } else {
+            path.LineTo(x, y);
+        }
+    }
+    path.EndPoly();
+    path.MoveTo(120.2f, 20.1f);
+    path.CubicBezierCurve(190.0f, 10.0f, 200.0f, 90.0f, 150.3f, 70.2f);
+    path.CubicBezierCurve(130.0f, 60.0f, 100.0f, 40.0f, 120.2f, 20.1f);
+    path.EndPoly();
+    path.MoveTo(30.2f, 110.1f);
+    path.LineTo(170.3f, 110.4f);
+    path.LineTo(170.1f, 150.2f);
+    path.LineTo(30.4f, 150.3f);
+    path.EndPoly();
+    path.MoveTo(60.2f, 120.3f);
+    path.LineTo(140.1f, 120.2f);
+    path.LineTo(140.3f, 140.4f);
+    path.LineTo(60.1f, 140.2f);
+    path.EndPoly();
+}
+
+/* Sweeps the rasterized shape into a cover image. */
+void RenderCovers(UICanvasVertices& path, FillingRule rule, uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH])
+{
+    DepictCurve curve(path);
+    RasterizerScanlineAntialias ras;
+    ras.SetFillingRule(rule);
+    ras.AddPath(curve);
+    for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+            covers[y][x] = 0;
+        }
+    }
+    GeometryScanline sl;
+    if (!ras.RewindScanlines()) {
+        return;
+    }
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        GeometryScanline::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            for (int32_t k = 0; k < span->spanLength; k++) {
+                covers[sl.GetYLevel()][span->x + k] = span->covers[k];
+            }
+        }
+    }
+}
+} // namespace
+
+class GeometryHitTestTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: GeometryHitTest_001
+ * @tc.desc: Verify the hit test matches the rasterized coverage on fully covered and empty pixels,
+ *           for both filling rules, with and without the edge index and in the single pass form.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryHitTestTest, GeometryHitTest_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildShape(path);
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    for (FillingRule rule : rules) {
+        RenderCovers(path, rule, covers);
+        GeometryHitTest hitTest;
+        hitTest.SetFillingRule(rule);
+        DepictCurve curve(path);
+        hitTest.AddPath(curve);
+        GeometryHitTest indexed;
+        indexed.SetFillingRule(rule);
+        indexed.AddPath(curve);
+        indexed.BuildIndex();
+        ASSERT_TRUE(indexed.HasIndex());
+        uint32_t inside = 0;
+        uint32_t checked = 0;
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+                if (covers[y][x] != 0 && covers[y][x] != 255) { // 255: fully covered
+                    continue;
+                }
+                bool expect = covers[y][x] != 0;
+                float px = x + 0.5f; // 0.5: pixel center
+                float py = y + 0.5f; // 0.5: pixel center
+                EXPECT_EQ(hitTest.HitTest(px, py), expect) << x << "," << y;
+                EXPECT_EQ(indexed.HitTest(px, py), expect) << x << "," << y;
+                EXPECT_EQ(GeometryHitTest::HitTestPath(curve, px, py, rule), expect) << x << "," << y;
+                inside += expect ? 1 : 0;
+                checked++;
+            }
+        }
+        EXPECT_GT(inside, 0U);
+        EXPECT_GT(checked, static_cast<uint32_t>(IMAGE_WIDTH * IMAGE_HEIGHT / 2)); // 2: most pixels are not on edges
+    }
+}
+
+/**
+ * @tc.name: GeometryHitTest_002
+ * @tc.desc: Verify the winding numbers, the bounding box, the edge rules and transformed paths.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryHitTestTest, GeometryHitTest_002, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildShape(path);
+    DepictCurve curve(path);
+    GeometryHitTest hitTest;
+    hitTest.AddPath(curve);
+    EXPECT_EQ(hitTest.GetWinding(60.1f, 60.3f), 2);      // 2: pentagram center
+    EXPECT_EQ(hitTest.GetWinding(100.0f, 130.0f), 2);    // 2: hole of the ring
+    EXPECT_EQ(hitTest.GetWinding(100.0f, 115.0f), 1);
+    EXPECT_EQ(hitTest.GetWinding(-10.0f, 60.0f), 0);
+    EXPECT_EQ(hitTest.GetWinding(100.0f, 155.0f), 0);
+    EXPECT_LE(hitTest.GetMinX(), 30.2f);
+    EXPECT_LT(hitTest.GetMaxY(), 150.5f);
+    EXPECT_GT(hitTest.GetMaxX(), 170.0f);
+    hitTest.SetFillingRule(FILL_EVEN_ODD);
+    EXPECT_FALSE(hitTest.HitTest(100.0f, 130.0f));
+    EXPECT_TRUE(hitTest.HitTest(100.0f, 115.0f));
+
+    /* A point on the left or top edge is inside, on the right or bottom edge outside */
+    GeometryHitTest square;
+    square.MoveTo(10.0f, 10.0f);
+    square.LineTo(20.0f, 10.0f);
+    square.LineTo(20.0f, 20.0f);
+    square.LineTo(10.0f, 20.0f);
+    square.ClosePolygon();
+    EXPECT_EQ(square.GetEdgeNum(), 2U); // 2: horizontal edges are dropped
+    EXPECT_TRUE(square.HitTest(10.0f, 15.0f));
+    EXPECT_TRUE(square.HitTest(15.0f, 10.0f));
+    EXPECT_FALSE(square.HitTest(20.0f, 15.0f));
+    EXPECT_FALSE(square.HitTest(15.0f, 20.0f));
+    EXPECT_TRUE(square.HitTest(10.0f, 10.0f));
+    square.BuildIndex(3); // 3: buckets not aligned to the square
+    EXPECT_TRUE(square.HitTest(10.0f, 15.0f));
+    EXPECT_FALSE(square.HitTest(20.0f, 15.0f));
+    EXPECT_TRUE(square.HitTest(19.9f, 19.9f));
+    square.Reset();
+    EXPECT_FALSE(square.HasIndex());
+    EXPECT_FALSE(square.HitTest(15.0f, 15.0f));
+
+    /* Hit testing the transformed path */
+    TransAffine transform;
+    transform.Translate(300.0f, 0.0f);
+    transform.Scale(2.0f, 2.0f);
+    DepictTransform<DepictCurve> transformed(curve, transform);
+    GeometryHitTest moved;
+    moved.AddPath(transformed);
+    float x = 100.0f;
+    float y = 115.0f;
+    transform.Transform(&x, &y);
+    EXPECT_TRUE(moved.HitTest(x, y));
+    EXPECT_FALSE(moved.HitTest(100.0f, 115.0f));
+}
+} // namespace OHOS
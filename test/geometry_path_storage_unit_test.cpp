@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+/* Several blocks and a partly filled last one. */
+const uint32_t VERTEX_NUM = VertexBlockStorage::BLOCK_SIZE * 3 + 17;
+const uint32_t SUBPATH_SIZE = 64;
+
+void BuildPath(UICanvasVertices& path, uint32_t num, float offset)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        float x = static_cast<float>(i) + offset;
+        float y = static_cast<float>(i % 7) - offset; // 7: zigzag
+        if (i % SUBPATH_SIZE == 0) {
+            path.MoveTo(x, y);
+        } else {
+            path.LineTo(x, y);
+        }
+    }
+}
+
+/* A sampled series as contiguous x, y pairs. */
+void FillSeries(float* coords, uint32_t num, float offset)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        coords[i * TWO_TIMES] = static_cast<float>(i) * 0.5f + offset;       // 0.5: sample step
+        coords[i * TWO_TIMES + 1] = static_cast<float>(i % 13) * 2.0f - offset; // 13, 2: sawtooth
+    }
+}
+
+/* Both paths return the same vertices. */
+void ExpectSamePath(UICanvasVertices& path, UICanvasVertices& expected)
+{
+    ASSERT_EQ(path.GetTotalVertices(), expected.GetTotalVertices());
+    path.Rewind(0);
+    expected.Rewind(0);
+    for (uint32_t i = 0; i < expected.GetTotalVertices(); i++) {
+        float x;
+        float y;
+        float expectedX;
+        float expectedY;
+        ASSERT_EQ(path.GenerateVertex(&x, &y), expected.GenerateVertex(&expectedX, &expectedY)) << "vertex " << i;
+        ASSERT_EQ(x, expectedX) << "vertex " << i;
+        ASSERT_EQ(y, expectedY) << "vertex " << i;
+    }
+}
+
+/* The path holds exactly the vertices BuildPath(num, offset) adds. */
+void ExpectPath(UICanvasVertices& path, uint32_t num, float offset)
+{
+    EXPECT_EQ(path.GetTotalVertices(), num);
+    path.Rewind(0);
+    float x;
+    float y;
+    for (uint32_t i = 0; i < num; i++) {
+        uint32_t cmd = path.GenerateVertex(&x, &y);
+        ASSERT_EQ(cmd, static_cast<uint32_t>((i % SUBPATH_SIZE == 0) ? PATH_CMD_MOVE_TO : PATH_CMD_LINE_TO));
+        ASSERT_EQ(x, static_cast<float>(i) + offset);
+        ASSERT_EQ(y, static_cast<float>(i % 7) - offset); // 7: zigzag
+    }
+    EXPECT_TRUE(IsStop(path.GenerateVertex(&x, &y)));
+}
+} // namespace
+
+class GeometryPathStorageTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: GeometryPathStorageCopy_001
+ * @tc.desc: Copies share the blocks, writing to either side leaves the other one unchanged.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryPathStorageTest, GeometryPathStorageCopy_001, TestSize.Level0)
+{
+    UICanvasVertices original;
+    BuildPath(original, VERTEX_NUM, 0.0f);
+    UICanvasVertices copy(original);
+    ExpectPath(copy, VERTEX_NUM, 0.0f);
+
+    /* Appending writes into the shared, partly filled last block. */
+    copy.LineTo(-1.0f, -1.0f);
+    ExpectPath(original, VERTEX_NUM, 0.0f);
+    EXPECT_EQ(copy.GetTotalVertices(), VERTEX_NUM + 1);
+    original.LineTo(-2.0f, -2.0f);
+    float x;
+    float y;
+    EXPECT_EQ(copy.LastVertex(&x, &y), static_cast<uint32_t>(PATH_CMD_LINE_TO));
+    EXPECT_EQ(x, -1.0f);
+    EXPECT_EQ(original.LastVertex(&x, &y), static_cast<uint32_t>(PATH_CMD_LINE_TO));
+    EXPECT_EQ(x, -2.0f);
+
+    /* Rebuilding the original overwrites every shared block. */
+    UICanvasVertices second;
+    second = copy;
+    original.RemoveAll();
+    BuildPath(original, VERTEX_NUM, 5.0f); // 5: other offset
+    ExpectPath(original, VERTEX_NUM, 5.0f); // 5: other offset
+    second.RemoveAll();
+    BuildPath(second, VERTEX_NUM, 9.0f); // 9: other offset
+    ExpectPath(second, VERTEX_NUM, 9.0f); // 9: other offset
+    copy.RemoveAll();
+    BuildPath(copy, VERTEX_NUM, 0.0f);
+    ExpectPath(copy, VERTEX_NUM, 0.0f);
+
+    UICanvasVertices& self = copy;
+    copy = self;
+    ExpectPath(copy, VERTEX_NUM, 0.0f);
+    UICanvasVertices empty;
+    copy = empty;
+    EXPECT_EQ(copy.GetTotalVertices(), 0u);
+    ExpectPath(original, VERTEX_NUM, 5.0f); // 5: other offset
+}
+
+/**
+ * @tc.name: GeometryPathStorageMove_001
+ * @tc.desc: Moving hands the blocks over and leaves an empty, usable path behind.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryPathStorageTest, GeometryPathStorageMove_001, TestSize.Level0)
+{
+    UICanvasVertices original;
+    BuildPath(original, VERTEX_NUM, 0.0f);
+    UICanvasVertices shared(original);
+    UICanvasVertices moved(std::move(original));
+    EXPECT_EQ(original.GetTotalVertices(), 0u);
+    ExpectPath(moved, VERTEX_NUM, 0.0f);
+
+    UICanvasVertices target;
+    BuildPath(target, SUBPATH_SIZE, 1.0f);
+    target = std::move(moved);
+    EXPECT_EQ(moved.GetTotalVertices(), 0u);
+    target.RemoveAll();
+    BuildPath(target, VERTEX_NUM, 3.0f); // 3: other offset
+    ExpectPath(target, VERTEX_NUM, 3.0f); // 3: other offset
+    ExpectPath(shared, VERTEX_NUM, 0.0f);
+
+    BuildPath(original, SUBPATH_SIZE, 2.0f); // 2: other offset
+    ExpectPath(original, SUBPATH_SIZE, 2.0f); // 2: other offset
+}
+
+/**
+ * @tc.name: GeometryPathStorageBulk_001
+ * @tc.desc: AddPolyline, AddPolygon and AddVertices add the same vertices as MoveTo and LineTo,
+ *           across block boundaries and into blocks shared with a copy.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryPathStorageTest, GeometryPathStorageBulk_001, TestSize.Level0)
+{
+    static float coords[VERTEX_NUM * TWO_TIMES];
+    FillSeries(coords, VERTEX_NUM, 1.0f);
+    const uint32_t polylineNum = VERTEX_NUM - 100; // 100: leave some points for the polygon
+
+    UICanvasVertices expected;
+    BuildPath(expected, SUBPATH_SIZE + 3, 0.0f); // 3: start the series inside a block
+    UICanvasVertices bulk(expected);
+    for (uint32_t i = 0; i < polylineNum; i++) {
+        if (i == 0) {
+            expected.MoveTo(coords[0], coords[1]);
+        } else {
+            expected.LineTo(coords[i * TWO_TIMES], coords[i * TWO_TIMES + 1]);
+        }
+    }
+    for (uint32_t i = polylineNum; i < VERTEX_NUM; i++) {
+        if (i == polylineNum) {
+            expected.MoveTo(coords[i * TWO_TIMES], coords[i * TWO_TIMES + 1]);
+        } else {
+            expected.LineTo(coords[i * TWO_TIMES], coords[i * TWO_TIMES + 1]);
+        }
+    }
+    expected.ClosePolygon();
+    expected.LineTo(coords[0], coords[1]);
+    expected.LineTo(coords[2], coords[3]); // 2, 3: second point
+
+    UICanvasVertices untouched(bulk);
+    bulk.Reserve(VERTEX_NUM);
+    bulk.AddPolyline(coords, polylineNum);
+    bulk.AddPolygon(coords + polylineNum * TWO_TIMES, VERTEX_NUM - polylineNum);
+    bulk.AddPolygon(coords, 0);
+    bulk.AddVertices(coords, 2, PATH_CMD_LINE_TO); // 2: two points
+    ExpectSamePath(bulk, expected);
+    ExpectPath(untouched, SUBPATH_SIZE + 3, 0.0f); // 3: start the series inside a block
+}
+} // namespace OHOS
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/vertexprimitive/geometry_vector_icon.h"
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/mem_api.h"
+
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t MAX_VERTICES = 4096;
+const char* const ICON_FILE = "geometry_vector_icon_unit_test.bin";
+
+/* An icon as the startup code replays it: lines, a cubic curve, an arc and two subpaths. */
+void BuildIcon(UICanvasVertices& path, float offset)
+{
+    path.MoveTo(4.0f + offset, 4.0f);
+    path.LineTo(40.0f + offset, 6.0f);
+    path.CubicBezierCurve(52.0f + offset, 20.0f, 44.0f + offset, 40.0f, 30.0f + offset, 44.0f);
+    path.ArcTo(12.0f, 12.0f, 0.0f, false, true, 8.0f + offset, 30.0f);
+    path.EndPoly(PATH_FLAGS_CLOSE);
+    path.MoveTo(18.0f + offset, 18.0f);
+    path.LineTo(28.0f + offset, 18.0f);
+    path.LineTo(23.0f + offset, 28.0f);
+    path.EndPoly(PATH_FLAGS_CLOSE);
+}
+
+template <class VertexSource>
+uint32_t ReadVertices(VertexSource& vs, PathVertex* vertices)
+{
+    uint32_t num = 0;
+    float x;
+    float y;
+    uint32_t cmd;
+    vs.Rewind(0);
+    while (!IsStop(cmd = vs.GenerateVertex(&x, &y)) && num < MAX_VERTICES) {
+        vertices[num].x = x;
+        vertices[num].y = y;
+        vertices[num].cmd = cmd;
+        num++;
+    }
+    return num;
+}
+
+/* Encodes the flattened icon into a UIMalloc buffer, which is 4 bytes aligned as Attach wants. */
+uint8_t* EncodeIcon(UICanvasVertices& path, VectorIconCoordFormat format, uint32_t& size)
+{
+    DepictCurve curve(path);
+    size = VectorIconWriter::Encode(curve, format, nullptr, 0);
+    uint8_t* buffer = static_cast<uint8_t*>(UIMalloc(size));
+    if (buffer != nullptr && VectorIconWriter::Encode(curve, format, buffer, size) != size) {
+        UIFree(buffer);
+        buffer = nullptr;
+    }
+    return buffer;
+}
+
+/* Sum of the covers of every scanline, equal sums of two rasterizations mean the same coverage here. */
+uint64_t SumCovers(RasterizerScanlineAntialias& ras)
+{
+    uint64_t sum = 0;
+    if (!ras.RewindScanlines()) {
+        return sum;
+    }
+    GeometryScanline sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        GeometryScanline::ConstIterator span = sl.Begin();
+        for (uint32_t n = sl.NumSpans(); n > 0; --n, ++span) {
+            for (int32_t i = 0; i < span->spanLength; i++) {
+                sum += span->covers[i];
+            }
+        }
+    }
+    return sum;
+}
+} // namespace
+
+class GeometryVectorIconTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: GeometryVectorIconFloat_001
+ * @tc.desc: A float icon replays exactly the vertices of the flattened path, one at a time and in blocks,
+ *           and carries the bounds of the path.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryVectorIconTest, GeometryVectorIconFloat_001, TestSize.Level0)
+{
+    static PathVertex expected[MAX_VERTICES];
+    static PathVertex actual[MAX_VERTICES];
+    UICanvasVertices path;
+    BuildIcon(path, 0.0f);
+    DepictCurve curve(path);
+    uint32_t expectedNum = ReadVertices(curve, expected);
+
+    uint32_t size = 0;
+    uint8_t* buffer = EncodeIcon(path, VECTOR_ICON_COORD_FLOAT, size);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(size, VectorIconSource::GetEncodedSize(expectedNum, VECTOR_ICON_COORD_FLOAT));
+    VectorIconSource icon(buffer, size);
+    ASSERT_TRUE(icon.IsValid());
+    EXPECT_EQ(icon.GetTotalVertices(), expectedNum);
+    EXPECT_EQ(ReadVertices(icon, actual), expectedNum);
+    for (uint32_t i = 0; i < expectedNum; i++) {
+        EXPECT_EQ(actual[i].cmd, expected[i].cmd) << "vertex " << i;
+        EXPECT_FLOAT_EQ(actual[i].x, expected[i].x) << "vertex " << i;
+        EXPECT_FLOAT_EQ(actual[i].y, expected[i].y) << "vertex " << i;
+    }
+
+    PathVertex block[7]; // 7: a block size which does not divide the vertex count
+    uint32_t idx = 0;
+    uint32_t num;
+    icon.Rewind(0);
+    while ((num = icon.GenerateVertices(block, 7)) > 0) { // 7: block size
+        for (uint32_t i = 0; i < num; i++, idx++) {
+            EXPECT_EQ(block[i].cmd, expected[idx].cmd) << "vertex " << idx;
+            EXPECT_FLOAT_EQ(block[i].x, expected[idx].x) << "vertex " << idx;
+        }
+    }
+    EXPECT_EQ(idx, expectedNum);
+
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    ASSERT_TRUE(icon.GetBounds(minX, minY, maxX, maxY));
+    for (uint32_t i = 0; i < expectedNum; i++) {
+        if (IsVertex(expected[i].cmd)) {
+            EXPECT_GE(expected[i].x, minX);
+            EXPECT_LE(expected[i].x, maxX);
+            EXPECT_GE(expected[i].y, minY);
+            EXPECT_LE(expected[i].y, maxY);
+        }
+    }
+    EXPECT_FLOAT_EQ(minX, 4.0f); // 4.0: first move to
+    EXPECT_FLOAT_EQ(minY, 4.0f); // 4.0: first move to
+    UIFree(buffer);
+}
+
+/**
+ * @tc.name: GeometryVectorIconQuantized_001
+ * @tc.desc: A quantized icon is smaller and every vertex is within half a grid step of the path.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryVectorIconTest, GeometryVectorIconQuantized_001, TestSize.Level0)
+{
+    static PathVertex expected[MAX_VERTICES];
+    static PathVertex actual[MAX_VERTICES];
+    UICanvasVertices path;
+    BuildIcon(path, 0.0f);
+    DepictCurve curve(path);
+    uint32_t expectedNum = ReadVertices(curve, expected);
+
+    uint32_t floatSize = 0;
+    uint8_t* floatBuffer = EncodeIcon(path, VECTOR_ICON_COORD_FLOAT, floatSize);
+    uint32_t size = 0;
+    uint8_t* buffer = EncodeIcon(path, VECTOR_ICON_COORD_UINT16, size);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_LT(size, floatSize);
+    VectorIconSource icon(buffer, size);
+    ASSERT_TRUE(icon.IsValid());
+    ASSERT_EQ(ReadVertices(icon, actual), expectedNum);
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    ASSERT_TRUE(icon.GetBounds(minX, minY, maxX, maxY));
+    float toleranceX = (maxX - minX) / 65535.0f; // 65535.0f: grid steps, half a step plus float rounding
+    float toleranceY = (maxY - minY) / 65535.0f; // 65535.0f: grid steps, half a step plus float rounding
+    for (uint32_t i = 0; i < expectedNum; i++) {
+        EXPECT_EQ(actual[i].cmd, expected[i].cmd) << "vertex " << i;
+        if (IsVertex(expected[i].cmd)) {
+            EXPECT_NEAR(actual[i].x, expected[i].x, toleranceX) << "vertex " << i;
+            EXPECT_NEAR(actual[i].y, expected[i].y, toleranceY) << "vertex " << i;
+        }
+    }
+    UIFree(buffer);
+    UIFree(floatBuffer);
+}
+
+/**
+ * @tc.name: GeometryVectorIconAttach_001
+ * @tc.desc: Truncated, foreign and misaligned data is rejected, Encode refuses a small buffer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryVectorIconTest, GeometryVectorIconAttach_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildIcon(path, 0.0f);
+    uint32_t size = 0;
+    uint8_t* buffer = EncodeIcon(path, VECTOR_ICON_COORD_FLOAT, size);
+    ASSERT_NE(buffer, nullptr);
+
+    VectorIconSource icon;
+    EXPECT_FALSE(icon.Attach(nullptr, size));
+    EXPECT_FALSE(icon.Attach(buffer, size - 1));
+    EXPECT_FALSE(icon.Attach(buffer, sizeof(VectorIconHeader) - 1));
+    EXPECT_EQ(icon.GetTotalVertices(), 0u);
+    float x;
+    float y;
+    EXPECT_TRUE(IsStop(icon.GenerateVertex(&x, &y)));
+
+    uint8_t* copy = static_cast<uint8_t*>(UIMalloc(size + 1));
+    ASSERT_NE(copy, nullptr);
+    for (uint32_t i = 0; i < size; i++) {
+        copy[i + 1] = buffer[i];
+    }
+    EXPECT_FALSE(icon.Attach(copy + 1, size));
+    UIFree(copy);
+
+    buffer[0] ^= 0xFF; // 0xFF: break the magic
+    EXPECT_FALSE(icon.Attach(buffer, size));
+    buffer[0] ^= 0xFF; // 0xFF: restore the magic
+    EXPECT_TRUE(icon.Attach(buffer, size));
+
+    DepictCurve curve(path);
+    EXPECT_EQ(VectorIconWriter::Encode(curve, VECTOR_ICON_COORD_FLOAT, buffer, size - 1), 0u);
+    UIFree(buffer);
+}
+
+/**
+ * @tc.name: GeometryVectorIconFile_001
+ * @tc.desc: An icon written to a file and mapped again rasterizes to the same coverage as the path.
+ * @tc.type: FUNC
+ */
+HWTEST_F(GeometryVectorIconTest, GeometryVectorIconFile_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildIcon(path, 0.5f); // 0.5: off the pixel grid
+    ASSERT_TRUE(VectorIconWriter::WriteFile(path, ICON_FILE));
+    VectorIconFile file;
+    ASSERT_TRUE(file.Open(ICON_FILE));
+    VectorIconSource icon(file.GetData(), file.GetSize());
+    ASSERT_TRUE(icon.IsValid());
+
+    RasterizerScanlineAntialias ras;
+    DepictCurve curve(path);
+    ras.AddPath(curve);
+    uint64_t expected = SumCovers(ras);
+    int32_t minY = ras.GetMinY();
+    int32_t maxY = ras.GetMaxY();
+    ras.Reset();
+    ras.AddPath(icon);
+    EXPECT_EQ(SumCovers(ras), expected);
+    EXPECT_EQ(ras.GetMinY(), minY);
+    EXPECT_EQ(ras.GetMaxY(), maxY);
+
+    file.Close();
+    EXPECT_EQ(file.GetData(), nullptr);
+    EXPECT_FALSE(file.Open("geometry_vector_icon_unit_test.none"));
+    remove(ICON_FILE);
+}
+} // namespace OHOS
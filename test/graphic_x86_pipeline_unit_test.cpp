@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graphic_blend_reference.h"
+#include "graphic_x86_pipeline.h"
+
+#include <climits>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include "securec.h"
+
+using namespace testing::ext;
+namespace OHOS {
+#ifdef X86_SIMD_OPT
+namespace {
+const int16_t PIXELS = 8;
+const int16_t ARGB_BYTES = 4;
+const int32_t LOOP_TIMES = 1000;
+
+void FillRandom(uint8_t* buf, int32_t size)
+{
+    for (int32_t i = 0; i < size; i++) {
+        buf[i] = static_cast<uint8_t>(rand() & UCHAR_MAX);
+    }
+}
+
+/* Lanes of value, value + 1, ... value + 7 */
+__m128i X86Ramp(int32_t value)
+{
+    uint16_t lanes[PIXELS];
+    for (int32_t i = 0; i < PIXELS; i++) {
+        lanes[i] = static_cast<uint16_t>(value + i);
+    }
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+}
+
+/* Counts the lanes of a Rgba8T::Lerp kernel that differ from the scalar one, for every p, q and alpha. */
+template <class Lerp>
+uint32_t CountLerpErrors(Lerp lerp)
+{
+    uint32_t errors = 0;
+    for (int32_t p = 0; p <= UCHAR_MAX; p++) {
+        for (int32_t q = 0; q <= UCHAR_MAX; q++) {
+            for (int32_t alpha = 0; alpha <= UCHAR_MAX; alpha += PIXELS) {
+                uint16_t result[PIXELS];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(result), lerp(X86Dup(p), X86Dup(q), X86Ramp(alpha)));
+                for (int32_t i = 0; i < PIXELS; i++) {
+                    errors += (result[i] != Rgba8T::Lerp(p, q, alpha + i)) ? 1 : 0;
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+/* Counts the lanes of a division kernel that differ from min(a / max(b, 1), 255), for every a and b. */
+template <class DivInt>
+uint32_t CountDivIntErrors(DivInt divInt)
+{
+    uint32_t errors = 0;
+    for (int32_t a = 0; a <= USHRT_MAX; a++) {
+        for (int32_t b = 0; b <= UCHAR_MAX; b += PIXELS) {
+            uint16_t result[PIXELS];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result),
+                             divInt(_mm_set1_epi16(static_cast<int16_t>(a)), X86Ramp(b)));
+            for (int32_t i = 0; i < PIXELS; i++) {
+                errors += (result[i] != MATH_MIN(a / MATH_MAX(b + i, 1), UCHAR_MAX)) ? 1 : 0;
+            }
+        }
+    }
+    return errors;
+}
+} // namespace
+
+class X86PipelineTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        srand(0);
+    }
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: X86PipelineLerp_001
+ * @tc.desc: Verify NeonLerpARGB8888 and NeonPrelerpARGB8888 are bit-exact with the scalar reference.
+ * @tc.type: FUNC
+ */
+HWTEST_F(X86PipelineTest, X86PipelineLerp_001, TestSize.Level0)
+{
+    X86BlendPipeLine simd;
+    ScalarBlendPipeLine scalar;
+    uint8_t src[PIXELS * ARGB_BYTES];
+    uint8_t covers[PIXELS];
+    uint8_t color[ARGB_BYTES];
+    for (int32_t loop = 0; loop < LOOP_TIMES; loop++) {
+        uint8_t dst1[PIXELS * ARGB_BYTES];
+        uint8_t dst2[PIXELS * ARGB_BYTES];
+        FillRandom(dst1, sizeof(dst1));
+        FillRandom(src, sizeof(src));
+        FillRandom(covers, sizeof(covers));
+        FillRandom(color, sizeof(color));
+        memcpy_s(dst2, sizeof(dst2), dst1, sizeof(dst1));
+
+        simd.NeonLerpARGB8888(dst1, color[0], color[1], color[2], color[3], covers);
+        scalar.NeonLerpARGB8888(dst2, color[0], color[1], color[2], color[3], covers);
+        simd.NeonLerpARGB8888(dst1, src, covers[0]);
+        scalar.NeonLerpARGB8888(dst2, src, covers[0]);
+        simd.NeonPrelerpARGB8888(dst1, color[0], color[1], color[2], color[3], covers[1]);
+        scalar.NeonPrelerpARGB8888(dst2, color[0], color[1], color[2], color[3], covers[1]);
+        simd.NeonPrelerpARGB8888(dst1, src, covers);
+        scalar.NeonPrelerpARGB8888(dst2, src, covers);
+        EXPECT_EQ(memcmp(dst1, dst2, sizeof(dst1)), 0);
+    }
+}
+
+/**
+ * @tc.name: X86PipelineKernel_001
+ * @tc.desc: Verify the SSE2 kernels and, where the cpu has it, the AVX2 kernels are exact for every input.
+ * @tc.type: FUNC
+ */
+HWTEST_F(X86PipelineTest, X86PipelineKernel_001, TestSize.Level0)
+{
+    EXPECT_EQ(CountLerpErrors(X86Lerp), 0U);
+    EXPECT_EQ(CountDivIntErrors(X86DivInt), 0U);
+    if (X86HasAvx2()) {
+        EXPECT_EQ(CountLerpErrors(X86LerpAvx2), 0U);
+        EXPECT_EQ(CountDivIntErrors(X86DivIntAvx2), 0U);
+    }
+}
+
+/**
+ * @tc.name: X86PipelineInvoke_001
+ * @tc.desc: Verify Invoke of every destination and source mode is bit-exact with the scalar reference.
+ * @tc.type: FUNC
+ */
+HWTEST_F(X86PipelineTest, X86PipelineInvoke_001, TestSize.Level0)
+{
+    const ColorMode modes[] = {ARGB8888, RGB888, RGB565};
+    for (ColorMode dm : modes) {
+        for (ColorMode sm : modes) {
+            X86BlendPipeLine simd;
+            ScalarBlendPipeLine scalar;
+            simd.Construct(dm, sm);
+            scalar.Construct(dm, sm);
+            for (int32_t loop = 0; loop < LOOP_TIMES; loop++) {
+                uint8_t dst1[PIXELS * ARGB_BYTES];
+                uint8_t dst2[PIXELS * ARGB_BYTES];
+                uint8_t src[PIXELS * ARGB_BYTES];
+                uint8_t opa = static_cast<uint8_t>(rand() & UCHAR_MAX);
+                FillRandom(dst1, sizeof(dst1));
+                FillRandom(src, sizeof(src));
+                memcpy_s(dst2, sizeof(dst2), dst1, sizeof(dst1));
+
+                simd.Invoke(dst1, src, opa);
+                scalar.Invoke(dst2, src, opa);
+                EXPECT_EQ(memcmp(dst1, dst2, sizeof(dst1)), 0);
+            }
+        }
+    }
+}
+#endif
+} // namespace OHOS
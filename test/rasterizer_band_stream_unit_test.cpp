@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+#include <gtest/gtest.h>
+
+#include "rasterizer_test_utils.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t BAND_HEIGHTS[] = {1, 7, 32, 100000};
+const uint32_t SMALL_BLOCK_LIMIT = 1;
+} // namespace
+
+class RasterizerBandStreamTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerBandStream_001
+ * @tc.desc: Verify band streaming sweeps the same scanlines as building all cells at once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerBandStreamTest, RasterizerBandStream_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias whole;
+    AddTestStar(whole);
+    uint64_t expect = HashScanlines(whole);
+    int32_t rows = whole.GetMaxY() - whole.GetMinY() + 1;
+    EXPECT_EQ(whole.GetStreamBandCount(), 0U);
+
+    for (int32_t bandHeight : BAND_HEIGHTS) {
+        RasterizerScanlineAntialias stream;
+        stream.SetStreamBandHeight(bandHeight);
+        AddTestStar(stream);
+        EXPECT_EQ(HashScanlines(stream), expect);
+        EXPECT_EQ(stream.GetStreamBandCount(), static_cast<uint32_t>((rows + bandHeight - 1) / bandHeight));
+        /* The recorded outline can be swept again. */
+        EXPECT_EQ(HashScanlines(stream), expect);
+    }
+}
+
+/**
+ * @tc.name: RasterizerBandStream_002
+ * @tc.desc: Verify bands are split instead of dropping cells when the cell block limit is reached.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerBandStreamTest, RasterizerBandStream_002, TestSize.Level0)
+{
+    RasterizerScanlineAntialias whole;
+    AddTestStar(whole);
+    uint64_t expect = HashScanlines(whole);
+
+    RasterizerScanlineAntialias truncated(SMALL_BLOCK_LIMIT);
+    AddTestStar(truncated);
+    EXPECT_NE(HashScanlines(truncated), expect);
+
+    RasterizerScanlineAntialias stream(SMALL_BLOCK_LIMIT);
+    stream.SetStreamBandHeight(BAND_HEIGHTS[3]);
+    AddTestStar(stream);
+    EXPECT_EQ(HashScanlines(stream), expect);
+    EXPECT_GT(stream.GetStreamBandCount(), 1U);
+    EXPECT_LT(stream.GetCellMemoryUsage(), whole.GetCellMemoryUsage());
+}
+} // namespace OHOS
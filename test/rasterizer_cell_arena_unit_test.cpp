@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_cell_arena.h"
+
+#include <gtest/gtest.h>
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "rasterizer_test_utils.h"
+#include "securec.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t BLOCK_NUM = 20;
+const uint32_t BUFFER_SIZE = 1000;
+const int32_t SHAPE_NUM = 2;
+} // namespace
+
+class RasterizerCellArenaTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerCellArenaBlock_001
+ * @tc.desc: Verify blocks are counted, reused after being freed and the chunks grow geometrically.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellArenaTest, RasterizerCellArenaBlock_001, TestSize.Level0)
+{
+    RasterizerCellArena arena;
+    void* blocks[BLOCK_NUM];
+    for (uint32_t i = 0; i < BLOCK_NUM; i++) {
+        blocks[i] = arena.AllocateBlock();
+        ASSERT_NE(blocks[i], nullptr);
+        memset_s(blocks[i], CELL_ARENA_BLOCK_BYTES, i, CELL_ARENA_BLOCK_BYTES);
+    }
+    EXPECT_EQ(arena.GetBlocksInUse(), BLOCK_NUM);
+    EXPECT_EQ(arena.GetBlocksHighWater(), BLOCK_NUM);
+    // chunks of 1, 2, 4, 8 and 16 blocks
+    EXPECT_EQ(arena.GetBlocksAllocated(), 31u); // 31: 1 + 2 + 4 + 8 + 16
+    for (uint32_t i = 0; i < BLOCK_NUM; i++) {
+        for (uint32_t k = i + 1; k < BLOCK_NUM; k++) {
+            EXPECT_NE(blocks[i], blocks[k]);
+        }
+        EXPECT_EQ(static_cast<uint8_t*>(blocks[i])[CELL_ARENA_BLOCK_BYTES - 1], i);
+    }
+
+    arena.FreeBlock(blocks[3]); // 3: any block
+    EXPECT_EQ(arena.GetBlocksInUse(), BLOCK_NUM - 1);
+    EXPECT_EQ(arena.AllocateBlock(), blocks[3]); // 3: the freed block is handed out again
+    for (uint32_t i = 0; i < BLOCK_NUM; i++) {
+        arena.FreeBlock(blocks[i]);
+    }
+    EXPECT_EQ(arena.GetBlocksInUse(), 0u);
+    EXPECT_EQ(arena.GetBlocksHighWater(), BLOCK_NUM);
+    arena.ResetHighWater();
+    EXPECT_EQ(arena.GetBlocksHighWater(), 0u);
+    EXPECT_EQ(arena.GetBlocksAllocated(), 31u); // 31: freed blocks stay in the arena
+}
+
+/**
+ * @tc.name: RasterizerCellArenaReserve_001
+ * @tc.desc: Verify Reserve makes the blocks available up front and is not repeated for reserved blocks.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellArenaTest, RasterizerCellArenaReserve_001, TestSize.Level0)
+{
+    RasterizerCellArena arena;
+    arena.Reserve(BLOCK_NUM);
+    EXPECT_EQ(arena.GetBlocksAllocated(), BLOCK_NUM);
+    EXPECT_EQ(arena.GetBlocksInUse(), 0u);
+    arena.Reserve(BLOCK_NUM / 2); // 2: fewer blocks than reserved
+    EXPECT_EQ(arena.GetBlocksAllocated(), BLOCK_NUM);
+
+    void* blocks[BLOCK_NUM];
+    for (uint32_t i = 0; i < BLOCK_NUM; i++) {
+        blocks[i] = arena.AllocateBlock();
+        ASSERT_NE(blocks[i], nullptr);
+    }
+    EXPECT_EQ(arena.GetBlocksAllocated(), BLOCK_NUM);
+    for (uint32_t i = 0; i < BLOCK_NUM; i++) {
+        arena.FreeBlock(blocks[i]);
+    }
+}
+
+/**
+ * @tc.name: RasterizerCellArenaBuffer_001
+ * @tc.desc: Verify buffers grow by one half, released buffers are reused and the bytes are counted.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellArenaTest, RasterizerCellArenaBuffer_001, TestSize.Level0)
+{
+    RasterizerCellArena arena;
+    uint32_t capacity = 0;
+    void* buffer = arena.AllocateBuffer(BUFFER_SIZE, capacity);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(capacity, BUFFER_SIZE + BUFFER_SIZE / 2); // 2: grow by one half
+    EXPECT_EQ(arena.GetBufferBytesInUse(), capacity);
+
+    uint32_t capacity2 = 0;
+    void* buffer2 = arena.AllocateBuffer(BUFFER_SIZE, capacity2);
+    ASSERT_NE(buffer2, nullptr);
+    EXPECT_NE(buffer2, buffer);
+    EXPECT_EQ(arena.GetBufferBytesHighWater(), capacity + capacity2);
+
+    arena.FreeBuffer(buffer, capacity);
+    arena.FreeBuffer(buffer2, capacity2);
+    EXPECT_EQ(arena.GetBufferBytesInUse(), 0u);
+    uint32_t reusedCapacity = 0;
+    void* reused = arena.AllocateBuffer(BUFFER_SIZE + BUFFER_SIZE / 4, reusedCapacity); // 4: fits a cached buffer
+    EXPECT_TRUE(reused == buffer || reused == buffer2);
+    EXPECT_EQ(reusedCapacity, capacity);
+    EXPECT_EQ(arena.GetBufferBytesHighWater(), capacity + capacity2);
+    arena.FreeBuffer(reused, reusedCapacity);
+
+    uint32_t largeCapacity = 0;
+    void* large = arena.AllocateBuffer(capacity + 1, largeCapacity);
+    ASSERT_NE(large, nullptr);
+    EXPECT_NE(large, buffer);
+    EXPECT_NE(large, buffer2);
+    arena.FreeBuffer(large, largeCapacity);
+}
+
+/**
+ * @tc.name: RasterizerCellArenaShare_001
+ * @tc.desc: Verify rasterizers sharing an arena render like a private arena, hand their memory back
+ *           when destroyed and do not grow the arena in later frames.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellArenaTest, RasterizerCellArenaShare_001, TestSize.Level0)
+{
+    uint64_t expect[SHAPE_NUM];
+    for (int32_t shape = 0; shape < SHAPE_NUM; shape++) {
+        RasterizerScanlineAntialias ras;
+        AddTestStar(ras, shape + 1);
+        expect[shape] = HashScanlines(ras);
+    }
+
+    RasterizerCellArena arena;
+    uint32_t blocksAllocated = 0;
+    for (int32_t frame = 0; frame < 3; frame++) { // 3: frames
+        {
+            RasterizerScanlineAntialias ras1;
+            RasterizerScanlineAntialias ras2;
+            ras1.SetCellArena(&arena);
+            ras2.SetCellArena(&arena);
+            AddTestStar(ras1, 1);
+            AddTestStar(ras2, 2); // 2: the second shape
+            EXPECT_GT(arena.GetBlocksInUse(), 1u);
+            EXPECT_EQ(HashScanlines(ras1), expect[0]) << "frame " << frame;
+            EXPECT_EQ(HashScanlines(ras2), expect[1]) << "frame " << frame;
+        }
+        EXPECT_EQ(arena.GetBlocksInUse(), 0u);
+        EXPECT_EQ(arena.GetBufferBytesInUse(), 0u);
+        if (frame == 0) {
+            blocksAllocated = arena.GetBlocksAllocated();
+            EXPECT_GE(arena.GetBlocksHighWater(), 2u); // 2: both rasterizers held blocks at once
+        } else {
+            EXPECT_EQ(arena.GetBlocksAllocated(), blocksAllocated) << "frame " << frame;
+        }
+    }
+}
+} // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+#include <gtest/gtest.h>
+
+#include "rasterizer_test_utils.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const float FAR_X = 40000.0f;
+const int32_t WIGGLE_LOOPS = 3000;
+
+/* Two triangles 40000 pixels apart, beyond the int16 offsets of the compact layout. */
+void AddFarTriangles(RasterizerScanlineAntialias& ras)
+{
+    const float offsets[] = {0.0f, FAR_X};
+    for (float offset : offsets) {
+        ras.MoveToByfloat(offset + 10.5f, 10.0f);
+        ras.LineToByfloat(offset + 60.0f, 80.3f);
+        ras.LineToByfloat(offset + 5.2f, 70.7f);
+        ras.ClosePolygon();
+    }
+}
+
+/* Thousands of loops inside one pixel, the area of the cell exceeds the compact range. */
+void AddWiggle(RasterizerScanlineAntialias& ras)
+{
+    ras.MoveToByfloat(10.1f, 10.1f);
+    for (int32_t i = 0; i < WIGGLE_LOOPS; i++) {
+        ras.LineToByfloat(10.9f, 10.1f);
+        ras.LineToByfloat(10.9f, 10.9f);
+        ras.LineToByfloat(10.1f, 10.9f);
+        ras.LineToByfloat(10.1f, 10.1f);
+    }
+    ras.LineToByfloat(30.0f, 40.0f);
+    ras.LineToByfloat(12.0f, 40.0f);
+}
+} // namespace
+
+class RasterizerCellsLayoutTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerCellsLayout_001
+ * @tc.desc: Verify the compact cell layout sweeps the same scanlines as the wide layout.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellsLayoutTest, RasterizerCellsLayout_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias wide;
+    RasterizerScanlineAntialias compact;
+    compact.SetCellLayout(CELL_LAYOUT_COMPACT);
+    AddTestStar(wide);
+    AddTestStar(compact);
+    EXPECT_EQ(HashScanlines(wide), HashScanlines(compact));
+    EXPECT_EQ(compact.GetCellLayout(), CELL_LAYOUT_COMPACT);
+    EXPECT_LT(compact.GetCellMemoryUsage(), wide.GetCellMemoryUsage());
+
+    wide.Reset();
+    compact.Reset();
+    AddWiggle(wide);
+    AddWiggle(compact);
+    EXPECT_EQ(HashScanlines(wide), HashScanlines(compact));
+}
+
+/**
+ * @tc.name: RasterizerCellsLayout_002
+ * @tc.desc: Verify the compact layout falls back to wide cells when the outline exceeds the int16 range.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellsLayoutTest, RasterizerCellsLayout_002, TestSize.Level0)
+{
+    RasterizerScanlineAntialias wide;
+    RasterizerScanlineAntialias compact;
+    compact.SetCellLayout(CELL_LAYOUT_COMPACT);
+    AddFarTriangles(wide);
+    AddFarTriangles(compact);
+    EXPECT_EQ(HashScanlines(wide), HashScanlines(compact));
+    EXPECT_EQ(compact.GetCellLayout(), CELL_LAYOUT_WIDE);
+
+    compact.Reset();
+    EXPECT_EQ(compact.GetCellLayout(), CELL_LAYOUT_COMPACT);
+}
+} // namespace OHOS
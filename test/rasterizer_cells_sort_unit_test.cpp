@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_cells_antialias.h"
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t ROW_CELLS[] = {8, 32, 96, 256, 1024, 4096};
+const int32_t ROW_WIDTHS[] = {200, 3000, 70000};
+const int32_t START_X = -100;
+const uint32_t PRIME_STRIDE = 7919;
+
+void FillRow(CellBuildAntiAlias* cells, CellBuildAntiAlias** row1, CellBuildAntiAlias** row2,
+             uint32_t num, int32_t width)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        cells[i].x = START_X + rand() % width;
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        row1[i] = &cells[(static_cast<uint64_t>(i) * PRIME_STRIDE) % num];
+        row2[i] = row1[i];
+    }
+}
+} // namespace
+
+class RasterizerCellsSortTest : public testing::Test {
+public:
+    static void SetUpTestCase(void)
+    {
+        srand(0);
+    }
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RadixSortCells_001
+ * @tc.desc: Verify RadixSortCells orders the row like QsortCells at every cell density.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCellsSortTest, RadixSortCells_001, TestSize.Level0)
+{
+    for (int32_t width : ROW_WIDTHS) {
+        for (uint32_t num : ROW_CELLS) {
+            CellBuildAntiAlias* cells = new CellBuildAntiAlias[num];
+            CellBuildAntiAlias** row1 = new CellBuildAntiAlias*[num];
+            CellBuildAntiAlias** row2 = new CellBuildAntiAlias*[num];
+            CellBuildAntiAlias** cellBuffer = new CellBuildAntiAlias*[num];
+            uint32_t* keyBuffer = new uint32_t[num * 2]; // 2: source and destination keys
+            FillRow(cells, row1, row2, num, width);
+            QsortCells(row1, num);
+            RadixSortCells(row2, num, cellBuffer, keyBuffer);
+            for (uint32_t i = 0; i < num; i++) {
+                EXPECT_EQ(row1[i]->x, row2[i]->x);
+                if (i > 0) {
+                    EXPECT_LE(row2[i - 1]->x, row2[i]->x);
+                }
+            }
+            delete[] cells;
+            delete[] row1;
+            delete[] row2;
+            delete[] cellBuffer;
+            delete[] keyBuffer;
+        }
+    }
+}
+} // namespace OHOS
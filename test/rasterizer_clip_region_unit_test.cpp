@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 240;
+const int32_t IMAGE_HEIGHT = 200;
+const int32_t SHAPE_POINTS = 40;
+
+/* Visible parts of a window under two others: overlapping, touching and empty rectangles. */
+const Rect VISIBLE_RECTS[] = {
+    Rect(10, 10, 229, 59),
+    Rect(10, 60, 89, 189),
+    Rect(150, 60, 229, 119),
+    Rect(60, 100, 199, 149),
+    Rect(150, 150, 229, 189),
+    Rect(90, 150, 149, 150),
+    Rect(30, 30, 20, 40),
+};
+const uint32_t VISIBLE_RECT_NUM = sizeof(VISIBLE_RECTS) / sizeof(VISIBLE_RECTS[0]);
+
+void AddShape(RasterizerScanlineAntialias& ras, int32_t points = SHAPE_POINTS)
+{
+    for (int32_t i = 0; i < points; i++) {
+        float angle = i * 2 * UI_PI / points;             // 2: full turn
+        float r = (i % 2 == 0) ? 110.0f : 70.0f;          // 2, 110, 70: star radii
+        float x = 120.3f + r * std::cos(angle);           // 120.3: center
+        float y = 100.6f + r * std::sin(angle) * 0.9f;    // 100.6, 0.9: center and squeeze
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+bool InRegion(int32_t x, int32_t y)
+{
+    for (uint32_t i = 0; i < VISIBLE_RECT_NUM; i++) {
+        const Rect& rect = VISIBLE_RECTS[i];
+        if (x >= rect.GetLeft() && x <= rect.GetRight() && y >= rect.GetTop() && y <= rect.GetBottom()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SweepCovers(RasterizerScanlineAntialias& ras, uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH])
+{
+    for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+            covers[y][x] = 0;
+        }
+    }
+    GeometryScanline sl;
+    if (!ras.RewindScanlines()) {
+        return;
+    }
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        GeometryScanline::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            for (int32_t k = 0; k < span->spanLength; k++) {
+                EXPECT_EQ(covers[sl.GetYLevel()][span->x + k], 0); // spans never overlap
+                covers[sl.GetYLevel()][span->x + k] = span->covers[k];
+            }
+        }
+    }
+}
+} // namespace
+
+class RasterizerClipRegionTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerClipRegion_001
+ * @tc.desc: Verify a path clipped to a region matches the unclipped covers inside the rectangles, for both cell
+ *           layouts, and that rows with the same intervals share a band.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegion_001, TestSize.Level0)
+{
+    static uint8_t expect[IMAGE_HEIGHT][IMAGE_WIDTH];
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    const CellLayout layouts[] = {CELL_LAYOUT_WIDE, CELL_LAYOUT_COMPACT};
+    for (CellLayout layout : layouts) {
+        RasterizerScanlineAntialias ras;
+        ras.SetCellLayout(layout);
+        AddShape(ras);
+        SweepCovers(ras, expect);
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+                expect[y][x] = InRegion(x, y) ? expect[y][x] : 0;
+            }
+        }
+        ras.ClipRegion(VISIBLE_RECTS, VISIBLE_RECT_NUM);
+        AddShape(ras);
+        SweepCovers(ras, covers);
+        /* Edges cut at the bounding box of the region may round by one cover */
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+                if (expect[y][x] == 0) {
+                    ASSERT_EQ(covers[y][x], 0) << x << "," << y;
+                } else {
+                    ASSERT_LE(std::abs(covers[y][x] - expect[y][x]), 1) << x << "," << y;
+                }
+            }
+        }
+    }
+
+    RasterizerScanlineClip clip;
+    clip.ClipRegion(VISIBLE_RECTS, VISIBLE_RECT_NUM);
+    EXPECT_EQ(clip.GetRegionBandNum(), 6U); // 6: rows 10, 60, 100, 120, 150, 151 start a new band
+    EXPECT_EQ(clip.FindRegionBand(9), nullptr);
+    EXPECT_EQ(clip.FindRegionBand(190), nullptr);
+    const ClipRegionBand* band = clip.FindRegionBand(130);
+    ASSERT_NE(band, nullptr);
+    EXPECT_EQ(band->top, 120);    // 120: below the right rectangle
+    EXPECT_EQ(band->bottom, 150); // 150: above the bottom rectangles
+    ASSERT_EQ(band->spanNum, 1U);
+    EXPECT_EQ(clip.GetRegionSpans(*band)[0].left, 10);   // 10: left rectangle joins the middle one
+    EXPECT_EQ(clip.GetRegionSpans(*band)[0].right, 200); // 200: right of the middle rectangle
+    band = clip.FindRegionBand(150);
+    ASSERT_NE(band, nullptr);
+    ASSERT_EQ(band->spanNum, 1U); // touching rectangles merge into one interval
+    EXPECT_EQ(clip.GetRegionSpans(*band)[0].right, 230); // 230: right of the right rectangles
+    band = clip.FindRegionBand(160);
+    ASSERT_NE(band, nullptr);
+    EXPECT_EQ(band->spanNum, 2U); // 2: left and right rectangles
+}
+
+/**
+ * @tc.name: RasterizerClipRegion_002
+ * @tc.desc: Verify an empty region clips everything and ClipBox or ResetClipping drop the region.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegion_002, TestSize.Level0)
+{
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    RasterizerScanlineAntialias ras;
+    ras.ClipRegion(nullptr, 0);
+    AddShape(ras);
+    GeometryScanline sl;
+    if (ras.RewindScanlines()) {
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        EXPECT_FALSE(ras.SweepScanline(sl));
+    }
+
+    ras.ClipRegion(VISIBLE_RECTS, VISIBLE_RECT_NUM);
+    ras.ClipBox(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+    AddShape(ras);
+    SweepCovers(ras, covers);
+    EXPECT_NE(covers[100][120], 0); // 100, 120: center of the star is hidden by the region only
+
+    ras.ClipRegion(VISIBLE_RECTS, VISIBLE_RECT_NUM);
+    ras.ResetClipping();
+    AddShape(ras);
+    SweepCovers(ras, covers);
+    EXPECT_NE(covers[100][120], 0); // 100, 120: center of the star
+}
+
+/**
+ * @tc.name: RasterizerClipRegion_003
+ * @tc.desc: Verify a region of many small rectangles keeps one band per row of cells with its merged intervals,
+ *           and a smaller region set afterwards replaces it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerClipRegionTest, RasterizerClipRegion_003, TestSize.Level0)
+{
+    const int32_t cells = 16;
+    const int32_t cellSize = 4;
+    Rect board[cells * cells / 2]; // 2: every second cell of the checkerboard
+    uint32_t rectNum = 0;
+    for (int32_t row = 0; row < cells; row++) {
+        for (int32_t col = row % 2; col < cells; col += 2) { // 2: every second cell
+            board[rectNum++] = Rect(col * cellSize, row * cellSize, (col + 1) * cellSize - 1,
+                                    (row + 1) * cellSize - 1);
+        }
+    }
+    RasterizerScanlineClip clip;
+    clip.ClipRegion(board, rectNum);
+    ASSERT_EQ(clip.GetRegionBandNum(), static_cast<uint32_t>(cells));
+    for (int32_t row = 0; row < cells; row++) {
+        const ClipRegionBand* band = clip.FindRegionBand(row * cellSize + 1);
+        ASSERT_NE(band, nullptr);
+        EXPECT_EQ(band->top, row * cellSize);
+        EXPECT_EQ(band->bottom, (row + 1) * cellSize);
+        ASSERT_EQ(band->spanNum, static_cast<uint32_t>(cells / 2)); // 2: every second cell
+        const ClipRegionSpan* spans = clip.GetRegionSpans(*band);
+        for (uint32_t i = 0; i < band->spanNum; i++) {
+            EXPECT_EQ(spans[i].left, static_cast<int32_t>(i * 2 + row % 2) * cellSize); // 2: every second cell
+            EXPECT_EQ(spans[i].right, spans[i].left + cellSize);
+        }
+    }
+    EXPECT_EQ(clip.FindRegionBand(cells * cellSize), nullptr);
+
+    clip.ClipRegion(VISIBLE_RECTS, VISIBLE_RECT_NUM);
+    EXPECT_EQ(clip.GetRegionBandNum(), 6U); // 6: bands of the visible rectangles
+    const ClipRegionBand* band = clip.FindRegionBand(160);
+    ASSERT_NE(band, nullptr);
+    EXPECT_EQ(band->spanNum, 2U); // 2: left and right rectangles
+}
+} // namespace OHOS
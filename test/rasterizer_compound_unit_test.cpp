@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_compound_antialias.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+#include "gfx_utils/color.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+#include "rasterizer_test_utils.h"
+
+using namespace testing::ext;
+namespace OHOS {
+#if GRAPHIC_ENABLE_COMPOUND_RASTERIZER_FLAG
+namespace {
+const uint32_t SHAPE_NUM = 12;
+const uint32_t SHAPES_PER_ROW = 4;
+const int32_t SHAPE_POINTS = 40;
+const int32_t STAR_POINTS = 5;
+const int32_t IMAGE_SIZE = 128;
+
+struct Shape {
+    float x;
+    float y;
+    float radius;
+};
+
+/* SHAPE_NUM growing shapes on a 4 x 3 grid, closer than their radii so that they overlap */
+Shape GetShape(uint32_t index)
+{
+    Shape shape;
+    shape.x = 40.0f + (index % SHAPES_PER_ROW) * 23.3f;                   // 23.3: distance
+    shape.y = 40.0f + (index / SHAPES_PER_ROW) * 21.7f + (index % 3) * 5; // 21.7: distance, 3: jitter of 5
+    shape.radius = 30.0f + index * 4;                                     // 4: growth per shape
+    return shape;
+}
+
+template <class Rasterizer>
+void AddShape(Rasterizer& ras, const Shape& shape)
+{
+    for (int32_t i = 0; i < SHAPE_POINTS; i++) {
+        float angle = i * 2 * UI_PI / SHAPE_POINTS; // 2: full turn
+        float radius = shape.radius * ((i % 2 == 0) ? 1.0f : 0.8f); // 2, 0.8: rippled outline
+        float x = shape.x + radius * std::cos(angle);
+        float y = shape.y + radius * std::sin(angle);
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+/* A self-intersecting five-pointed star, its center is a hole with the even-odd rule. */
+template <class Rasterizer>
+void AddStar(Rasterizer& ras)
+{
+    for (int32_t i = 0; i < STAR_POINTS; i++) {
+        float angle = i * 4 * UI_PI / STAR_POINTS; // 4: every second point
+        float x = 100.3f + 80.0f * std::sin(angle);
+        float y = 100.7f - 80.0f * std::cos(angle);
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+/* count short segments down through one cell and as many up through a cell further right, their cover
+   adds up in one cell each beyond int16 */
+template <class Rasterizer>
+void AddStackedSegments(Rasterizer& ras, int32_t count)
+{
+    for (int32_t i = 0; i < count; i++) {
+        ras.MoveToByfloat(20.5f, 10.1f); // 20.5, 10.1: inside the cell (20, 10)
+        ras.LineToByfloat(20.5f, 10.9f); // 10.9: 0.8 pixels down
+    }
+    for (int32_t i = 0; i < count; i++) {
+        ras.MoveToByfloat(40.5f, 10.9f); // 40.5: inside the cell (40, 10)
+        ras.LineToByfloat(40.5f, 10.1f);
+    }
+}
+
+void DrawScanline(const GeometryScanline& sl, uint8_t image[IMAGE_SIZE][IMAGE_SIZE])
+{
+    GeometryScanline::ConstIterator span = sl.Begin();
+    for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+        for (int32_t k = 0; k < span->spanLength; k++) {
+            image[sl.GetYLevel()][span->x + k] = span->covers[k];
+        }
+    }
+}
+
+/* Hashes the scanlines of every style separately, hashes[style] */
+void HashStyles(RasterizerCompoundAntialias& ras, uint64_t* hashes, uint32_t styleNum)
+{
+    for (uint32_t i = 0; i < styleNum; i++) {
+        hashes[i] = 0;
+    }
+    if (!ras.RewindScanlines()) {
+        return;
+    }
+    GeometryScanline sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    uint32_t numStyles;
+    while ((numStyles = ras.SweepStyles()) > 0) {
+        int32_t lastStyle = -1;
+        for (uint32_t i = 0; i < numStyles; i++) {
+            int32_t style = ras.GetStyle(i);
+            EXPECT_GT(style, lastStyle);
+            lastStyle = style;
+            if (ras.SweepScanline(sl, i) && static_cast<uint32_t>(style) < styleNum) {
+                hashes[style] = HashScanline(hashes[style], sl);
+            }
+        }
+    }
+}
+} // namespace
+
+class RasterizerCompoundTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerCompound_001
+ * @tc.desc: Verify every style of overlapping shapes sweeps like the shape rasterized alone.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCompoundTest, RasterizerCompound_001, TestSize.Level0)
+{
+    RasterizerCompoundAntialias compound;
+    for (uint32_t i = 0; i < SHAPE_NUM; i++) {
+        compound.Styles(i, -1);
+        AddShape(compound, GetShape(i));
+    }
+    EXPECT_EQ(compound.GetMinStyle(), 0);
+    EXPECT_EQ(compound.GetMaxStyle(), static_cast<int32_t>(SHAPE_NUM - 1));
+    uint64_t hashes[SHAPE_NUM];
+    HashStyles(compound, hashes, SHAPE_NUM);
+    for (uint32_t i = 0; i < SHAPE_NUM; i++) {
+        RasterizerScanlineAntialias single;
+        AddShape(single, GetShape(i));
+        EXPECT_EQ(hashes[i], HashScanlines(single));
+    }
+}
+
+/**
+ * @tc.name: RasterizerCompound_002
+ * @tc.desc: Verify two triangles sharing one edge with a style on each side match two separate triangles
+ *           and leave no seam along the shared edge.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCompoundTest, RasterizerCompound_002, TestSize.Level0)
+{
+    const float px[] = {10.2f, 90.7f, 30.4f, 120.1f};
+    const float py[] = {10.5f, 30.3f, 100.8f, 110.6f};
+    RasterizerCompoundAntialias compound;
+    compound.AutoClose(false);
+    /*
+     * Triangle 0-1-2 has style 0 on its left, triangle 1-2-3 has style 1 on its right,
+     * the edge 1-2 between them is added once.
+     */
+    compound.Styles(0, -1);
+    compound.MoveToByfloat(px[2], py[2]);
+    compound.LineToByfloat(px[0], py[0]);
+    compound.LineToByfloat(px[1], py[1]);
+    compound.Styles(0, 1);
+    compound.LineToByfloat(px[2], py[2]);
+    compound.Styles(-1, 1);
+    compound.LineToByfloat(px[3], py[3]);
+    compound.LineToByfloat(px[1], py[1]);
+    static uint8_t styled[2][IMAGE_SIZE][IMAGE_SIZE]; // 2: two styles
+    ASSERT_TRUE(compound.RewindScanlines());
+    GeometryScanline sl;
+    sl.Reset(compound.GetMinX(), compound.GetMaxX());
+    uint32_t numStyles;
+    while ((numStyles = compound.SweepStyles()) > 0) {
+        for (uint32_t i = 0; i < numStyles; i++) {
+            if (compound.SweepScanline(sl, i)) {
+                DrawScanline(sl, styled[compound.GetStyle(i)]);
+            }
+        }
+    }
+
+    static uint8_t single[2][IMAGE_SIZE][IMAGE_SIZE]; // 2: two triangles
+    for (uint32_t i = 0; i < 2; i++) { // 2: two triangles
+        RasterizerScanlineAntialias ras;
+        ras.MoveToByfloat(px[i], py[i]);
+        ras.LineToByfloat(px[i + 1], py[i + 1]);
+        ras.LineToByfloat(px[i + 2], py[i + 2]); // 2: third point
+        ASSERT_TRUE(ras.RewindScanlines());
+        sl.Reset(ras.GetMinX(), ras.GetMaxX());
+        while (ras.SweepScanline(sl)) {
+            DrawScanline(sl, single[i]);
+        }
+    }
+    uint32_t shared = 0;
+    for (int32_t y = 0; y < IMAGE_SIZE; y++) {
+        for (int32_t x = 0; x < IMAGE_SIZE; x++) {
+            /* The right side sees the negated area, its rounding may differ by one. */
+            EXPECT_LE(std::abs(styled[0][y][x] - single[0][y][x]), 1);
+            EXPECT_LE(std::abs(styled[1][y][x] - single[1][y][x]), 1);
+            /* Away from the vertices the pixels on the shared edge are covered once, up to rounding. */
+            if (styled[0][y][x] != 0 && styled[1][y][x] != 0 && y > py[1] + 1 && y < py[2] - 1) {
+                shared++;
+                EXPECT_GE(styled[0][y][x] + styled[1][y][x], OPA_OPAQUE - 1);
+                EXPECT_LE(styled[0][y][x] + styled[1][y][x], OPA_OPAQUE + 2); // 2: both sides rounded up
+            }
+        }
+    }
+    EXPECT_GT(shared, 0U);
+}
+
+/**
+ * @tc.name: RasterizerCompound_003
+ * @tc.desc: Verify the filling rule of each style is applied.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCompoundTest, RasterizerCompound_003, TestSize.Level0)
+{
+    RasterizerCompoundAntialias compound;
+    compound.SetStyleFillingRule(1, FILL_EVEN_ODD);
+    EXPECT_EQ(compound.GetStyleFillingRule(0), FILL_NON_ZERO);
+    EXPECT_EQ(compound.GetStyleFillingRule(1), FILL_EVEN_ODD);
+    compound.Styles(0, -1);
+    AddStar(compound);
+    compound.Styles(1, -1);
+    AddStar(compound);
+    uint64_t hashes[2];
+    HashStyles(compound, hashes, 2); // 2: two styles
+
+    const FillingRule rules[] = {FILL_NON_ZERO, FILL_EVEN_ODD};
+    for (uint32_t i = 0; i < 2; i++) { // 2: two styles
+        RasterizerScanlineAntialias single;
+        single.SetFillingRule(rules[i]);
+        AddStar(single);
+        EXPECT_EQ(hashes[i], HashScanlines(single));
+    }
+    EXPECT_NE(hashes[0], hashes[1]);
+}
+
+/**
+ * @tc.name: RasterizerCompound_004
+ * @tc.desc: Verify shapes added in descending style order sweep like the shapes rasterized alone.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCompoundTest, RasterizerCompound_004, TestSize.Level0)
+{
+    RasterizerCompoundAntialias compound;
+    for (uint32_t i = SHAPE_NUM; i > 0; i--) {
+        compound.Styles(i - 1, -1);
+        AddShape(compound, GetShape(i - 1));
+    }
+    uint64_t hashes[SHAPE_NUM];
+    HashStyles(compound, hashes, SHAPE_NUM);
+    for (uint32_t i = 0; i < SHAPE_NUM; i++) {
+        RasterizerScanlineAntialias single;
+        AddShape(single, GetShape(i));
+        EXPECT_EQ(hashes[i], HashScanlines(single));
+    }
+}
+
+/**
+ * @tc.name: RasterizerCompound_005
+ * @tc.desc: Verify a cell whose cover exceeds int16 sweeps like in RasterizerScanlineAntialias.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerCompoundTest, RasterizerCompound_005, TestSize.Level0)
+{
+    const int32_t segments = 200; // 200 * 0.8 * 256: a cover of about 41000
+    RasterizerCompoundAntialias compound;
+    compound.AutoClose(false);
+    compound.SetStyleFillingRule(0, FILL_EVEN_ODD);
+    compound.Styles(0, -1);
+    AddStackedSegments(compound, segments);
+    uint64_t hash;
+    HashStyles(compound, &hash, 1);
+
+    RasterizerScanlineAntialias single;
+    single.AutoClose(false);
+    single.SetFillingRule(FILL_EVEN_ODD);
+    AddStackedSegments(single, segments);
+    EXPECT_NE(hash, 0U);
+    EXPECT_EQ(hash, HashScanlines(single));
+}
+#endif
+} // namespace OHOS
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+#include "rasterizer_test_utils.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t THREAD_NUMS[] = {0, 2, 3, 8};
+const int32_t BAND_HEIGHTS[] = {1, 7, 32};
+
+/* Every scanline as bytes: y, then x, length and covers of each span. */
+void AppendScanline(const GeometryScanline& sl, std::vector<int32_t>& bytes)
+{
+    bytes.push_back(sl.GetYLevel());
+    GeometryScanline::ConstIterator span = sl.Begin();
+    for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+        bytes.push_back(span->x);
+        bytes.push_back(span->spanLength);
+        for (int32_t k = 0; k < span->spanLength; k++) {
+            bytes.push_back(span->covers[k]);
+        }
+    }
+}
+
+struct RenderRecord {
+    std::mutex mutex;
+    std::vector<std::vector<int32_t>> scanlines;
+};
+
+void RecordScanline(const GeometryScanline& sl, void* param)
+{
+    RenderRecord* record = static_cast<RenderRecord*>(param);
+    std::vector<int32_t> bytes;
+    AppendScanline(sl, bytes);
+    std::lock_guard<std::mutex> lock(record->mutex);
+    record->scanlines.push_back(bytes);
+}
+
+struct NestedRecord {
+    std::mutex mutex;
+    std::vector<std::vector<int32_t>> expect;
+    uint32_t sweeps = 0;
+    uint32_t mismatches = 0;
+};
+
+/* Sweeps a second rasterizer in parallel from within the render callback, like a nested layer. */
+void RenderNested(const GeometryScanline& sl, void* param)
+{
+    const int32_t nestedRows = 64;
+    if (sl.GetYLevel() % nestedRows != 0) {
+        return;
+    }
+    NestedRecord* nested = static_cast<NestedRecord*>(param);
+    RasterizerScanlineAntialias ras;
+    AddTestStar(ras);
+    ras.SetSweepThreadNum(4); // 4: threads
+    ras.SetSweepOrdered(true);
+    RenderRecord record;
+    bool swept = ras.SweepScanlineParallel(RecordScanline, &record);
+    std::lock_guard<std::mutex> lock(nested->mutex);
+    nested->sweeps++;
+    nested->mismatches += (swept && record.scanlines == nested->expect) ? 0 : 1;
+}
+
+void SweepSerial(RasterizerScanlineAntialias& ras, std::vector<std::vector<int32_t>>& scanlines)
+{
+    scanlines.clear();
+    ASSERT_TRUE(ras.RewindScanlines());
+    GeometryScanline sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        std::vector<int32_t> bytes;
+        AppendScanline(sl, bytes);
+        scanlines.push_back(bytes);
+    }
+}
+} // namespace
+
+class RasterizerScanlineParallelTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: RasterizerScanlineParallelOrdered_001
+ * @tc.desc: Verify the ordered parallel sweep renders exactly the scanlines of the serial loop in the same order,
+ *           for several thread counts and band heights and with the pool reused between sweeps.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallelOrdered_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    ras.Reset();
+    AddTestStar(ras);
+    std::vector<std::vector<int32_t>> serial;
+    SweepSerial(ras, serial);
+    ASSERT_GT(serial.size(), 0u);
+
+    ras.SetSweepOrdered(true);
+    for (uint32_t threadNum : THREAD_NUMS) {
+        for (int32_t bandHeight : BAND_HEIGHTS) {
+            ras.Reset();
+            AddTestStar(ras);
+            ras.SetSweepThreadNum(threadNum);
+            ras.SetSweepBandHeight(bandHeight);
+            RenderRecord record;
+            EXPECT_TRUE(ras.SweepScanlineParallel(RecordScanline, &record));
+            EXPECT_TRUE(record.scanlines == serial) << "threads " << threadNum << " band " << bandHeight;
+        }
+    }
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallelUnordered_001
+ * @tc.desc: Verify the unordered parallel sweep renders every scanline of the serial loop once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallelUnordered_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    ras.Reset();
+    AddTestStar(ras);
+    std::vector<std::vector<int32_t>> serial;
+    SweepSerial(ras, serial);
+
+    ras.Reset();
+    AddTestStar(ras);
+    ras.SetSweepThreadNum(4); // 4: threads
+    ras.SetSweepBandHeight(5); // 5: rows per band
+    RenderRecord record;
+    EXPECT_TRUE(ras.SweepScanlineParallel(RecordScanline, &record));
+    std::sort(record.scanlines.begin(), record.scanlines.end());
+    std::sort(serial.begin(), serial.end());
+    EXPECT_TRUE(record.scanlines == serial);
+
+    ras.Reset();
+    EXPECT_FALSE(ras.SweepScanlineParallel(RecordScanline, &record));
+}
+
+/**
+ * @tc.name: RasterizerScanlineParallelNested_001
+ * @tc.desc: Verify a parallel sweep started from the render callback of another one completes
+ *           and renders the scanlines of the serial loop.
+ * @tc.type: FUNC
+ */
+HWTEST_F(RasterizerScanlineParallelTest, RasterizerScanlineParallelNested_001, TestSize.Level0)
+{
+    NestedRecord nested;
+    RasterizerScanlineAntialias ras;
+    AddTestStar(ras);
+    SweepSerial(ras, nested.expect);
+
+    ras.Reset();
+    AddTestStar(ras);
+    ras.SetSweepThreadNum(4); // 4: threads
+    ras.SetSweepBandHeight(8); // 8: rows per band
+    EXPECT_TRUE(ras.SweepScanlineParallel(RenderNested, &nested));
+    EXPECT_GT(nested.sweeps, 0u);
+    EXPECT_EQ(nested.mismatches, 0u);
+}
+} // namespace OHOS
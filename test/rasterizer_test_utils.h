@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRAPHIC_LITE_RASTERIZER_TEST_UTILS_H
+#define GRAPHIC_LITE_RASTERIZER_TEST_UTILS_H
+
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+#include <cmath>
+
+namespace OHOS {
+const int32_t TEST_STAR_POINTS = 1300;
+const float TEST_STAR_CENTER = 500.0f;
+const float TEST_STAR_INNER = 50.0f;
+const float TEST_STAR_OUTER = 400.0f;
+const float TEST_STAR_TURNS = 37.0f;
+const float TEST_STAR_PETALS = 3.3f;
+const int32_t TEST_STAR_X_TURNS = 3;
+const uint64_t TEST_HASH_PRIME = 131;
+
+/**
+ * A star of many long self-crossing edges: it spans several cell blocks and has long rows to sort.
+ * x goes round xTurns times while y goes round once, different xTurns give different shapes.
+ */
+inline void AddTestStar(RasterizerScanlineAntialias& ras, int32_t xTurns = TEST_STAR_X_TURNS)
+{
+    for (int32_t i = 0; i < TEST_STAR_POINTS; i++) {
+        float angle = i * 2 * UI_PI * TEST_STAR_TURNS / TEST_STAR_POINTS; // 2: full turn
+        float radius = TEST_STAR_INNER + TEST_STAR_OUTER * std::fabs(std::sin(angle * TEST_STAR_PETALS));
+        float x = TEST_STAR_CENTER + radius * std::cos(angle * xTurns);
+        float y = TEST_STAR_CENTER + radius * std::sin(angle);
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+/** Folds the y, the spans and their covers of one scanline into hash. */
+inline uint64_t HashScanline(uint64_t hash, const GeometryScanline& sl)
+{
+    GeometryScanline::ConstIterator span = sl.Begin();
+    for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+        hash = hash * TEST_HASH_PRIME + span->x;
+        hash = hash * TEST_HASH_PRIME + span->spanLength;
+        for (int32_t k = 0; k < span->spanLength; k++) {
+            hash = hash * TEST_HASH_PRIME + span->covers[k];
+        }
+    }
+    return hash * TEST_HASH_PRIME + sl.GetYLevel();
+}
+
+/** Sweeps all scanlines of ras into one hash, 0 when there are none. */
+inline uint64_t HashScanlines(RasterizerScanlineAntialias& ras)
+{
+    uint64_t hash = 0;
+    if (!ras.RewindScanlines()) {
+        return hash;
+    }
+    GeometryScanline sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        hash = HashScanline(hash, sl);
+    }
+    return hash;
+}
+} // namespace OHOS
+#endif // GRAPHIC_LITE_RASTERIZER_TEST_UTILS_H
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/geometry_scanline.h"
+#include "gfx_utils/diagram/scanline/scanline_boolean.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 480;
+const int32_t IMAGE_HEIGHT = 320;
+const int32_t CIRCLE_POINTS = 64;
+const int32_t STAR_POINTS = 40;
+
+/* The clip container, a circle */
+void AddCircle(RasterizerScanlineAntialias& ras, float centerX, float centerY, float radius)
+{
+    for (int32_t i = 0; i < CIRCLE_POINTS; i++) {
+        float angle = i * 2 * UI_PI / CIRCLE_POINTS; // 2: full turn
+        float x = centerX + radius * std::cos(angle);
+        float y = centerY + radius * std::sin(angle);
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+/* The content, a star reaching out of the circle */
+void AddStar(RasterizerScanlineAntialias& ras)
+{
+    for (int32_t i = 0; i < STAR_POINTS; i++) {
+        float angle = i * 2 * UI_PI / STAR_POINTS;    // 2: full turn
+        float r = (i % 2 == 0) ? 150.0f : 90.0f;      // 2, 150, 90: star radii
+        float x = 260.3f + r * std::cos(angle);       // 260.3: center
+        float y = 150.6f + r * std::sin(angle);       // 150.6: center
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+template <class Rasterizer, class Scanline>
+void SweepCovers(Rasterizer& ras, Scanline& sl, uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH])
+{
+    for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+            covers[y][x] = 0;
+        }
+    }
+    if (!ras.RewindScanlines()) {
+        return;
+    }
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        int32_t y = sl.GetYLevel();
+        if (y < 0 || y >= IMAGE_HEIGHT) {
+            continue;
+        }
+        typename Scanline::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            int32_t len = (span->spanLength < 0) ? -span->spanLength : span->spanLength;
+            for (int32_t k = 0; k < len; k++) {
+                int32_t x = span->x + k;
+                if (x < 0 || x >= IMAGE_WIDTH) {
+                    continue;
+                }
+                EXPECT_EQ(covers[y][x], 0); // spans never overlap
+                covers[y][x] = (span->spanLength < 0) ? *span->covers : span->covers[k];
+            }
+        }
+    }
+}
+
+template <class Scanline1, class Scanline2, class Scanline>
+void CheckOperations(const uint8_t clip[IMAGE_HEIGHT][IMAGE_WIDTH], const uint8_t content[IMAGE_HEIGHT][IMAGE_WIDTH],
+                     float radius)
+{
+    const ScanlineBoolOperation ops[] = {
+        SCANLINE_BOOL_INTERSECT, SCANLINE_BOOL_UNION, SCANLINE_BOOL_XOR, SCANLINE_BOOL_SUBTRACT
+    };
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    for (ScanlineBoolOperation op : ops) {
+        RasterizerScanlineAntialias ras1;
+        RasterizerScanlineAntialias ras2;
+        AddCircle(ras1, 200.2f, 140.7f, radius); // 200.2, 140.7: off the star center
+        AddStar(ras2);
+        Scanline1 sl1;
+        Scanline2 sl2;
+        Scanline sl;
+        ScanlineBooleanSweeper<Scanline1, Scanline2> sweeper(ras1, ras2, sl1, sl2, op);
+        SweepCovers(sweeper, sl, covers);
+        for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+            for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+                ASSERT_EQ(covers[y][x], CombineCovers(op, clip[y][x], content[y][x])) << op << ":" << x << "," << y;
+            }
+        }
+    }
+}
+} // namespace
+
+class ScanlineBooleanTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: ScanlineBoolean_001
+ * @tc.desc: Verify every operation combines the covers of the two paths pixel by pixel, with dense and sparse
+ *           scanlines on both sides and in the result.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineBooleanTest, ScanlineBoolean_001, TestSize.Level0)
+{
+    static uint8_t clip[IMAGE_HEIGHT][IMAGE_WIDTH];
+    static uint8_t content[IMAGE_HEIGHT][IMAGE_WIDTH];
+    const float radius = 100.0f;
+    RasterizerScanlineAntialias ras;
+    GeometryScanline sl;
+    AddCircle(ras, 200.2f, 140.7f, radius); // 200.2, 140.7: off the star center
+    SweepCovers(ras, sl, clip);
+    ras.Reset();
+    AddStar(ras);
+    SweepCovers(ras, sl, content);
+
+    CheckOperations<GeometryScanline, GeometryScanline, GeometryScanline>(clip, content, radius);
+    CheckOperations<GeometryScanlineSparse, GeometryScanline, GeometryScanlineSparse>(clip, content, radius);
+    CheckOperations<GeometryScanlineSparse, GeometryScanlineSparse, GeometryScanline>(clip, content, radius);
+    CheckOperations<GeometryScanline, GeometryScanlineSparse, GeometryScanlineSparse>(clip, content, radius);
+
+    EXPECT_EQ(CombineCovers(SCANLINE_BOOL_INTERSECT, 255, 128), 128);
+    EXPECT_EQ(CombineCovers(SCANLINE_BOOL_UNION, 255, 128), 255);
+    EXPECT_EQ(CombineCovers(SCANLINE_BOOL_XOR, 255, 255), 0);
+    EXPECT_EQ(CombineCovers(SCANLINE_BOOL_SUBTRACT, 200, 0), 200);
+}
+
+/**
+ * @tc.name: ScanlineBoolean_002
+ * @tc.desc: Verify the operations with disjoint and empty operands.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineBooleanTest, ScanlineBoolean_002, TestSize.Level0)
+{
+    static uint8_t clip[IMAGE_HEIGHT][IMAGE_WIDTH];
+    static uint8_t content[IMAGE_HEIGHT][IMAGE_WIDTH];
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    RasterizerScanlineAntialias ras1;
+    RasterizerScanlineAntialias ras2;
+    GeometryScanline sl1;
+    GeometryScanline sl2;
+    GeometryScanline sl;
+    AddStar(ras2);
+    SweepCovers(ras2, sl, content);
+
+    /* A circle above the star shares no row with it */
+    AddCircle(ras1, 260.0f, -80.0f, 60.0f); // 260, -80, 60: above the image
+    ScanlineBooleanSweeper<GeometryScanline, GeometryScanline> intersect(ras1, ras2, sl1, sl2,
+                                                                          SCANLINE_BOOL_INTERSECT);
+    EXPECT_FALSE(intersect.RewindScanlines());
+    ScanlineBooleanSweeper<GeometryScanline, GeometryScanline> subtract(ras2, ras1, sl2, sl1, SCANLINE_BOOL_SUBTRACT);
+    SweepCovers(subtract, sl, covers);
+    EXPECT_EQ(memcmp(covers, content, sizeof(covers)), 0);
+
+    /* Nothing to clip with */
+    ras1.Reset();
+    SweepCovers(subtract, sl, covers);
+    EXPECT_EQ(memcmp(covers, content, sizeof(covers)), 0);
+    ScanlineBooleanSweeper<GeometryScanline, GeometryScanline> unite(ras1, ras2, sl1, sl2, SCANLINE_BOOL_UNION);
+    SweepCovers(unite, sl, covers);
+    EXPECT_EQ(memcmp(covers, content, sizeof(covers)), 0);
+    EXPECT_FALSE(intersect.RewindScanlines());
+    ScanlineBooleanSweeper<GeometryScanline, GeometryScanline> cut(ras1, ras2, sl1, sl2, SCANLINE_BOOL_SUBTRACT);
+    EXPECT_FALSE(cut.RewindScanlines());
+
+    /* The star is clipped by a circle holding it */
+    AddCircle(ras1, 260.0f, 150.0f, 200.0f); // 260, 150, 200: around the star
+    SweepCovers(ras1, sl, clip);
+    SweepCovers(intersect, sl, covers);
+    for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+            ASSERT_EQ(covers[y][x], CombineCovers(SCANLINE_BOOL_INTERSECT, clip[y][x], content[y][x]));
+        }
+    }
+}
+} // namespace OHOS
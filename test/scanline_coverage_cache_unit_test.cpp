@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_coverage_cache.h"
+#include "gfx_utils/diagram/scanline/scanline_render_solid.h"
+#include "gfx_utils/diagram/vertexprimitive/geometry_path_storage.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 256;
+const int32_t IMAGE_HEIGHT = 192;
+const int32_t IMAGE_STRIDE = IMAGE_WIDTH * 4;
+const int32_t ICON_POINTS = 24;
+
+/* A rippled disc, its points are multiples of 1/64 pixel so that integer translations stay exact. */
+void BuildIcon(UICanvasVertices& path, float radius)
+{
+    for (int32_t i = 0; i < ICON_POINTS; i++) {
+        float angle = i * 2 * UI_PI / ICON_POINTS;                      // 2: full turn
+        float r = radius * ((i % 2 == 0) ? 1.0f : 0.6f);                // 2, 0.6: rippled outline
+        float x = std::floor((20.0f + r * std::cos(angle)) * 64) / 64; // 20: center, 64: 1/64 pixel
+        float y = std::floor((20.0f + r * std::sin(angle)) * 64) / 64; // 20: center, 64: 1/64 pixel
+        if (i == 0) {
+            path.MoveTo(x, y);
+        } else {
+            path.LineTo(x, y);
+        }
+    }
+    path.ClosePolygon();
+}
+
+void RenderDirect(UICanvasVertices& path, TransAffine& transform, ScanlineSolidBlenderARGB8888& blender,
+                  const Rgba8T& color)
+{
+    RasterizerScanlineAntialias ras;
+    DepictTransform<UICanvasVertices> transformed(path, transform);
+    ras.AddPath(transformed);
+    GeometryScanline sl;
+    RenderScanlinesSolid(ras, sl, blender, color);
+}
+} // namespace
+
+class ScanlineCoverageCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: ScanlineCoverageCache_001
+ * @tc.desc: Verify replayed coverage at integer translations draws the same pixels as rasterizing again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineCoverageCacheTest, ScanlineCoverageCache_001, TestSize.Level0)
+{
+    static uint8_t cached[IMAGE_HEIGHT * IMAGE_STRIDE];
+    static uint8_t direct[IMAGE_HEIGHT * IMAGE_STRIDE];
+    ScanlineSolidBlenderARGB8888 cachedBlender(cached, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    ScanlineSolidBlenderARGB8888 directBlender(direct, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    UICanvasVertices path;
+    BuildIcon(path, 15.0f);
+    uint32_t pathHash = ScanlineCoverageCache::HashPath(path);
+    Rgba8T color(51, 102, 204, 180); // semi transparent, overlapping draws blend
+
+    ScanlineCoverageCache cache;
+    const float translations[][2] = {{3.25f, 5.5f}, {40.25f, 9.5f}, {-10.75f, 150.5f}, {230.25f, 100.5f},
+                                     {3.25f, 5.5f}, {20.0f, 20.0f}};
+    for (const float* translation : translations) {
+        TransAffine transform = TransAffine::TransAffineTranslation(translation[0], translation[1]);
+        RenderScanlinesSolidCached(cache, path, pathHash, transform, FILL_NON_ZERO, cachedBlender, color);
+        RenderDirect(path, transform, directBlender, color);
+    }
+    /* Two fractions: .25/.5 is recorded once and replayed four times, 0/0 is recorded once. */
+    EXPECT_EQ(cache.GetMissCount(), 2U);
+    EXPECT_EQ(cache.GetHitCount(), 4U);
+    EXPECT_EQ(cache.GetEntryCount(), 2U);
+    EXPECT_EQ(memcmp(cached, direct, sizeof(cached)), 0);
+    uint32_t drawn = 0;
+    for (uint32_t i = 0; i < sizeof(cached); i++) {
+        drawn += (cached[i] != 0) ? 1 : 0;
+    }
+    EXPECT_GT(drawn, 0U);
+}
+
+/**
+ * @tc.name: ScanlineCoverageCache_002
+ * @tc.desc: Verify the key covers the fraction, the linear part and the filling rule, and the LRU eviction.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineCoverageCacheTest, ScanlineCoverageCache_002, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildIcon(path, 15.0f);
+    uint32_t pathHash = ScanlineCoverageCache::HashPath(path);
+    UICanvasVertices other;
+    BuildIcon(other, 14.0f);
+    EXPECT_NE(ScanlineCoverageCache::HashPath(other), pathHash);
+
+    TransAffine local;
+    int32_t offsetX;
+    int32_t offsetY;
+    TransAffine transform = TransAffine::TransAffineTranslation(-3.75f, 7.25f);
+    CoverageCacheKey key = ScanlineCoverageCache::MakeKey(pathHash, transform, FILL_NON_ZERO, local, offsetX, offsetY);
+    EXPECT_EQ(offsetX, -4);
+    EXPECT_EQ(offsetY, 7);
+    EXPECT_FLOAT_EQ(local.GetData()[2], 0.25f); // 2: x translation
+    EXPECT_FLOAT_EQ(local.GetData()[5], 0.25f); // 5: y translation
+
+    ScanlineCoverageCache cache;
+    RasterizerScanlineAntialias ras;
+    DepictTransform<UICanvasVertices> transformed(path, local);
+    ras.AddPath(transformed);
+    cache.Record(key, ras);
+    uint32_t entryBytes = cache.GetMemoryUsage();
+    EXPECT_NE(cache.Find(key).data, nullptr);
+
+    TransAffine moved = TransAffine::TransAffineTranslation(96.25f, -0.75f);
+    TransAffine shifted = TransAffine::TransAffineTranslation(96.5f, -0.75f);
+    TransAffine scaled = TransAffine::TransAffineScaling(2.0f);
+    EXPECT_NE(cache.Find(ScanlineCoverageCache::MakeKey(pathHash, moved, FILL_NON_ZERO, local, offsetX, offsetY)).data,
+              nullptr);
+    EXPECT_EQ(cache.Find(ScanlineCoverageCache::MakeKey(pathHash, shifted, FILL_NON_ZERO, local, offsetX, offsetY))
+                  .data, nullptr);
+    EXPECT_EQ(cache.Find(ScanlineCoverageCache::MakeKey(pathHash, scaled, FILL_NON_ZERO, local, offsetX, offsetY))
+                  .data, nullptr);
+    EXPECT_EQ(cache.Find(ScanlineCoverageCache::MakeKey(pathHash, transform, FILL_EVEN_ODD, local, offsetX, offsetY))
+                  .data, nullptr);
+    EXPECT_EQ(cache.GetHitCount(), 2U);
+    EXPECT_EQ(cache.GetMissCount(), 3U);
+
+    /* Room for two entries: recording a third one evicts the least recently used. */
+    cache.SetMemoryLimit(entryBytes * 2 + entryBytes / 2); // 2: two entries and a half
+    CoverageCacheKey keys[3];                                 // 3: three fractions
+    for (uint32_t i = 0; i < 3; i++) {                        // 3: three fractions
+        TransAffine fraction = TransAffine::TransAffineTranslation(i * 0.25f, 0.0f);
+        keys[i] = ScanlineCoverageCache::MakeKey(pathHash, fraction, FILL_NON_ZERO, local, offsetX, offsetY);
+        DepictTransform<UICanvasVertices> fractionPath(path, local);
+        ras.Reset();
+        ras.AddPath(fractionPath);
+        cache.Record(keys[i], ras);
+        if (i == 1) {
+            cache.Find(keys[0]);
+        }
+    }
+    EXPECT_EQ(cache.GetEntryCount(), 2U);
+    EXPECT_LE(cache.GetMemoryUsage(), cache.GetMemoryLimit());
+    EXPECT_NE(cache.Find(keys[0]).data, nullptr);
+    EXPECT_EQ(cache.Find(keys[1]).data, nullptr);
+    EXPECT_NE(cache.Find(keys[2]).data, nullptr); // 2: the last recorded
+
+    cache.SetMemoryLimit(0);
+    EXPECT_EQ(cache.GetEntryCount(), 0U);
+    EXPECT_EQ(cache.GetMemoryUsage(), 0U);
+}
+
+/**
+ * @tc.name: ScanlineCoverageCacheClip_001
+ * @tc.desc: Verify the recorded coverage is not clipped and a rasterizer of the caller keeps its clip box.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineCoverageCacheTest, ScanlineCoverageCacheClip_001, TestSize.Level0)
+{
+    static uint8_t cached[IMAGE_HEIGHT * IMAGE_STRIDE];
+    static uint8_t direct[IMAGE_HEIGHT * IMAGE_STRIDE];
+    static uint8_t clipped[IMAGE_HEIGHT * IMAGE_STRIDE];
+    ScanlineSolidBlenderARGB8888 cachedBlender(cached, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    ScanlineSolidBlenderARGB8888 directBlender(direct, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    ScanlineSolidBlenderARGB8888 clippedBlender(clipped, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    UICanvasVertices square;
+    square.MoveTo(0.0f, 0.0f);
+    square.LineTo(20.0f, 0.0f);  // 20: square side
+    square.LineTo(20.0f, 20.0f); // 20: square side
+    square.LineTo(0.0f, 20.0f);  // 20: square side
+    square.ClosePolygon();
+    uint32_t pathHash = ScanlineCoverageCache::HashPath(square);
+    Rgba8T color(51, 102, 204, 255);
+    TransAffine transform = TransAffine::TransAffineTranslation(150.0f, 40.0f); // 150, 40: across the clip box
+
+    /* The caller's rasterizer holds a clipped path while the cache records a miss. */
+    RasterizerScanlineAntialias ras;
+    ras.ClipBox(155.0f, 0.0f, 200.0f, 100.0f); // 155, 200: clip box cutting the translated square
+    DepictTransform<UICanvasVertices> transformed(square, transform);
+    ras.AddPath(transformed);
+    ScanlineCoverageCache cache;
+    RenderScanlinesSolidCached(cache, square, pathHash, transform, FILL_NON_ZERO, cachedBlender, color);
+    RenderDirect(square, transform, directBlender, color);
+    EXPECT_EQ(cache.GetMissCount(), 1U);
+    EXPECT_EQ(memcmp(cached, direct, sizeof(cached)), 0);
+    GeometryScanline sl;
+    RenderScanlinesSolid(ras, sl, clippedBlender, color);
+
+    uint32_t drawn = 0;
+    uint32_t drawnClipped = 0;
+    for (uint32_t i = 3; i < sizeof(cached); i += 4) { // 3: alpha, 4: bytes per pixel
+        drawn += (cached[i] != 0) ? 1 : 0;
+        drawnClipped += (clipped[i] != 0) ? 1 : 0;
+    }
+    EXPECT_EQ(drawn, 400U);        // 400: 20 x 20 pixels
+    EXPECT_EQ(drawnClipped, 300U); // 300: 15 x 20 pixels right of the clip box edge
+}
+} // namespace OHOS
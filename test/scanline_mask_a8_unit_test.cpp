@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_mask_a8.h"
+#include "gfx_utils/diagram/scanline/scanline_render_solid.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 200;
+const int32_t IMAGE_HEIGHT = 160;
+const int32_t IMAGE_STRIDE = IMAGE_WIDTH * 4;
+const int32_t SHAPE_POINTS = 30;
+
+/* A rippled ring, points are multiples of 1/64 pixel so that integer offsets stay exact. */
+void AddShape(RasterizerScanlineAntialias& ras, float centerX, float centerY)
+{
+    const float radii[] = {50.0f, 25.0f};
+    for (float radius : radii) {
+        for (int32_t i = 0; i < SHAPE_POINTS; i++) {
+            float angle = i * 2 * UI_PI / SHAPE_POINTS;                      // 2: full turn
+            float r = radius * ((i % 2 == 0) ? 1.0f : 0.8f);                 // 2, 0.8: rippled outline
+            float x = std::floor((centerX + r * std::cos(angle)) * 64) / 64; // 64: 1/64 pixel
+            float y = std::floor((centerY + r * std::sin(angle)) * 64) / 64; // 64: 1/64 pixel
+            if (i == 0) {
+                ras.MoveToByfloat(x, y);
+            } else {
+                ras.LineToByfloat(x, y);
+            }
+        }
+    }
+    ras.SetFillingRule(FILL_EVEN_ODD);
+}
+
+void FillImage(uint8_t* image, uint8_t value)
+{
+    for (int32_t i = 0; i < IMAGE_HEIGHT * IMAGE_STRIDE; i++) {
+        image[i] = value + static_cast<uint8_t>(i * 7); // 7: a pattern under the blend
+    }
+}
+} // namespace
+
+class ScanlineMaskA8Test : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: ScanlineMaskA8_001
+ * @tc.desc: Verify the mask holds the covers of the swept scanlines, in an own and in an attached buffer.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineMaskA8Test, ScanlineMaskA8_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    AddShape(ras, 70.3f, 60.6f);
+    ScanlineMaskA8 mask;
+    ASSERT_TRUE(mask.Render(ras));
+    EXPECT_EQ(mask.GetOriginX(), ras.GetMinX());
+    EXPECT_EQ(mask.GetOriginY(), ras.GetMinY());
+    EXPECT_EQ(mask.GetWidth(), ras.GetMaxX() - ras.GetMinX() + 1);
+    EXPECT_EQ(mask.GetHeight(), ras.GetMaxY() - ras.GetMinY() + 1);
+    EXPECT_EQ(mask.GetStride() % 4, 0); // 4: rows are padded to 4 bytes
+
+    /* 40 x 30 window cutting the shape, rows of 48 bytes */
+    const int32_t windowX = 50;
+    const int32_t windowY = 20;
+    uint8_t window[30 * 48];
+    ScanlineMaskA8 clipped;
+    clipped.Attach(window, 40, 30, 48, windowX, windowY); // 40, 30, 48: width, height, stride
+    ASSERT_TRUE(clipped.Render(ras));
+
+    static uint8_t covers[IMAGE_HEIGHT][IMAGE_WIDTH];
+    GeometryScanline sl;
+    ASSERT_TRUE(ras.RewindScanlines());
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        GeometryScanline::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            for (int32_t k = 0; k < span->spanLength; k++) {
+                covers[sl.GetYLevel()][span->x + k] = span->covers[k];
+            }
+        }
+    }
+    uint32_t covered = 0;
+    for (int32_t y = 0; y < IMAGE_HEIGHT; y++) {
+        for (int32_t x = 0; x < IMAGE_WIDTH; x++) {
+            EXPECT_EQ(mask.GetCover(x, y), covers[y][x]);
+            bool inWindow = x >= windowX && x < windowX + 40 && y >= windowY && y < windowY + 30; // 40, 30: size
+            EXPECT_EQ(clipped.GetCover(x, y), inWindow ? covers[y][x] : 0);
+            covered += (covers[y][x] != 0) ? 1 : 0;
+        }
+    }
+    EXPECT_GT(covered, 0U);
+}
+
+/**
+ * @tc.name: ScanlineMaskA8_002
+ * @tc.desc: Verify blending through a moved mask matches rendering the moved path, for a color and a source.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineMaskA8Test, ScanlineMaskA8_002, TestSize.Level0)
+{
+    const int32_t offsetX = 57;
+    const int32_t offsetY = 33;
+    Rgba8T color(200, 60, 20, 190);
+    static uint8_t expect[IMAGE_HEIGHT * IMAGE_STRIDE];
+    FillImage(expect, 0);
+    RasterizerScanlineAntialias ras;
+    AddShape(ras, 70.3f + offsetX, 60.6f + offsetY);
+    ScanlineSolidBlenderARGB8888 blender(expect, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+    GeometryScanline sl;
+    RenderScanlinesSolid(ras, sl, blender, color);
+
+    ScanlineMaskA8 mask;
+    ras.Reset();
+    AddShape(ras, 70.3f, 60.6f);
+    ASSERT_TRUE(mask.Render(ras));
+    static uint8_t image[IMAGE_HEIGHT * IMAGE_STRIDE];
+    FillImage(image, 0);
+    mask.BlendSolid(image, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE, offsetX, offsetY, color);
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    /* A source layer of the color blends like the color */
+    static uint8_t source[IMAGE_HEIGHT * IMAGE_STRIDE];
+    Color32 pixel;
+    pixel.red = color.red;
+    pixel.green = color.green;
+    pixel.blue = color.blue;
+    pixel.alpha = color.alpha;
+    for (int32_t i = 0; i < IMAGE_WIDTH * IMAGE_HEIGHT; i++) {
+        reinterpret_cast<Color32*>(source)[i] = pixel;
+    }
+    FillImage(image, 0);
+    mask.BlendARGB8888(image, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE, source, IMAGE_STRIDE, offsetX, offsetY);
+    EXPECT_EQ(memcmp(image, expect, sizeof(image)), 0);
+
+    /* Moved partly out of the destination */
+    FillImage(image, 0);
+    mask.BlendSolid(image, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE, -60, 120, color); // -60, 120: off the corner
+    mask.BlendARGB8888(image, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE, source, IMAGE_STRIDE, 150, -90);
+}
+
+/**
+ * @tc.name: ScanlineMaskA8_003
+ * @tc.desc: Verify bounds too large for an own buffer are refused and leave the mask empty.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineMaskA8Test, ScanlineMaskA8_003, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    AddShape(ras, 70.3f, 60.6f);
+    ScanlineMaskA8 mask;
+    ASSERT_TRUE(mask.Render(ras));
+
+    /* 20000 x 20000 pixels, far above the largest own buffer */
+    ras.Reset();
+    ras.MoveToByfloat(0.0f, 0.0f);
+    ras.LineToByfloat(20000.0f, 0.0f);    // 20000: width
+    ras.LineToByfloat(20000.0f, 20000.0f); // 20000: width, height
+    EXPECT_FALSE(mask.Render(ras));
+    EXPECT_EQ(mask.GetBuffer(), nullptr);
+    EXPECT_EQ(mask.GetWidth(), 0);
+    EXPECT_EQ(mask.GetHeight(), 0);
+    EXPECT_EQ(mask.GetCover(10000, 5000), 0); // 10000, 5000: inside the triangle
+}
+} // namespace OHOS
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/scanline/scanline_render_solid.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const int32_t IMAGE_WIDTH = 640;
+const int32_t IMAGE_HEIGHT = 400;
+const int32_t IMAGE_STRIDE = IMAGE_WIDTH * 4;
+const int32_t SHAPE_NUM = 4;
+const float STAR_CENTER_X = 300.0f;
+const float STAR_CENTER_Y = 200.0f;
+const float STAR_INNER = 20.0f;
+const float STAR_OUTER = 170.0f;
+const float STAR_TURNS = 37.0f;
+
+/* Stars with crossing edges, a large quad with long solid runs and a triangle reaching out of the clip box. */
+void AddShape(RasterizerScanlineAntialias& ras, int32_t shape)
+{
+    ras.Reset();
+    if (shape == 2) { // 2: large quad
+        ras.MoveToByfloat(10.3f, 10.7f);    // 10.3, 10.7: top left
+        ras.LineToByfloat(630.2f, 20.1f);   // 630.2, 20.1: top right
+        ras.LineToByfloat(620.5f, 390.5f);  // 620.5, 390.5: bottom right
+        ras.LineToByfloat(15.5f, 380.2f);   // 15.5, 380.2: bottom left
+        return;
+    }
+    if (shape == 3) { // 3: clipped triangle
+        ras.MoveToByfloat(-50.5f, -30.25f); // -50.5, -30.25: outside of the top left corner
+        ras.LineToByfloat(700.0f, 100.0f);  // 700, 100: outside of the right edge
+        ras.LineToByfloat(300.0f, 450.0f);  // 300, 450: below the bottom edge
+        return;
+    }
+    int32_t points = 300 + shape * 500; // 300, 500: edges of the stars
+    for (int32_t i = 0; i < points; i++) {
+        float angle = i * 2 * UI_PI * STAR_TURNS / points; // 2: full turn
+        float radius = STAR_INNER + STAR_OUTER * std::fabs(std::sin(angle * 3.3f)); // 3.3: petals
+        float x = STAR_CENTER_X + radius * std::cos(angle * (shape + 1));
+        float y = STAR_CENTER_Y + radius * std::sin(angle);
+        if (i == 0) {
+            ras.MoveToByfloat(x, y);
+        } else {
+            ras.LineToByfloat(x, y);
+        }
+    }
+}
+
+void FillBackground(std::vector<uint8_t>& image)
+{
+    for (size_t i = 0; i < image.size(); i++) {
+        image[i] = static_cast<uint8_t>(i * 37); // 37: a pattern that is not flat
+    }
+}
+
+/* Coverage of every pixel, solid runs of the sparse scanline are expanded and counted. */
+template <class Scanline>
+void CollectCoverage(RasterizerScanlineAntialias& ras, Scanline& sl, std::vector<uint8_t>& coverage,
+                     uint32_t& solidRuns)
+{
+    coverage.assign(IMAGE_WIDTH * IMAGE_HEIGHT, 0);
+    solidRuns = 0;
+    ASSERT_TRUE(ras.RewindScanlines());
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    while (ras.SweepScanline(sl)) {
+        int32_t y = sl.GetYLevel();
+        typename Scanline::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            int32_t len = (span->spanLength < 0) ? -span->spanLength : span->spanLength;
+            solidRuns += (span->spanLength < 0) ? 1 : 0;
+            for (int32_t k = 0; k < len; k++) {
+                coverage[y * IMAGE_WIDTH + span->x + k] = span->covers[(span->spanLength < 0) ? 0 : k];
+            }
+        }
+    }
+}
+} // namespace
+
+class ScanlineRenderSolidTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {}
+    static void TearDownTestCase(void) {}
+};
+
+/**
+ * @tc.name: GeometryScanlineSparse_001
+ * @tc.desc: Verify the sparse scanline reports the same coverage as the dense one, with solid runs.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineRenderSolidTest, GeometryScanlineSparse_001, TestSize.Level0)
+{
+    RasterizerScanlineAntialias ras;
+    ras.ClipBox(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+    for (int32_t shape = 0; shape < SHAPE_NUM; shape++) {
+        GeometryScanline dense;
+        GeometryScanlineSparse sparse;
+        std::vector<uint8_t> denseCoverage;
+        std::vector<uint8_t> sparseCoverage;
+        uint32_t denseRuns = 0;
+        uint32_t sparseRuns = 0;
+        AddShape(ras, shape);
+        CollectCoverage(ras, dense, denseCoverage, denseRuns);
+        AddShape(ras, shape);
+        CollectCoverage(ras, sparse, sparseCoverage, sparseRuns);
+        EXPECT_TRUE(denseCoverage == sparseCoverage) << "shape " << shape;
+        EXPECT_EQ(denseRuns, 0u);
+        EXPECT_GT(sparseRuns, 0u) << "shape " << shape;
+    }
+}
+
+/**
+ * @tc.name: RenderScanlinesSolidSparse_001
+ * @tc.desc: Verify rendering through the sparse scanline blends the same pixels as the dense one,
+ *           for opaque and translucent colors.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineRenderSolidTest, RenderScanlinesSolidSparse_001, TestSize.Level0)
+{
+    std::vector<uint8_t> denseImage(IMAGE_HEIGHT * IMAGE_STRIDE);
+    std::vector<uint8_t> sparseImage(IMAGE_HEIGHT * IMAGE_STRIDE);
+    const Rgba8T colors[] = {Rgba8T(200, 30, 60, 255), Rgba8T(20, 130, 250, 128)}; // 255: opaque, 128: half
+    RasterizerScanlineAntialias ras;
+    ras.ClipBox(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+    for (int32_t shape = 0; shape < SHAPE_NUM; shape++) {
+        for (const Rgba8T& color : colors) {
+            FillBackground(denseImage);
+            FillBackground(sparseImage);
+            ScanlineSolidBlenderARGB8888 denseBlender(denseImage.data(), IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+            ScanlineSolidBlenderARGB8888 sparseBlender(sparseImage.data(), IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_STRIDE);
+            GeometryScanline dense;
+            GeometryScanlineSparse sparse;
+            AddShape(ras, shape);
+            RenderScanlinesSolid(ras, dense, denseBlender, color);
+            AddShape(ras, shape);
+            RenderScanlinesSolid(ras, sparse, sparseBlender, color);
+            EXPECT_TRUE(denseImage == sparseImage) << "shape " << shape << " alpha " << int32_t(color.alpha);
+        }
+    }
+}
+
+/**
+ * @tc.name: GeometryScanlineSparse_002
+ * @tc.desc: Verify a pixel aligned solid row wider than INT16_MAX pixels is split into solid runs
+ *           instead of wrapping into a per pixel span.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScanlineRenderSolidTest, GeometryScanlineSparse_002, TestSize.Level0)
+{
+    const int32_t left = -20000;
+    const int32_t right = 20000;
+    RasterizerScanlineAntialias ras;
+    ras.MoveToByfloat(left, 0.0f);
+    ras.LineToByfloat(right, 0.0f);
+    ras.LineToByfloat(right, 2.0f); // 2: two rows
+    ras.LineToByfloat(left, 2.0f);  // 2: two rows
+    ASSERT_TRUE(ras.RewindScanlines());
+    GeometryScanlineSparse sl;
+    sl.Reset(ras.GetMinX(), ras.GetMaxX());
+    uint32_t rows = 0;
+    while (ras.SweepScanline(sl)) {
+        int32_t x = left;
+        GeometryScanlineSparse::ConstIterator span = sl.Begin();
+        for (uint32_t i = 0; i < sl.NumSpans(); i++, span++) {
+            ASSERT_EQ(span->x, x);
+            if (span->spanLength > 0) {
+                for (int32_t k = 0; k < span->spanLength; k++) {
+                    EXPECT_EQ(span->covers[k], 255); // 255: opaque
+                }
+                x += span->spanLength;
+            } else {
+                EXPECT_EQ(*span->covers, 255); // 255: opaque
+                x -= span->spanLength;
+            }
+        }
+        EXPECT_EQ(x, right);
+        EXPECT_LE(sl.NumSpans(), 4U); // 4: an edge cell, two solid runs and at most one more cell
+        rows++;
+    }
+    EXPECT_EQ(rows, 2U); // 2: two rows
+}
+} // namespace OHOS
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/trans_affine.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+/* Not a multiple of the SIMD width, so the scalar tail runs too. */
+const uint32_t POINT_NUM = 4099;
+const float RELATIVE_EPSILON = 1e-5f;
+
+void FillPoints(float* x, float* y, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        x[i] = static_cast<float>(i % 97) * 3.25f - 100.0f; // 97: columns, 3.25: spacing, 100: origin
+        y[i] = static_cast<float>(i / 97) * 2.5f - 50.0f;   // 97: columns, 2.5: spacing, 50: origin
+    }
+}
+
+/* The batch result equals Transform, and InverseTransform within float rounding, on every point. */
+void ExpectBatchMatchesScalar(const TransAffine& transform)
+{
+    static float x[POINT_NUM];
+    static float y[POINT_NUM];
+    FillPoints(x, y, POINT_NUM);
+    transform.TransformBatch(x, y, POINT_NUM);
+    static float ix[POINT_NUM];
+    static float iy[POINT_NUM];
+    FillPoints(ix, iy, POINT_NUM);
+    transform.InverseTransformBatch(ix, iy, POINT_NUM);
+    static float sx[POINT_NUM];
+    static float sy[POINT_NUM];
+    FillPoints(sx, sy, POINT_NUM);
+    for (uint32_t i = 0; i < POINT_NUM; i++) {
+        float px = sx[i];
+        float py = sy[i];
+        transform.Transform(&px, &py);
+        EXPECT_FLOAT_EQ(x[i], px) << "point " << i;
+        EXPECT_FLOAT_EQ(y[i], py) << "point " << i;
+        px = sx[i];
+        py = sy[i];
+        transform.InverseTransform(&px, &py);
+        EXPECT_NEAR(ix[i], px, RELATIVE_EPSILON * (MATH_ABS(px) + 1.0f)) << "point " << i;
+        EXPECT_NEAR(iy[i], py, RELATIVE_EPSILON * (MATH_ABS(py) + 1.0f)) << "point " << i;
+    }
+}
+} // namespace
+
+class TransAffineTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: TransAffineType_001
+ * @tc.desc: The cached type follows Translate, Scale, Rotate, Multiply, Invert, SetData and Reset.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TransAffineTest, TransAffineType_001, TestSize.Level0)
+{
+    TransAffine transform;
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_IDENTITY);
+    transform.Translate(10.0f, -5.0f); // 10, -5: translation
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_TRANSLATE);
+    transform.Scale(2.0f, 0.5f); // 2, 0.5: scale
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_SCALE);
+    transform.Translate(1.0f, 1.0f);
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_SCALE);
+    transform.Rotate(0.0f);
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_SCALE);
+    transform.Rotate(0.5f); // 0.5: rotation in radians
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_GENERAL);
+    TransAffine inverse = transform;
+    inverse.Invert();
+    EXPECT_EQ(inverse.GetType(), TRANS_AFFINE_GENERAL);
+    transform.Reset();
+    EXPECT_EQ(transform.GetType(), TRANS_AFFINE_IDENTITY);
+
+    TransAffine scale = TransAffine::TransAffineScaling(4.0f); // 4: scale
+    EXPECT_EQ(scale.GetType(), TRANS_AFFINE_SCALE);
+    scale.Invert();
+    EXPECT_EQ(scale.GetType(), TRANS_AFFINE_SCALE);
+    scale.Multiply(TransAffine::TransAffineScaling(4.0f)); // 4: undo the inverted scale
+    EXPECT_EQ(scale.GetType(), TRANS_AFFINE_IDENTITY);
+    scale.SetData(2, 3.0f); // 2: x translation, 3: offset
+    EXPECT_EQ(scale.GetType(), TRANS_AFFINE_TRANSLATE);
+    scale.SetData(1, 0.25f); // 1: x shear, 0.25: shear
+    EXPECT_EQ(scale.GetType(), TRANS_AFFINE_GENERAL);
+    EXPECT_EQ(TransAffine(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f).GetType(), TRANS_AFFINE_IDENTITY);
+    EXPECT_EQ(TransAffine::TransAffineTranslation(1.0f, 2.0f).GetType(), TRANS_AFFINE_TRANSLATE);
+}
+
+/**
+ * @tc.name: TransAffineBatch_001
+ * @tc.desc: TransformBatch and InverseTransformBatch give the per point results for every type.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TransAffineTest, TransAffineBatch_001, TestSize.Level0)
+{
+    TransAffine transform;
+    ExpectBatchMatchesScalar(transform);
+    transform.Translate(12.5f, -7.25f); // 12.5, -7.25: translation
+    ExpectBatchMatchesScalar(transform);
+    transform.Scale(1.5f, 0.75f); // 1.5, 0.75: scale
+    ExpectBatchMatchesScalar(transform);
+    transform.Rotate(0.3f); // 0.3: rotation in radians
+    ExpectBatchMatchesScalar(transform);
+    float x = 1.0f;
+    float y = 2.0f;
+    transform.TransformBatch(&x, &y, 0);
+    EXPECT_EQ(x, 1.0f);
+    EXPECT_EQ(y, 2.0f);
+}
+} // namespace OHOS
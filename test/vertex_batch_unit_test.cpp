@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gfx_utils/diagram/depiction/depict_curve.h"
+#include "gfx_utils/diagram/depiction/depict_stroke.h"
+#include "gfx_utils/diagram/depiction/depict_transform.h"
+#include "gfx_utils/diagram/rasterizer/rasterizer_scanline_antialias.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace testing::ext;
+namespace OHOS {
+namespace {
+const uint32_t MAX_VERTICES = 4096;
+const uint32_t BATCH_SIZES[] = {1, 7, VERTEX_BATCH_SIZE};
+
+/* A polygon, a curved shape and an open polyline, so every adaptor sees several subpaths. */
+void BuildPath(UICanvasVertices& path, float offset)
+{
+    path.MoveTo(10.0f + offset, 10.0f);
+    path.LineTo(90.0f + offset, 15.0f);
+    path.LineTo(60.0f + offset, 80.0f);
+    path.EndPoly();
+    path.MoveTo(100.0f + offset, 20.0f);
+    path.CubicBezierCurve(180.0f + offset, 5.0f, 200.0f + offset, 90.0f, 140.0f + offset, 70.0f);
+    path.LineTo(110.0f + offset, 60.0f);
+    path.LineTo(100.0f + offset, 30.0f);
+    path.EndPoly();
+    path.MoveTo(20.0f + offset, 120.0f);
+    path.LineTo(80.0f + offset, 150.0f);
+    path.LineTo(140.0f + offset, 110.0f);
+}
+
+/* Reads the whole path one vertex at a time, the stop command is not stored. */
+template <class VertexSource>
+uint32_t ReadByVertex(VertexSource& vs, PathVertex* vertices)
+{
+    uint32_t num = 0;
+    vs.Rewind(0);
+    float x;
+    float y;
+    uint32_t cmd;
+    while (!IsStop(cmd = vs.GenerateVertex(&x, &y)) && num < MAX_VERTICES) {
+        vertices[num].x = x;
+        vertices[num].y = y;
+        vertices[num].cmd = cmd;
+        num++;
+    }
+    return num;
+}
+
+/* Reads the whole path in blocks of batchSize vertices. */
+template <class VertexSource>
+uint32_t ReadByBlock(VertexSource& vs, PathVertex* vertices, uint32_t batchSize)
+{
+    uint32_t num = 0;
+    uint32_t got;
+    vs.Rewind(0);
+    do {
+        got = vs.GenerateVertices(vertices + num, MATH_MIN(batchSize, MAX_VERTICES - num));
+        num += got;
+    } while (got == batchSize && num < MAX_VERTICES);
+    return num;
+}
+
+/* A vertex source written against the vertex interface only, as sources outside of this repo may be. */
+class VertexOnlySource {
+public:
+    explicit VertexOnlySource(UICanvasVertices& path) : path_(path) {}
+
+    void Rewind(uint32_t pathId)
+    {
+        path_.Rewind(pathId);
+    }
+
+    uint32_t GenerateVertex(float* x, float* y)
+    {
+        return path_.GenerateVertex(x, y);
+    }
+
+private:
+    UICanvasVertices& path_;
+};
+
+template <class VertexSource>
+void ExpectSameSequence(VertexSource& vs)
+{
+    static PathVertex expected[MAX_VERTICES];
+    static PathVertex actual[MAX_VERTICES];
+    uint32_t expectedNum = ReadByVertex(vs, expected);
+    ASSERT_GT(expectedNum, 0u);
+    ASSERT_LT(expectedNum, MAX_VERTICES);
+    for (uint32_t batchSize : BATCH_SIZES) {
+        uint32_t num = ReadByBlock(vs, actual, batchSize);
+        ASSERT_EQ(num, expectedNum) << "batch " << batchSize;
+        for (uint32_t i = 0; i < num; i++) {
+            EXPECT_EQ(actual[i].cmd, expected[i].cmd) << "batch " << batchSize << " vertex " << i;
+            /* Commands such as the end of a polygon leave the coordinates unwritten. */
+            if (!IsVertex(expected[i].cmd)) {
+                continue;
+            }
+            EXPECT_FLOAT_EQ(actual[i].x, expected[i].x) << "batch " << batchSize << " vertex " << i;
+            EXPECT_FLOAT_EQ(actual[i].y, expected[i].y) << "batch " << batchSize << " vertex " << i;
+        }
+    }
+}
+} // namespace
+
+class VertexBatchTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/**
+ * @tc.name: VertexBatchSourceSequence_001
+ * @tc.desc: GenerateVertices of the path storage, the curve and the transform returns the same vertices
+ *           as GenerateVertex for every block size.
+ * @tc.type: FUNC
+ */
+HWTEST_F(VertexBatchTest, VertexBatchSourceSequence_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildPath(path, 0.0f);
+    ExpectSameSequence(path);
+
+    DepictCurve curve(path);
+    ExpectSameSequence(curve);
+
+    TransAffine transform;
+    transform.Rotate(0.3f); // 0.3: rotation in radians
+    transform.Scale(1.5f, 0.75f); // 1.5, 0.75: scale
+    transform.Translate(12.5f, -3.25f); // 12.5, -3.25: translation
+    DepictTransform<DepictCurve> transformed(curve, transform);
+    ExpectSameSequence(transformed);
+}
+
+/**
+ * @tc.name: VertexBatchVertexOnlySource_001
+ * @tc.desc: Sources without GenerateVertices are read through GenerateVertex by the adaptors and AddPath.
+ * @tc.type: FUNC
+ */
+HWTEST_F(VertexBatchTest, VertexBatchVertexOnlySource_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildPath(path, 0.0f);
+    VertexOnlySource source(path);
+    TransAffine transform;
+    transform.Translate(12.5f, -3.25f); // 12.5, -3.25: translation
+    DepictTransform<VertexOnlySource> transformed(source, transform);
+    ExpectSameSequence(transformed);
+
+    RasterizerScanlineAntialias expected;
+    expected.AddPath(path);
+    RasterizerScanlineAntialias actual;
+    actual.AddPath(source);
+    ASSERT_TRUE(expected.RewindScanlines());
+    ASSERT_TRUE(actual.RewindScanlines());
+    EXPECT_EQ(actual.GetMinX(), expected.GetMinX());
+    EXPECT_EQ(actual.GetMinY(), expected.GetMinY());
+    EXPECT_EQ(actual.GetMaxX(), expected.GetMaxX());
+    EXPECT_EQ(actual.GetMaxY(), expected.GetMaxY());
+}
+
+/**
+ * @tc.name: VertexBatchStrokeSequence_001
+ * @tc.desc: The stroke adaptor hands out the same outline in blocks as one vertex at a time,
+ *           including the switch between the subpaths.
+ * @tc.type: FUNC
+ */
+HWTEST_F(VertexBatchTest, VertexBatchStrokeSequence_001, TestSize.Level0)
+{
+    UICanvasVertices path;
+    BuildPath(path, 0.0f);
+    DepictCurve curve(path);
+    DepictStroke<DepictCurve> stroke(curve);
+    stroke.SetWidth(6.0f); // 6.0: stroke width
+    ExpectSameSequence(stroke);
+}
+} // namespace OHOS